@@ -26,6 +26,7 @@ std::unique_ptr<SoundStream> g_sound_stream;
 namespace AudioCommon
 {
 static bool s_audio_dump_start = false;
+static bool s_mixer_stats_log_start = false;
 static bool s_sound_stream_running = false;
 
 constexpr int AUDIO_VOLUME_MIN = 0;
@@ -88,6 +89,8 @@ void ShutdownSoundStream()
 
   if (Config::Get(Config::MAIN_DUMP_AUDIO) && s_audio_dump_start)
     StopAudioDump();
+  if (s_mixer_stats_log_start)
+    StopMixerStatsLog();
 
   SetSoundStreamRunning(false);
   g_sound_stream.reset();
@@ -196,6 +199,11 @@ void SendAIBuffer(const short* samples, unsigned int num_samples)
   else if (!Config::Get(Config::MAIN_DUMP_AUDIO) && s_audio_dump_start)
     StopAudioDump();
 
+  if (Config::Get(Config::MAIN_LOG_MIXER_STATS) && !s_mixer_stats_log_start)
+    StartMixerStatsLog();
+  else if (!Config::Get(Config::MAIN_LOG_MIXER_STATS) && s_mixer_stats_log_start)
+    StopMixerStatsLog();
+
   Mixer* pMixer = g_sound_stream->GetMixer();
 
   if (pMixer && samples)
@@ -231,6 +239,27 @@ void StopAudioDump()
   s_audio_dump_start = false;
 }
 
+void StartMixerStatsLog()
+{
+  std::time_t start_time = std::time(nullptr);
+
+  std::string path_prefix = File::GetUserPath(D_DUMPAUDIO_IDX) + SConfig::GetInstance().GetGameID();
+
+  const std::string file_name = fmt::format("{}_{:%Y-%m-%d_%H-%M-%S}_mixerstats.csv", path_prefix,
+                                            fmt::localtime(start_time));
+  File::CreateFullPath(file_name);
+  g_sound_stream->GetMixer()->StartLogStats(file_name);
+  s_mixer_stats_log_start = true;
+}
+
+void StopMixerStatsLog()
+{
+  if (!g_sound_stream)
+    return;
+  g_sound_stream->GetMixer()->StopLogStats();
+  s_mixer_stats_log_start = false;
+}
+
 void IncreaseVolume(unsigned short offset)
 {
   Config::SetBaseOrCurrent(Config::MAIN_AUDIO_MUTED, false);
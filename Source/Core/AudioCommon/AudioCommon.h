@@ -31,6 +31,8 @@ void SetSoundStreamRunning(bool running);
 void SendAIBuffer(const short* samples, unsigned int num_samples);
 void StartAudioDump();
 void StopAudioDump();
+void StartMixerStatsLog();
+void StopMixerStatsLog();
 void IncreaseVolume(unsigned short offset);
 void DecreaseVolume(unsigned short offset);
 void ToggleMuteVolume();
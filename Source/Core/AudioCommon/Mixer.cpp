@@ -6,12 +6,17 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <string_view>
+
+#include <fmt/format.h>
 
 #include "AudioCommon/Enums.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Common/Timer.h"
+#include "Common/Trace.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 
@@ -55,6 +60,23 @@ void Mixer::DoState(PointerWrap& p)
     mixer.DoState(p);
 }
 
+float Mixer::MixerFifo::GetDriftCompensatedRate(u32 buffered_samples, int timing_variance)
+{
+  u32 low_waterwark = m_input_sample_rate * timing_variance / 1000;
+  low_waterwark = std::min(low_waterwark, MAX_SAMPLES / 2);
+  const double target =
+      std::max(low_waterwark, m_input_sample_rate * MIN_DRIFT_TARGET_MS / 1000) + 1.0;
+
+  m_drift_fill += (buffered_samples - m_drift_fill) * DRIFT_FILL_SMOOTHING;
+  const double error = (m_drift_fill - target) / target;
+
+  m_drift_integral = std::clamp(m_drift_integral + error * DRIFT_KI, -MAX_DRIFT, MAX_DRIFT);
+  const double correction = std::clamp(error * DRIFT_KP + m_drift_integral, -MAX_DRIFT, MAX_DRIFT);
+  m_drift_ppm.store(static_cast<s32>(correction * 1000000));
+
+  return static_cast<float>(m_input_sample_rate * (1.0 + correction));
+}
+
 // Executed from sound stream thread
 unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
                                    bool consider_framelimit, float emulationspeed,
@@ -72,12 +94,19 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   u32 indexR = m_indexR.load();
   u32 indexW = m_indexW.load();
 
+  const bool drift_compensation = m_mixer->m_config_drift_compensation;
+
   // render numleft sample pairs to samples[]
   // advance indexR with sample position
   // remember fractional offset
 
   float aid_sample_rate = static_cast<float>(m_input_sample_rate);
-  if (consider_framelimit && emulationspeed > 0.0f)
+  if (consider_framelimit && emulationspeed > 0.0f && drift_compensation)
+  {
+    const u32 buffered_samples = ((indexW - indexR) & INDEX_MASK) / 2;
+    aid_sample_rate = GetDriftCompensatedRate(buffered_samples, timing_variance) * emulationspeed;
+  }
+  else if (consider_framelimit && emulationspeed > 0.0f)
   {
     float numLeft = static_cast<float>(((indexW - indexR) & INDEX_MASK) / 2);
 
@@ -103,33 +132,76 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
     return m_little_endian ? m_buffer[index] : Common::swap16(m_buffer[index]);
   };
 
-  // TODO: consider a higher-quality resampling algorithm.
-  for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2)
+  if (drift_compensation)
+  {
+    // Cubic (Catmull-Rom) interpolation between the current and the next sample, which also
+    // needs the previous one and the one after next. The producer never overwrites the stereo
+    // sample right before indexR, see PushSamples.
+    for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 4;
+         currentSample += 2)
+    {
+      const float t = m_frac / 65536.0f;
+      const auto interpolate = [&](u32 channel) {
+        const float y0 = read_buffer((indexR - 2 + channel) & INDEX_MASK);
+        const float y1 = read_buffer((indexR + channel) & INDEX_MASK);
+        const float y2 = read_buffer((indexR + 2 + channel) & INDEX_MASK);
+        const float y3 = read_buffer((indexR + 4 + channel) & INDEX_MASK);
+        const float c1 = 0.5f * (y2 - y0);
+        const float c2 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
+        const float c3 = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
+        return static_cast<int>(((c3 * t + c2) * t + c1) * t + y1);
+      };
+
+      int sampleL = (interpolate(0) * lvolume) >> 8;
+      sampleL += samples[currentSample + 1];
+      samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
+
+      int sampleR = (interpolate(1) * rvolume) >> 8;
+      sampleR += samples[currentSample];
+      samples[currentSample] = std::clamp(sampleR, -32767, 32767);
+
+      m_frac += ratio;
+      indexR += 2 * (u16)(m_frac >> 16);
+      m_frac &= 0xffff;
+    }
+  }
+  else
   {
-    u32 indexR2 = indexR + 2;  // next sample
-
-    s16 l1 = read_buffer(indexR & INDEX_MASK);   // current
-    s16 l2 = read_buffer(indexR2 & INDEX_MASK);  // next
-    int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
-    sampleL = (sampleL * lvolume) >> 8;
-    sampleL += samples[currentSample + 1];
-    samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
-
-    s16 r1 = read_buffer((indexR + 1) & INDEX_MASK);   // current
-    s16 r2 = read_buffer((indexR2 + 1) & INDEX_MASK);  // next
-    int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
-    sampleR = (sampleR * rvolume) >> 8;
-    sampleR += samples[currentSample];
-    samples[currentSample] = std::clamp(sampleR, -32767, 32767);
-
-    m_frac += ratio;
-    indexR += 2 * (u16)(m_frac >> 16);
-    m_frac &= 0xffff;
+    // TODO: consider a higher-quality resampling algorithm.
+    for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2;
+         currentSample += 2)
+    {
+      u32 indexR2 = indexR + 2;  // next sample
+
+      s16 l1 = read_buffer(indexR & INDEX_MASK);   // current
+      s16 l2 = read_buffer(indexR2 & INDEX_MASK);  // next
+      int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
+      sampleL = (sampleL * lvolume) >> 8;
+      sampleL += samples[currentSample + 1];
+      samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
+
+      s16 r1 = read_buffer((indexR + 1) & INDEX_MASK);   // current
+      s16 r2 = read_buffer((indexR2 + 1) & INDEX_MASK);  // next
+      int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
+      sampleR = (sampleR * rvolume) >> 8;
+      sampleR += samples[currentSample];
+      samples[currentSample] = std::clamp(sampleR, -32767, 32767);
+
+      m_frac += ratio;
+      indexR += 2 * (u16)(m_frac >> 16);
+      m_frac &= 0xffff;
+    }
   }
 
   // Actual number of samples written to the buffer without padding.
   unsigned int actual_sample_count = currentSample / 2;
 
+  // Only count running dry once, not for every mix while the source stays silent.
+  const bool starved = actual_sample_count < numSamples;
+  if (starved && !m_starved)
+    m_underruns.fetch_add(1, std::memory_order_relaxed);
+  m_starved = starved;
+
   // Padding
   short s[2];
   s[0] = read_buffer((indexR - 1) & INDEX_MASK);
@@ -148,6 +220,8 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   // Flush cached variable
   m_indexR.store(indexR);
 
+  m_buffered_samples.store(((indexW - indexR) & INDEX_MASK) / 2, std::memory_order_relaxed);
+
   return actual_sample_count;
 }
 
@@ -156,6 +230,8 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   if (!samples)
     return 0;
 
+  TRACE_SCOPE("Mixer::Mix");
+
   memset(samples, 0, num_samples * 2 * sizeof(short));
 
   const float emulation_speed = m_config_emulation_speed;
@@ -233,8 +309,13 @@ void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_sample
 
   // Check if we have enough free space
   // indexW == m_indexR results in empty buffer, so indexR must always be smaller than indexW
+  // This also keeps the stereo sample right before indexR intact, which Mix reads when
+  // interpolating.
   if (num_samples * 2 + ((indexW - m_indexR.load()) & INDEX_MASK) >= MAX_SAMPLES * 2)
+  {
+    m_overruns.fetch_add(1, std::memory_order_relaxed);
     return;
+  }
 
   // AyuanX: Actual re-sampling work has been moved to sound thread
   // to alleviate the workload on main thread
@@ -263,6 +344,8 @@ void Mixer::PushSamples(const short* samples, unsigned int num_samples)
     m_wave_writer_dsp.AddStereoSamplesBE(samples, num_samples, sample_rate, volume.first,
                                          volume.second);
   }
+  if (m_stats_log.IsOpen())
+    LogStats();
 }
 
 void Mixer::PushStreamingSamples(const short* samples, unsigned int num_samples)
@@ -405,11 +488,82 @@ void Mixer::StopLogDSPAudio()
   }
 }
 
+void Mixer::StartLogStats(const std::string& filename)
+{
+  if (m_stats_log.IsOpen())
+  {
+    WARN_LOG_FMT(AUDIO, "Mixer stats logging has already been started");
+    return;
+  }
+
+  if (!m_stats_log.Open(filename, "w"))
+  {
+    NOTICE_LOG_FMT(AUDIO, "Unable to start mixer stats logging");
+    return;
+  }
+
+  m_stats_log.WriteString(
+      "time_s,source,input_rate,buffered_samples,latency_ms,underruns,overruns,drift_ppm\n");
+  m_stats_log_start_us = Common::Timer::GetTimeUs();
+  m_stats_log_last_us = m_stats_log_start_us;
+  NOTICE_LOG_FMT(AUDIO, "Starting mixer stats logging");
+}
+
+void Mixer::StopLogStats()
+{
+  if (!m_stats_log.IsOpen())
+  {
+    WARN_LOG_FMT(AUDIO, "Mixer stats logging has already been stopped");
+    return;
+  }
+
+  m_stats_log.Close();
+  NOTICE_LOG_FMT(AUDIO, "Stopping mixer stats logging");
+}
+
+// Called from the emulation thread, like the other logs, so that file IO never blocks the audio
+// callback.
+void Mixer::LogStats()
+{
+  const u64 now = Common::Timer::GetTimeUs();
+  if (now - m_stats_log_last_us < 1000000)
+    return;
+  m_stats_log_last_us = now;
+
+  const double time = (now - m_stats_log_start_us) / 1000000.0;
+  const Stats stats = GetStats();
+  std::string rows;
+  const auto add_row = [&](std::string_view source, const FifoStats& fifo) {
+    rows += fmt::format("{:.3f},{},{},{},{:.2f},{},{},{}\n", time, source,
+                        fifo.input_sample_rate, fifo.buffered_samples, fifo.latency_ms,
+                        fifo.underruns, fifo.overruns, fifo.drift_ppm);
+  };
+  add_row("dma", stats.dma);
+  add_row("streaming", stats.streaming);
+  add_row("wiimote_speaker", stats.wiimote_speaker);
+  for (size_t i = 0; i < stats.gba.size(); ++i)
+    add_row(fmt::format("gba{}", i + 1), stats.gba[i]);
+
+  m_stats_log.WriteString(rows);
+}
+
+Mixer::Stats Mixer::GetStats() const
+{
+  Stats stats;
+  stats.dma = m_dma_mixer.GetStats();
+  stats.streaming = m_streaming_mixer.GetStats();
+  stats.wiimote_speaker = m_wiimote_speaker_mixer.GetStats();
+  for (size_t i = 0; i < m_gba_mixers.size(); ++i)
+    stats.gba[i] = m_gba_mixers[i].GetStats();
+  return stats;
+}
+
 void Mixer::RefreshConfig()
 {
   m_config_emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
   m_config_timing_variance = Config::Get(Config::MAIN_TIMING_VARIANCE);
   m_config_audio_stretch = Config::Get(Config::MAIN_AUDIO_STRETCH);
+  m_config_drift_compensation = Config::Get(Config::MAIN_AUDIO_DRIFT_COMPENSATION);
 }
 
 void Mixer::MixerFifo::DoState(PointerWrap& p)
@@ -447,3 +601,16 @@ unsigned int Mixer::MixerFifo::AvailableSamples() const
     return 0;  // Mixer::MixerFifo::Mix always keeps one sample in the buffer.
   return (samples_in_fifo - 1) * m_mixer->m_sampleRate / m_input_sample_rate;
 }
+
+Mixer::FifoStats Mixer::MixerFifo::GetStats() const
+{
+  FifoStats stats;
+  stats.input_sample_rate = m_input_sample_rate;
+  stats.buffered_samples = m_buffered_samples.load(std::memory_order_relaxed);
+  if (m_input_sample_rate != 0)
+    stats.latency_ms = stats.buffered_samples * 1000.0f / m_input_sample_rate;
+  stats.underruns = m_underruns.load(std::memory_order_relaxed);
+  stats.overruns = m_overruns.load(std::memory_order_relaxed);
+  stats.drift_ppm = m_drift_ppm.load(std::memory_order_relaxed);
+  return stats;
+}
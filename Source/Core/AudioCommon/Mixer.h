@@ -5,17 +5,42 @@
 
 #include <array>
 #include <atomic>
+#include <string>
 
 #include "AudioCommon/AudioStretcher.h"
 #include "AudioCommon/SurroundDecoder.h"
 #include "AudioCommon/WaveFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
 
 class PointerWrap;
 
 class Mixer final
 {
 public:
+  // A snapshot of the state of one input FIFO, for the performance overlay and the stats log.
+  struct FifoStats
+  {
+    u32 input_sample_rate = 0;
+    // Stereo samples waiting to be mixed, and how long they take to play at the input rate.
+    u32 buffered_samples = 0;
+    float latency_ms = 0.0f;
+    // How many times the FIFO ran dry while mixing, and how many pushes were dropped because it
+    // was full.
+    u64 underruns = 0;
+    u64 overruns = 0;
+    // The resampling correction currently applied by drift compensation.
+    s32 drift_ppm = 0;
+  };
+
+  struct Stats
+  {
+    FifoStats dma;
+    FifoStats streaming;
+    FifoStats wiimote_speaker;
+    std::array<FifoStats, 4> gba;
+  };
+
   explicit Mixer(unsigned int BackendSampleRate);
   ~Mixer();
 
@@ -48,6 +73,13 @@ public:
   void StartLogDSPAudio(const std::string& filename);
   void StopLogDSPAudio();
 
+  // Writes the stats of all FIFOs to a CSV file once per second.
+  void StartLogStats(const std::string& filename);
+  void StopLogStats();
+
+  // Safe to call from any thread.
+  Stats GetStats() const;
+
   float GetCurrentSpeed() const { return m_speed.load(); }
   void UpdateSpeed(float val) { m_speed.store(val); }
 
@@ -58,6 +90,19 @@ private:
   static constexpr float CONTROL_FACTOR = 0.2f;
   static constexpr u32 CONTROL_AVG = 32;  // In freq_shift per FIFO size offset
 
+  // Drift compensation steers the buffered sample count towards the low watermark with a PI
+  // controller. The integral term converges on the ratio between the rate the emulated hardware
+  // produces samples at and the rate the host consumes them at, so the buffer stays put once the
+  // two clocks have been matched instead of oscillating around the watermark.
+  static constexpr double DRIFT_FILL_SMOOTHING = 0.05;
+  // Per low watermark's worth of error
+  static constexpr double DRIFT_KP = 0.005;
+  static constexpr double DRIFT_KI = 0.00002;
+  static constexpr double MAX_DRIFT = 0.01;
+  // The target buffer fill never goes below this, so that the error stays meaningful when the
+  // timing variance is set very low.
+  static constexpr u32 MIN_DRIFT_TARGET_MS = 5;
+
   const unsigned int SURROUND_CHANNELS = 6;
 
   class MixerFifo final
@@ -76,8 +121,11 @@ private:
     void SetVolume(unsigned int lvolume, unsigned int rvolume);
     std::pair<s32, s32> GetVolume() const;
     unsigned int AvailableSamples() const;
+    FifoStats GetStats() const;
 
   private:
+    float GetDriftCompensatedRate(u32 buffered_samples, int timing_variance);
+
     Mixer* m_mixer;
     unsigned m_input_sample_rate;
     bool m_little_endian;
@@ -89,9 +137,21 @@ private:
     std::atomic<s32> m_RVolume{256};
     float m_numLeftI = 0.0f;
     u32 m_frac = 0;
+
+    // Only touched by the audio thread
+    double m_drift_fill = 0.0;
+    double m_drift_integral = 0.0;
+    bool m_starved = true;
+
+    // Written by the audio thread (except m_overruns) and read by anyone for the stats
+    std::atomic<u32> m_buffered_samples{0};
+    std::atomic<u64> m_underruns{0};
+    std::atomic<u64> m_overruns{0};
+    std::atomic<s32> m_drift_ppm{0};
   };
 
   void RefreshConfig();
+  void LogStats();
 
   MixerFifo m_dma_mixer{this, 32000, false};
   MixerFifo m_streaming_mixer{this, 48000, false};
@@ -111,12 +171,17 @@ private:
   bool m_log_dtk_audio = false;
   bool m_log_dsp_audio = false;
 
+  File::IOFile m_stats_log;
+  u64 m_stats_log_start_us = 0;
+  u64 m_stats_log_last_us = 0;
+
   // Current rate of emulation (1.0 = 100% speed)
   std::atomic<float> m_speed{0.0f};
 
   float m_config_emulation_speed;
   int m_config_timing_variance;
   bool m_config_audio_stretch;
+  bool m_config_drift_compensation;
 
   size_t m_config_changed_callback_id;
 };
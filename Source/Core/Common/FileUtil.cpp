@@ -117,6 +117,7 @@ void FileInfo::AndroidContentInit(const std::string& path)
 {
   const jlong result = GetAndroidContentSizeAndIsDirectory(path);
   m_exists = result != -1;
+  m_stat = {};
   m_stat.st_mode = result == -2 ? S_IFDIR : S_IFREG;
   m_stat.st_size = result >= 0 ? result : 0;
 }
@@ -142,6 +143,16 @@ u64 FileInfo::GetSize() const
   return IsFile() ? m_stat.st_size : 0;
 }
 
+s64 FileInfo::GetModificationTime() const
+{
+  return m_exists ? static_cast<s64>(m_stat.st_mtime) : 0;
+}
+
+u64 FileInfo::GetInode() const
+{
+  return m_exists ? static_cast<u64>(m_stat.st_ino) : 0;
+}
+
 // Returns true if the path exists
 bool Exists(const std::string& path)
 {
@@ -996,6 +1007,8 @@ static void RebuildUserDirectories(unsigned int dir_index)
         s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_LOCATIONS;
     s_user_paths[F_MEMORYWATCHERSOCKET_IDX] =
         s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_SOCKET;
+    s_user_paths[F_MEMORYWATCHERSHAREDMEMORY_IDX] =
+        s_user_paths[D_MEMORYWATCHER_IDX] + MEMORYWATCHER_SHARED_MEMORY;
 
     s_user_paths[D_GBAUSER_IDX] = s_user_paths[D_USER_IDX] + GBA_USER_DIR DIR_SEP;
     s_user_paths[D_GBASAVES_IDX] = s_user_paths[D_GBAUSER_IDX] + GBASAVES_DIR DIR_SEP;
@@ -84,6 +84,7 @@ enum
   F_GCSRAM_IDX,
   F_MEMORYWATCHERLOCATIONS_IDX,
   F_MEMORYWATCHERSOCKET_IDX,
+  F_MEMORYWATCHERSHAREDMEMORY_IDX,
   F_WIISDCARD_IDX,
   F_DUALSHOCKUDPCLIENTCONFIG_IDX,
   F_FREELOOKCONFIG_IDX,
@@ -122,6 +123,10 @@ public:
   bool IsFile() const;
   // Returns the size of a file (or returns 0 if the path doesn't refer to a file)
   u64 GetSize() const;
+  // Returns the last modification time in seconds since the epoch (or 0 if unknown)
+  s64 GetModificationTime() const;
+  // Returns the inode number, or 0 on filesystems that don't have one
+  u64 GetInode() const;
 
 private:
 #ifdef ANDROID
@@ -0,0 +1,155 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+// An open-addressing hash map with linear probing for integer keys.
+//
+// All entries live in a single array, so a lookup usually touches one or two cache lines instead
+// of chasing the node pointers of std::unordered_map. Erasing uses backward shifting, so no
+// tombstones are left behind and lookups stay fast after heavy churn.
+//
+// Pointers and references to values are invalidated by any insertion or erasure.
+template <typename Key, typename Value>
+class FlatHashMap
+{
+  static_assert(std::is_integral_v<Key>, "FlatHashMap only supports integer keys");
+
+public:
+  size_t Size() const { return m_size; }
+  bool Empty() const { return m_size == 0; }
+
+  Value* Find(Key key)
+  {
+    if (m_size == 0)
+      return nullptr;
+
+    for (size_t i = Home(key);; i = (i + 1) & m_mask)
+    {
+      Slot& slot = m_slots[i];
+      if (!slot.occupied)
+        return nullptr;
+      if (slot.key == key)
+        return &slot.value;
+    }
+  }
+
+  const Value* Find(Key key) const { return const_cast<FlatHashMap*>(this)->Find(key); }
+
+  // Returns the value for key, inserting a default constructed one if there is none.
+  Value& operator[](Key key)
+  {
+    if ((m_size + 1) * 4 > m_slots.size() * 3)
+      Grow();
+
+    for (size_t i = Home(key);; i = (i + 1) & m_mask)
+    {
+      Slot& slot = m_slots[i];
+      if (!slot.occupied)
+      {
+        slot.occupied = true;
+        slot.key = key;
+        slot.value = Value();
+        m_size++;
+        return slot.value;
+      }
+      if (slot.key == key)
+        return slot.value;
+    }
+  }
+
+  bool Erase(Key key)
+  {
+    if (m_size == 0)
+      return false;
+
+    size_t hole = Home(key);
+    while (true)
+    {
+      if (!m_slots[hole].occupied)
+        return false;
+      if (m_slots[hole].key == key)
+        break;
+      hole = (hole + 1) & m_mask;
+    }
+
+    // Move later entries of the probe sequence back into the hole, as long as that does not put
+    // them in front of their home slot.
+    for (size_t i = (hole + 1) & m_mask; m_slots[i].occupied; i = (i + 1) & m_mask)
+    {
+      const size_t home = Home(m_slots[i].key);
+      if (((i - home) & m_mask) >= ((i - hole) & m_mask))
+      {
+        m_slots[hole].key = m_slots[i].key;
+        m_slots[hole].value = std::move(m_slots[i].value);
+        hole = i;
+      }
+    }
+
+    m_slots[hole].occupied = false;
+    m_slots[hole].value = Value();
+    m_size--;
+    return true;
+  }
+
+  void Clear()
+  {
+    m_slots.clear();
+    m_mask = 0;
+    m_size = 0;
+  }
+
+  // The map must not be modified from within function.
+  template <typename Function>
+  void ForEach(Function function)
+  {
+    for (Slot& slot : m_slots)
+    {
+      if (slot.occupied)
+        function(slot.key, slot.value);
+    }
+  }
+
+private:
+  struct Slot
+  {
+    Key key{};
+    bool occupied = false;
+    Value value{};
+  };
+
+  size_t Home(Key key) const
+  {
+    // Fibonacci hashing, so that keys which only differ in their upper bits (aligned addresses,
+    // for example) still spread across the table.
+    return static_cast<size_t>((static_cast<u64>(key) * 0x9E3779B97F4A7C15ULL) >> 32) & m_mask;
+  }
+
+  void Grow()
+  {
+    std::vector<Slot> old_slots = std::move(m_slots);
+    m_slots = std::vector<Slot>(old_slots.empty() ? 16 : old_slots.size() * 2);
+    m_mask = m_slots.size() - 1;
+    m_size = 0;
+
+    for (Slot& slot : old_slots)
+    {
+      if (slot.occupied)
+        (*this)[slot.key] = std::move(slot.value);
+    }
+  }
+
+  std::vector<Slot> m_slots;
+  size_t m_mask = 0;
+  size_t m_size = 0;
+};
+}  // namespace Common
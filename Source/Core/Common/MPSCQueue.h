@@ -0,0 +1,77 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// a lockless thread-safe,
+// multiple producer, single consumer queue
+
+#include <atomic>
+#include <utility>
+
+namespace Common
+{
+// Producers push onto an intrusive stack with a single compare-and-swap. The consumer takes the
+// whole stack at once and reverses it, so items are handed out in the order they were pushed.
+template <typename T>
+class MPSCQueue
+{
+public:
+  MPSCQueue() = default;
+  ~MPSCQueue() { Clear(); }
+
+  MPSCQueue(const MPSCQueue&) = delete;
+  MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+  bool Empty() const { return !m_head.load(std::memory_order_relaxed); }
+
+  template <typename Arg>
+  void Push(Arg&& t)
+  {
+    Node* node = new Node{std::forward<Arg>(t), m_head.load(std::memory_order_relaxed)};
+    while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                         std::memory_order_relaxed))
+    {
+    }
+  }
+
+  // Consumer only. Calls function with every item pushed so far, oldest first.
+  template <typename Function>
+  void PopAll(Function function)
+  {
+    Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+
+    Node* oldest = nullptr;
+    while (node)
+    {
+      Node* next = node->next;
+      node->next = oldest;
+      oldest = node;
+      node = next;
+    }
+
+    while (oldest)
+    {
+      Node* next = oldest->next;
+      function(std::move(oldest->value));
+      delete oldest;
+      oldest = next;
+    }
+  }
+
+  // Consumer only
+  void Clear()
+  {
+    PopAll([](T&&) {});
+  }
+
+private:
+  struct Node
+  {
+    T value;
+    Node* next;
+  };
+
+  std::atomic<Node*> m_head{nullptr};
+};
+}  // namespace Common
@@ -0,0 +1,260 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/MappedFile.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include <fmt/format.h>
+
+#ifdef _WIN32
+#include <windows.h>
+
+#include "Common/StringUtil.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/statfs.h>
+#include <sys/sysmacros.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__)
+#include <sys/mount.h>
+#endif
+#endif
+
+#ifdef ANDROID
+#include "jni/AndroidCommon/AndroidCommon.h"
+#endif
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+
+namespace File
+{
+MappedFile::MappedFile() = default;
+
+MappedFile::MappedFile(const std::string& filename)
+{
+  Open(filename);
+}
+
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+  Swap(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+  Swap(other);
+  return *this;
+}
+
+void MappedFile::Swap(MappedFile& other) noexcept
+{
+  std::swap(m_data, other.m_data);
+  std::swap(m_size, other.m_size);
+}
+
+#ifdef __linux__
+// statfs f_type values of file systems whose backing storage can go away under a mapping
+static bool IsNetworkOrUserspaceFileSystem(u64 type)
+{
+  switch (type)
+  {
+  case 0x6969:      // NFS
+  case 0x517b:      // SMB
+  case 0xff534d42:  // CIFS
+  case 0xfe534d42:  // SMB2
+  case 0x65735546:  // FUSE
+  case 0x01021997:  // 9P
+  case 0x73757245:  // Coda
+  case 0x5346414f:  // AFS
+  case 0x00c36400:  // Ceph
+    return true;
+  default:
+    return false;
+  }
+}
+#endif
+
+bool MappedFile::IsOnLocalFixedStorage(const std::string& filename)
+{
+#ifdef _WIN32
+  std::wstring volume(MAX_PATH + 1, L'\0');
+  if (!GetVolumePathNameW(UTF8ToWString(filename).c_str(), volume.data(),
+                          static_cast<DWORD>(volume.size())))
+  {
+    return false;
+  }
+  return GetDriveTypeW(volume.c_str()) == DRIVE_FIXED;
+#elif defined(__linux__)
+#ifdef ANDROID
+  if (IsPathAndroidContent(filename))
+    return false;
+#endif
+
+  struct statfs fs_info;
+  if (statfs(filename.c_str(), &fs_info) != 0 ||
+      IsNetworkOrUserspaceFileSystem(static_cast<u64>(fs_info.f_type)))
+  {
+    return false;
+  }
+
+  struct stat file_info;
+  if (stat(filename.c_str(), &file_info) != 0)
+    return false;
+
+  // A partition has no removable attribute of its own, but the whole disk above it does.
+  const std::string device_path = fmt::format("/sys/dev/block/{}:{}/", major(file_info.st_dev),
+                                              minor(file_info.st_dev));
+  // sysfs reports a size of a whole page for every file, so just the first character is read.
+  char removable = 0;
+  if (!File::IOFile(device_path + "removable", "rb").ReadBytes(&removable, 1) &&
+      !File::IOFile(device_path + "../removable", "rb").ReadBytes(&removable, 1))
+  {
+    // Not backed by a block device, like tmpfs, or by one that Linux can't tell about
+    return false;
+  }
+  return removable == '0';
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__)
+  // Removable drives can't be told apart without asking the disk management services, so this
+  // only keeps network file systems out.
+  struct statfs fs_info;
+  return statfs(filename.c_str(), &fs_info) == 0 && (fs_info.f_flags & MNT_LOCAL) != 0;
+#else
+  return false;
+#endif
+}
+
+bool MappedFile::Open(const std::string& filename)
+{
+  Close();
+
+#ifdef _WIN32
+  const HANDLE file = CreateFileW(UTF8ToWString(filename).c_str(), GENERIC_READ,
+                                  FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0 ||
+      static_cast<u64>(file_size.QuadPart) > SIZE_MAX)
+  {
+    CloseHandle(file);
+    return false;
+  }
+
+  // The view keeps the mapping (and the mapping keeps the file) open.
+  const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (!mapping)
+    return false;
+
+  void* const data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!data)
+    return false;
+
+  const u64 size = file_size.QuadPart;
+#else
+#ifdef ANDROID
+  const int fd = IsPathAndroidContent(filename) ? OpenAndroidContent(filename, "r") :
+                                                  open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+#else
+  const int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+  if (fd < 0)
+    return false;
+
+  struct stat file_info;
+  if (fstat(fd, &file_info) != 0 || file_info.st_size <= 0 ||
+      static_cast<u64>(file_info.st_size) > SIZE_MAX)
+  {
+    close(fd);
+    return false;
+  }
+
+  // The mapping stays valid after the descriptor is closed.
+  void* const data = mmap(nullptr, file_info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+    return false;
+
+  const u64 size = file_info.st_size;
+#endif
+
+  m_data = static_cast<const u8*>(data);
+  m_size = size;
+  return true;
+}
+
+void MappedFile::Close()
+{
+  if (!m_data)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_data);
+#else
+  munmap(const_cast<u8*>(m_data), m_size);
+#endif
+
+  m_data = nullptr;
+  m_size = 0;
+}
+
+void MappedFile::Advise(u64 offset, u64 size, AccessHint hint) const
+{
+  if (!m_data || offset >= m_size)
+    return;
+
+  size = std::min(size, m_size - offset);
+
+#ifdef _WIN32
+  // Windows has no equivalent of the other hints for file mappings
+  if (hint != AccessHint::WillNeed)
+    return;
+
+  WIN32_MEMORY_RANGE_ENTRY range;
+  range.VirtualAddress = const_cast<u8*>(m_data + offset);
+  range.NumberOfBytes = static_cast<SIZE_T>(size);
+  PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+  // madvise requires a page aligned address
+  static const u64 page_size = sysconf(_SC_PAGESIZE);
+  const u64 misalignment = offset % page_size;
+  offset -= misalignment;
+  size += misalignment;
+
+  int advice = MADV_NORMAL;
+  switch (hint)
+  {
+  case AccessHint::Normal:
+    advice = MADV_NORMAL;
+    break;
+  case AccessHint::Sequential:
+    advice = MADV_SEQUENTIAL;
+    break;
+  case AccessHint::Random:
+    advice = MADV_RANDOM;
+    break;
+  case AccessHint::WillNeed:
+    advice = MADV_WILLNEED;
+    break;
+  }
+
+  madvise(const_cast<u8*>(m_data + offset), size, advice);
+#endif
+}
+}  // namespace File
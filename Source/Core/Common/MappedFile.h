@@ -0,0 +1,62 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace File
+{
+// A read-only view of a whole file, mapped into memory. Pages are only read from disk when they
+// are first accessed, so this is a cheap way to open big files of which only parts are needed.
+//
+// Other processes may still modify the file while it is mapped, so data read from the mapping
+// must be validated like data read from any other file.
+class MappedFile final
+{
+public:
+  enum class AccessHint
+  {
+    Normal,
+    Sequential,
+    Random,
+    WillNeed,
+  };
+
+  MappedFile();
+  explicit MappedFile(const std::string& filename);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  void Swap(MappedFile& other) noexcept;
+
+  // If the storage device fails or the file gets truncated while it is mapped, reading the
+  // mapping raises SIGBUS (an access violation on Windows) rather than returning an error. This
+  // returns whether the file is on a local, non-removable drive, where that should not happen.
+  // When in doubt, it returns false.
+  static bool IsOnLocalFixedStorage(const std::string& filename);
+
+  // Fails for empty files, since there is nothing to map.
+  bool Open(const std::string& filename);
+  void Close();
+
+  bool IsOpen() const { return m_data != nullptr; }
+  const u8* GetData() const { return m_data; }
+  u64 GetSize() const { return m_size; }
+
+  // Tells the OS how a range of the file is about to be accessed, so that it can adjust its
+  // read-ahead. This is only a hint, and it may do nothing on some systems.
+  void Advise(u64 offset, u64 size, AccessHint hint) const;
+
+private:
+  const u8* m_data = nullptr;
+  u64 m_size = 0;
+};
+}  // namespace File
@@ -99,6 +99,26 @@ public:
   ///
   void UnmapFromMemoryRegion(void* view, size_t size);
 
+  ///
+  /// Change whether a view, or a part of one, can be written to. Writes to a write-protected view
+  /// fault instead, which lets the caller find out which pages are being written to. Unlike
+  /// WriteProtectMemory(), this reports failure instead of raising an alert, so that it can be
+  /// called from a fault handler.
+  ///
+  /// @param view Pointer into a view from CreateView() or MapInMemoryRegion(), aligned to
+  /// GetPageSize().
+  /// @param size Size of the part of the view to change.
+  /// @param writable Whether writes should be allowed.
+  ///
+  /// @return Whether the protection was changed.
+  ///
+  bool SetViewWritable(void* view, size_t size, bool writable) const;
+
+  ///
+  /// @return The granularity at which SetViewWritable() works.
+  ///
+  size_t GetPageSize() const;
+
 private:
 #ifdef _WIN32
   WindowsMemoryRegion* EnsureSplitRegionForMapping(void* address, size_t size);
@@ -106,4 +106,15 @@ void MemArena::UnmapFromMemoryRegion(void* view, size_t size)
   if (retval == MAP_FAILED)
     NOTICE_LOG_FMT(MEMMAP, "mmap failed");
 }
+
+bool MemArena::SetViewWritable(void* view, size_t size, bool writable) const
+{
+  return mprotect(view, size, writable ? PROT_READ | PROT_WRITE : PROT_READ) == 0;
+}
+
+size_t MemArena::GetPageSize() const
+{
+  static const size_t page_size = sysconf(_SC_PAGESIZE);
+  return page_size;
+}
 }  // namespace Common
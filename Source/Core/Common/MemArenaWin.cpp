@@ -419,4 +419,18 @@ void MemArena::UnmapFromMemoryRegion(void* view, size_t size)
 
   UnmapViewOfFile(view);
 }
+
+bool MemArena::SetViewWritable(void* view, size_t size, bool writable) const
+{
+  const DWORD protection = writable ? PAGE_READWRITE : PAGE_READONLY;
+  DWORD old_protection;
+  return VirtualProtect(view, size, protection, &old_protection) != 0;
+}
+
+size_t MemArena::GetPageSize() const
+{
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwPageSize;
+}
 }  // namespace Common
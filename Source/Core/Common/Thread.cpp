@@ -28,6 +28,7 @@
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 #include "Common/StringUtil.h"
+#include "Common/Trace.h"
 
 namespace Common
 {
@@ -111,6 +112,7 @@ static void SetCurrentThreadNameViaApi(const char* name)
 
 void SetCurrentThreadName(const char* name)
 {
+  Trace::SetThreadName(name);
   SetCurrentThreadNameViaException(name);
   SetCurrentThreadNameViaApi(name);
 }
@@ -166,6 +168,8 @@ void SwitchCurrentThread()
 
 void SetCurrentThreadName(const char* name)
 {
+  Trace::SetThreadName(name);
+
 #ifdef __APPLE__
   pthread_setname_np(name);
 #elif defined __FreeBSD__ || defined __OpenBSD__
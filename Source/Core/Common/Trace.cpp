@@ -0,0 +1,202 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/Trace.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/IOFile.h"
+
+namespace Common::Trace
+{
+namespace detail
+{
+std::atomic<bool> g_enabled{false};
+}
+
+namespace
+{
+constexpr u64 EVENTS_PER_THREAD = 1 << 16;
+
+// The fields are atomics so that a writer overwriting the oldest events while a trace is being
+// written is not a data race. Torn events are detected through the write index instead.
+struct Event
+{
+  std::atomic<const char*> name;
+  std::atomic<u64> start_us;
+  std::atomic<u64> end_us;
+};
+
+struct ThreadBuffer
+{
+  u32 id;
+  std::string name;
+  bool in_use = true;
+  std::atomic<u64> write_index{0};
+  std::unique_ptr<Event[]> events = std::make_unique<Event[]>(EVENTS_PER_THREAD);
+};
+
+// Hands the thread's buffer back for reuse when the thread exits.
+struct ThreadState
+{
+  ~ThreadState();
+
+  ThreadBuffer* buffer = nullptr;
+  std::string name;
+};
+}  // namespace
+
+// Buffers are never freed, so that events of threads which have exited can still be written out.
+static std::mutex s_buffers_mutex;
+static std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+static thread_local ThreadState t_state;
+
+ThreadState::~ThreadState()
+{
+  if (!buffer)
+    return;
+
+  std::lock_guard lk(s_buffers_mutex);
+  buffer->in_use = false;
+}
+
+static ThreadBuffer* AcquireBuffer()
+{
+  std::lock_guard lk(s_buffers_mutex);
+
+  auto iter = std::find_if(s_buffers.begin(), s_buffers.end(),
+                           [](const auto& buffer) { return !buffer->in_use; });
+  ThreadBuffer* buffer;
+  if (iter != s_buffers.end())
+  {
+    buffer = iter->get();
+    buffer->in_use = true;
+    buffer->write_index.store(0, std::memory_order_relaxed);
+  }
+  else
+  {
+    s_buffers.push_back(std::make_unique<ThreadBuffer>());
+    buffer = s_buffers.back().get();
+    buffer->id = static_cast<u32>(s_buffers.size());
+  }
+
+  buffer->name = t_state.name.empty() ? fmt::format("Thread {}", buffer->id) : t_state.name;
+  return buffer;
+}
+
+void SetEnabled(bool enabled)
+{
+  detail::g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void SetThreadName(const char* name)
+{
+  t_state.name = name;
+  if (t_state.buffer)
+  {
+    std::lock_guard lk(s_buffers_mutex);
+    t_state.buffer->name = name;
+  }
+}
+
+void AddEvent(const char* name, u64 start_us, u64 end_us)
+{
+  if (!t_state.buffer)
+    t_state.buffer = AcquireBuffer();
+
+  ThreadBuffer* buffer = t_state.buffer;
+  const u64 index = buffer->write_index.load(std::memory_order_relaxed);
+  Event& event = buffer->events[index % EVENTS_PER_THREAD];
+  event.name.store(name, std::memory_order_relaxed);
+  event.start_us.store(start_us, std::memory_order_relaxed);
+  event.end_us.store(end_us, std::memory_order_relaxed);
+  buffer->write_index.store(index + 1, std::memory_order_release);
+}
+
+static std::string EscapeJSON(const std::string& str)
+{
+  std::string escaped;
+  for (char c : str)
+  {
+    if (c == '"' || c == '\\')
+      escaped += '\\';
+    if (static_cast<unsigned char>(c) >= 0x20)
+      escaped += c;
+  }
+  return escaped;
+}
+
+bool WriteChromeTrace(const std::string& path, u64 window_us)
+{
+  File::IOFile file(path, "w");
+  if (!file)
+    return false;
+
+  const u64 now = Timer::GetTimeUs();
+  const u64 window_start = now > window_us ? now - window_us : 0;
+
+  std::lock_guard lk(s_buffers_mutex);
+
+  std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  bool first = true;
+  const auto append = [&](const std::string& entry) {
+    if (!first)
+      json += ",\n";
+    json += entry;
+    first = false;
+  };
+
+  struct CopiedEvent
+  {
+    const char* name;
+    u64 start_us;
+    u64 end_us;
+  };
+  std::vector<CopiedEvent> copied;
+
+  for (const auto& buffer : s_buffers)
+  {
+    const u64 end = buffer->write_index.load(std::memory_order_acquire);
+    const u64 begin = end > EVENTS_PER_THREAD ? end - EVENTS_PER_THREAD : 0;
+
+    copied.clear();
+    for (u64 i = begin; i < end; i++)
+    {
+      const Event& event = buffer->events[i % EVENTS_PER_THREAD];
+      copied.push_back({event.name.load(std::memory_order_relaxed),
+                        event.start_us.load(std::memory_order_relaxed),
+                        event.end_us.load(std::memory_order_relaxed)});
+    }
+
+    // The owning thread may have kept writing while the events were copied. The slot it is
+    // about to write next is index write_index - EVENTS_PER_THREAD, so drop that one and
+    // everything before it.
+    const u64 write_index = buffer->write_index.load(std::memory_order_acquire);
+    const u64 first_valid =
+        write_index >= EVENTS_PER_THREAD ? write_index - EVENTS_PER_THREAD + 1 : 0;
+
+    append(fmt::format(
+        R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"{}"}}}})",
+        buffer->id, EscapeJSON(buffer->name)));
+
+    for (u64 i = std::max(begin, first_valid); i < end; i++)
+    {
+      const CopiedEvent& event = copied[i - begin];
+      if (event.end_us < window_start || !event.name)
+        continue;
+
+      append(fmt::format(R"({{"name":"{}","ph":"X","ts":{},"dur":{},"pid":1,"tid":{}}})",
+                         EscapeJSON(event.name), event.start_us, event.end_us - event.start_us,
+                         buffer->id));
+    }
+  }
+
+  json += "\n]}\n";
+  return file.WriteString(json);
+}
+}  // namespace Common::Trace
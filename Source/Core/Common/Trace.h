@@ -0,0 +1,64 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Common/Timer.h"
+
+// Lightweight trace markers for finding out where the time of a slow frame went.
+//
+// Every thread records its events into its own ring buffer, so recording needs neither locks nor
+// allocations after the first event of a thread. While recording is disabled, a marker costs a
+// single relaxed load. The most recent events of all threads can be written out as Chrome trace
+// event JSON, which chrome://tracing and the Perfetto UI can open.
+namespace Common::Trace
+{
+namespace detail
+{
+extern std::atomic<bool> g_enabled;
+}
+
+inline bool IsEnabled()
+{
+  return detail::g_enabled.load(std::memory_order_relaxed);
+}
+
+void SetEnabled(bool enabled);
+
+// Names the current thread in written traces. Called by Common::SetCurrentThreadName.
+void SetThreadName(const char* name);
+
+// name must be a string literal or otherwise outlive the recorded event.
+void AddEvent(const char* name, u64 start_us, u64 end_us);
+
+// Writes the events of all threads which ended within the last window_us microseconds. Events
+// which were already overwritten in a thread's ring buffer are lost.
+bool WriteChromeTrace(const std::string& path, u64 window_us);
+
+class ScopedEvent
+{
+public:
+  explicit ScopedEvent(const char* name)
+      : m_name(IsEnabled() ? name : nullptr), m_start(m_name ? Timer::GetTimeUs() : 0)
+  {
+  }
+  ~ScopedEvent()
+  {
+    if (m_name)
+      AddEvent(m_name, m_start, Timer::GetTimeUs());
+  }
+
+  ScopedEvent(const ScopedEvent&) = delete;
+  ScopedEvent& operator=(const ScopedEvent&) = delete;
+
+private:
+  const char* m_name;
+  u64 m_start;
+};
+}  // namespace Common::Trace
+
+#define TRACE_SCOPE(name) Common::Trace::ScopedEvent trace_scope(name)
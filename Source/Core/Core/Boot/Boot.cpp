@@ -234,7 +234,8 @@ std::unique_ptr<BootParameters> BootParameters::GenerateFromFile(std::vector<std
       {".gcm", ".iso", ".tgc", ".wbfs", ".ciso", ".gcz", ".wia", ".rvz", ".dol", ".elf"}};
   if (disc_image_extensions.find(extension) != disc_image_extensions.end() || is_drive)
   {
-    std::unique_ptr<DiscIO::VolumeDisc> disc = DiscIO::CreateDisc(path);
+    std::unique_ptr<DiscIO::VolumeDisc> disc =
+        DiscIO::CreateDisc(path, Config::Get(Config::MAIN_MAP_DISC_IMAGES));
     if (disc)
     {
       return std::make_unique<BootParameters>(Disc{std::move(path), std::move(disc), paths},
@@ -470,7 +471,7 @@ static void SetDefaultDisc()
 {
   const std::string default_iso = Config::Get(Config::MAIN_DEFAULT_ISO);
   if (!default_iso.empty())
-    SetDisc(DiscIO::CreateDisc(default_iso));
+    SetDisc(DiscIO::CreateDisc(default_iso, Config::Get(Config::MAIN_MAP_DISC_IMAGES)));
 }
 
 static void CopyDefaultExceptionHandlers()
@@ -608,7 +609,8 @@ bool CBoot::BootUp(std::unique_ptr<BootParameters> boot)
       if (ipl.disc)
       {
         NOTICE_LOG_FMT(BOOT, "Inserting disc: {}", ipl.disc->path);
-        SetDisc(DiscIO::CreateDisc(ipl.disc->path), ipl.disc->auto_disc_change_paths);
+        SetDisc(DiscIO::CreateDisc(ipl.disc->path, Config::Get(Config::MAIN_MAP_DISC_IMAGES)),
+                ipl.disc->auto_disc_change_paths);
       }
 
       SConfig::OnNewTitleLoad();
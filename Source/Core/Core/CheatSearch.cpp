@@ -3,18 +3,27 @@
 
 #include "Core/CheatSearch.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cmath>
+#include <cstring>
 #include <functional>
+#include <future>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <variant>
 #include <vector>
 
 #include "Common/Align.h"
+#include "Common/BitSet.h"
 #include "Common/BitUtils.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
 
 #include "Core/Core.h"
 #include "Core/HW/Memmap.h"
@@ -98,206 +107,91 @@ std::vector<u8> Cheats::GetValueAsByteVector(const Cheats::SearchValue& value)
   }
 }
 
-namespace
+Cheats::ResultBitmap::ResultBitmap(size_t size)
+    : m_words((size + 63) / 64),
+      m_block_ranks((m_words.size() + WORDS_PER_BLOCK - 1) / WORDS_PER_BLOCK), m_size(size)
 {
-template <typename T>
-static std::optional<PowerPC::ReadResult<T>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space);
-
-template <>
-std::optional<PowerPC::ReadResult<u8>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
-{
-  return PowerPC::HostTryReadU8(addr, space);
-}
-
-template <>
-std::optional<PowerPC::ReadResult<u16>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
-{
-  return PowerPC::HostTryReadU16(addr, space);
-}
-
-template <>
-std::optional<PowerPC::ReadResult<u32>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
-{
-  return PowerPC::HostTryReadU32(addr, space);
-}
-
-template <>
-std::optional<PowerPC::ReadResult<u64>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
-{
-  return PowerPC::HostTryReadU64(addr, space);
-}
-
-template <>
-std::optional<PowerPC::ReadResult<s8>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
-{
-  auto tmp = PowerPC::HostTryReadU8(addr, space);
-  if (!tmp)
-    return std::nullopt;
-  return PowerPC::ReadResult<s8>(tmp->translated, Common::BitCast<s8>(tmp->value));
 }
 
-template <>
-std::optional<PowerPC::ReadResult<s16>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
+void Cheats::ResultBitmap::SetAll()
 {
-  auto tmp = PowerPC::HostTryReadU16(addr, space);
-  if (!tmp)
-    return std::nullopt;
-  return PowerPC::ReadResult<s16>(tmp->translated, Common::BitCast<s16>(tmp->value));
+  std::fill(m_words.begin(), m_words.end(), ~u64(0));
+  if (m_size % 64 != 0)
+    m_words.back() = (u64(1) << (m_size % 64)) - 1;
+  UpdateIndex();
 }
 
-template <>
-std::optional<PowerPC::ReadResult<s32>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
+void Cheats::ResultBitmap::ClearAll()
 {
-  auto tmp = PowerPC::HostTryReadU32(addr, space);
-  if (!tmp)
-    return std::nullopt;
-  return PowerPC::ReadResult<s32>(tmp->translated, Common::BitCast<s32>(tmp->value));
-}
-
-template <>
-std::optional<PowerPC::ReadResult<s64>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
-{
-  auto tmp = PowerPC::HostTryReadU64(addr, space);
-  if (!tmp)
-    return std::nullopt;
-  return PowerPC::ReadResult<s64>(tmp->translated, Common::BitCast<s64>(tmp->value));
+  std::fill(m_words.begin(), m_words.end(), 0);
+  UpdateIndex();
 }
 
-template <>
-std::optional<PowerPC::ReadResult<float>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
+void Cheats::ResultBitmap::UpdateIndex()
 {
-  return PowerPC::HostTryReadF32(addr, space);
+  size_t count = 0;
+  for (size_t i = 0; i < m_words.size(); ++i)
+  {
+    if (i % WORDS_PER_BLOCK == 0)
+      m_block_ranks[i / WORDS_PER_BLOCK] = count;
+    count += Common::CountSetBits(m_words[i]);
+  }
+  m_count = count;
 }
 
-template <>
-std::optional<PowerPC::ReadResult<double>>
-TryReadValueFromEmulatedMemory(u32 addr, PowerPC::RequestedAddressSpace space)
+size_t Cheats::ResultBitmap::Select(size_t n) const
 {
-  return PowerPC::HostTryReadF64(addr, space);
-}
-}  // namespace
-
-template <typename T>
-Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
-Cheats::NewSearch(const std::vector<Cheats::MemoryRange>& memory_ranges,
-                  PowerPC::RequestedAddressSpace address_space, bool aligned,
-                  const std::function<bool(const T& value)>& validator)
-{
-  const u32 data_size = sizeof(T);
-  std::vector<Cheats::SearchResult<T>> results;
-  Cheats::SearchErrorCode error_code = Cheats::SearchErrorCode::Success;
-  Core::RunAsCPUThread([&] {
-    const Core::State core_state = Core::GetState();
-    if (core_state != Core::State::Running && core_state != Core::State::Paused)
-    {
-      error_code = Cheats::SearchErrorCode::NoEmulationActive;
-      return;
-    }
-
-    if (address_space == PowerPC::RequestedAddressSpace::Virtual && !MSR.DR)
-    {
-      error_code = Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
-      return;
-    }
-
-    for (const Cheats::MemoryRange& range : memory_ranges)
-    {
-      if (range.m_length < data_size)
-        continue;
-
-      const u32 increment_per_loop = aligned ? data_size : 1;
-      const u32 start_address = aligned ? Common::AlignUp(range.m_start, data_size) : range.m_start;
-      const u64 aligned_length = range.m_length - (start_address - range.m_start);
-
-      if (aligned_length < data_size)
-        continue;
+  // The last block with at most n set bits in front of it is the one holding the n-th bit.
+  const auto block = std::upper_bound(m_block_ranks.begin(), m_block_ranks.end(), n) - 1;
+  size_t word = (block - m_block_ranks.begin()) * WORDS_PER_BLOCK;
+  size_t remaining = n - *block;
+  while (remaining >= static_cast<size_t>(Common::CountSetBits(m_words[word])))
+  {
+    remaining -= Common::CountSetBits(m_words[word]);
+    ++word;
+  }
 
-      const u64 length = aligned_length - (data_size - 1);
-      for (u64 i = 0; i < length; i += increment_per_loop)
-      {
-        const u32 addr = start_address + i;
-        const auto current_value = TryReadValueFromEmulatedMemory<T>(addr, address_space);
-        if (!current_value)
-          continue;
-
-        if (validator(current_value->value))
-        {
-          auto& r = results.emplace_back();
-          r.m_value = current_value->value;
-          r.m_value_state = current_value->translated ?
-                                Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                                Cheats::SearchResultValueState::ValueFromPhysicalMemory;
-          r.m_address = addr;
-        }
-      }
-    }
-  });
-  if (error_code == Cheats::SearchErrorCode::Success)
-    return results;
-  return error_code;
+  u64 bits = m_words[word];
+  for (; remaining > 0; --remaining)
+    bits &= bits - 1;
+  return word * 64 + Common::LeastSignificantSetBit(bits);
 }
 
-template <typename T>
-Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
-Cheats::NextSearch(const std::vector<Cheats::SearchResult<T>>& previous_results,
-                   PowerPC::RequestedAddressSpace address_space,
-                   const std::function<bool(const T& new_value, const T& old_value)>& validator)
+// Copies [address, address + size) of emulated memory into snapshot, and marks the slots which
+// overlap memory that couldn't be read. Must be called on the CPU thread.
+static void SnapshotMemory(u32 address, u32 size, u32 stride, u32 value_size,
+                           PowerPC::RequestedAddressSpace space, u8* snapshot,
+                           Cheats::ResultBitmap* inaccessible)
 {
-  std::vector<Cheats::SearchResult<T>> results;
-  Cheats::SearchErrorCode error_code = Cheats::SearchErrorCode::Success;
-  Core::RunAsCPUThread([&] {
-    const Core::State core_state = Core::GetState();
-    if (core_state != Core::State::Running && core_state != Core::State::Paused)
-    {
-      error_code = Cheats::SearchErrorCode::NoEmulationActive;
-      return;
-    }
+  // Usually a whole range of RAM is mapped contiguously, so try that first.
+  if (const auto range = PowerPC::HostGetRAMRange(address, size, space))
+  {
+    std::memcpy(snapshot, range->data, size);
+    return;
+  }
 
-    if (address_space == PowerPC::RequestedAddressSpace::Virtual && !MSR.DR)
+  u32 offset = 0;
+  while (offset < size)
+  {
+    const u32 page_offset = static_cast<u32>((address + offset) & PowerPC::HW_PAGE_MASK);
+    const u32 chunk_size =
+        std::min(size - offset, static_cast<u32>(PowerPC::HW_PAGE_SIZE) - page_offset);
+    if (const auto range = PowerPC::HostGetRAMRange(address + offset, chunk_size, space))
     {
-      error_code = Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
-      return;
+      std::memcpy(snapshot + offset, range->data, chunk_size);
     }
-
-    for (const auto& previous_result : previous_results)
+    else
     {
-      const u32 addr = previous_result.m_address;
-      const auto current_value = TryReadValueFromEmulatedMemory<T>(addr, address_space);
-      if (!current_value)
-      {
-        auto& r = results.emplace_back();
-        r.m_address = addr;
-        r.m_value_state = Cheats::SearchResultValueState::AddressNotAccessible;
-        continue;
-      }
-
-      // if the previous state was invalid we always update the value to avoid getting stuck in an
-      // invalid state
-      if (!previous_result.IsValueValid() ||
-          validator(current_value->value, previous_result.m_value))
-      {
-        auto& r = results.emplace_back();
-        r.m_value = current_value->value;
-        r.m_value_state = current_value->translated ?
-                              Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                              Cheats::SearchResultValueState::ValueFromPhysicalMemory;
-        r.m_address = addr;
-      }
+      std::memset(snapshot + offset, 0, chunk_size);
+      const u32 first_slot =
+          offset + 1 > value_size ? (offset + 1 - value_size + stride - 1) / stride : 0;
+      const u32 end_slot = std::min<u32>(static_cast<u32>(inaccessible->Size()),
+                                         (offset + chunk_size + stride - 1) / stride);
+      for (u32 slot = first_slot; slot < end_slot; ++slot)
+        inaccessible->Set(slot);
     }
-  });
-  if (error_code == Cheats::SearchErrorCode::Success)
-    return results;
-  return error_code;
+    offset += chunk_size;
+  }
 }
 
 Cheats::CheatSearchSessionBase::~CheatSearchSessionBase() = default;
@@ -368,113 +262,264 @@ bool Cheats::CheatSearchSession<T>::SetValueFromString(const std::string& value_
   return m_value.has_value();
 }
 
+template <typename T>
+void Cheats::CheatSearchSession<T>::SetFloatTolerance(double tolerance)
+{
+  m_float_tolerance = tolerance;
+}
+
 template <typename T>
 void Cheats::CheatSearchSession<T>::ResetResults()
 {
   m_first_search_done = false;
-  m_search_results.clear();
+  m_regions.clear();
+  UpdateResultCounts();
 }
 
-template <typename T>
-static std::function<bool(const T& new_value)>
-MakeCompareFunctionForSpecificValue(Cheats::CompareType op, const T& old_value)
+template <typename T, typename Func>
+static auto WithCompareFunction(Cheats::CompareType op, double tolerance, const Func& func)
 {
+  if constexpr (std::is_floating_point_v<T>)
+  {
+    if (tolerance > 0)
+    {
+      const T t = static_cast<T>(tolerance);
+      switch (op)
+      {
+      case Cheats::CompareType::Equal:
+        return func([t](T a, T b) { return a == b || std::abs(a - b) <= t; });
+      case Cheats::CompareType::NotEqual:
+        return func([t](T a, T b) { return !(a == b || std::abs(a - b) <= t); });
+      case Cheats::CompareType::Less:
+        return func([t](T a, T b) { return a < b - t; });
+      case Cheats::CompareType::LessOrEqual:
+        return func([t](T a, T b) { return a <= b + t; });
+      case Cheats::CompareType::Greater:
+        return func([t](T a, T b) { return a > b + t; });
+      case Cheats::CompareType::GreaterOrEqual:
+        return func([t](T a, T b) { return a >= b - t; });
+      default:
+        break;
+      }
+    }
+  }
+
   switch (op)
   {
   case Cheats::CompareType::Equal:
-    return [&](const T& new_value) { return new_value == old_value; };
+    return func(std::equal_to<T>());
   case Cheats::CompareType::NotEqual:
-    return [&](const T& new_value) { return new_value != old_value; };
+    return func(std::not_equal_to<T>());
   case Cheats::CompareType::Less:
-    return [&](const T& new_value) { return new_value < old_value; };
+    return func(std::less<T>());
   case Cheats::CompareType::LessOrEqual:
-    return [&](const T& new_value) { return new_value <= old_value; };
+    return func(std::less_equal<T>());
   case Cheats::CompareType::Greater:
-    return [&](const T& new_value) { return new_value > old_value; };
+    return func(std::greater<T>());
   case Cheats::CompareType::GreaterOrEqual:
-    return [&](const T& new_value) { return new_value >= old_value; };
+    return func(std::greater_equal<T>());
   default:
     assert(0);
-    return nullptr;
+    return func(std::equal_to<T>());
   }
 }
 
 template <typename T>
-static std::function<bool(const T& old_value, const T& new_value)>
-MakeCompareFunctionForLastValue(Cheats::CompareType op)
+auto Cheats::CheatSearchSession<T>::MakeRegions() const -> std::vector<SearchRegion>
 {
-  switch (op)
+  const u32 data_size = sizeof(T);
+  const u32 stride = GetSlotStride();
+
+  std::vector<SearchRegion> regions;
+  for (const Cheats::MemoryRange& range : m_memory_ranges)
   {
-  case Cheats::CompareType::Equal:
-    return [](const T& new_value, const T& old_value) { return new_value == old_value; };
-  case Cheats::CompareType::NotEqual:
-    return [](const T& new_value, const T& old_value) { return new_value != old_value; };
-  case Cheats::CompareType::Less:
-    return [](const T& new_value, const T& old_value) { return new_value < old_value; };
-  case Cheats::CompareType::LessOrEqual:
-    return [](const T& new_value, const T& old_value) { return new_value <= old_value; };
-  case Cheats::CompareType::Greater:
-    return [](const T& new_value, const T& old_value) { return new_value > old_value; };
-  case Cheats::CompareType::GreaterOrEqual:
-    return [](const T& new_value, const T& old_value) { return new_value >= old_value; };
-  default:
-    assert(0);
-    return nullptr;
+    const u32 start_address = m_aligned ? Common::AlignUp(range.m_start, data_size) : range.m_start;
+    const u64 alignment_padding = start_address - range.m_start;
+    if (range.m_length < alignment_padding + data_size)
+      continue;
+
+    const u64 length = std::min<u64>(range.m_length - alignment_padding,
+                                     std::numeric_limits<u32>::max() - start_address);
+    if (length < data_size)
+      continue;
+
+    SearchRegion& region = regions.emplace_back();
+    region.first_address = start_address;
+    region.slot_count = static_cast<u32>((length - data_size) / stride + 1);
+    region.results = ResultBitmap(region.slot_count);
+    region.results.SetAll();
   }
+  return regions;
+}
+
+template <typename T>
+template <typename Compare>
+Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::Filter(bool new_search,
+                                                              const Compare& compare)
+{
+  const u32 stride = GetSlotStride();
+  std::vector<SearchRegion> new_regions;
+  if (new_search)
+    new_regions = MakeRegions();
+  std::vector<SearchRegion>& regions = new_search ? new_regions : m_regions;
+
+  std::vector<std::vector<u8>> snapshots(regions.size());
+  std::vector<ResultBitmap> inaccessible(regions.size());
+  bool translated = false;
+  Cheats::SearchErrorCode error_code = Cheats::SearchErrorCode::Success;
+  Core::RunAsCPUThread([&] {
+    const Core::State core_state = Core::GetState();
+    if (core_state != Core::State::Running && core_state != Core::State::Paused)
+    {
+      error_code = Cheats::SearchErrorCode::NoEmulationActive;
+      return;
+    }
+
+    if (m_address_space == PowerPC::RequestedAddressSpace::Virtual && !MSR.DR)
+    {
+      error_code = Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
+      return;
+    }
+
+    translated = m_address_space == PowerPC::RequestedAddressSpace::Virtual ||
+                 (m_address_space == PowerPC::RequestedAddressSpace::Effective && MSR.DR);
+
+    // Only the copy has to happen with the CPU thread paused. The comparisons run afterwards.
+    for (size_t i = 0; i < regions.size(); ++i)
+    {
+      const u32 size = (regions[i].slot_count - 1) * stride + sizeof(T);
+      snapshots[i].resize(size);
+      inaccessible[i] = ResultBitmap(regions[i].slot_count);
+      SnapshotMemory(regions[i].first_address, size, stride, sizeof(T), m_address_space,
+                     snapshots[i].data(), &inaccessible[i]);
+    }
+  });
+  if (error_code != Cheats::SearchErrorCode::Success)
+    return error_code;
+
+  struct Task
+  {
+    size_t region;
+    size_t word_begin;
+    size_t word_end;
+  };
+  constexpr size_t WORDS_PER_TASK = 0x1000;
+  std::vector<Task> tasks;
+  for (size_t i = 0; i < regions.size(); ++i)
+  {
+    const size_t word_count = regions[i].results.WordCount();
+    for (size_t word = 0; word < word_count; word += WORDS_PER_TASK)
+      tasks.push_back({i, word, std::min(word + WORDS_PER_TASK, word_count)});
+  }
+
+  std::atomic<size_t> next_task = 0;
+  const auto run_tasks = [&] {
+    for (size_t task_index = next_task++; task_index < tasks.size(); task_index = next_task++)
+    {
+      const Task& task = tasks[task_index];
+      SearchRegion& region = regions[task.region];
+      const u8* new_values = snapshots[task.region].data();
+      const u8* old_values = new_search ? new_values : region.snapshot.data();
+      const u64* old_inaccessible = new_search ? nullptr : region.inaccessible.Words();
+      const auto filter = [&](auto filter_words) {
+        filter_words(compare, region.slot_count, new_values, old_values,
+                     inaccessible[task.region].Words(), old_inaccessible, region.results.Words(),
+                     task.word_begin, task.word_end);
+      };
+      if (stride == 1)
+        filter(FilterWords<T, 1, Compare>);
+      else
+        filter(FilterWords<T, sizeof(T), Compare>);
+    }
+  };
+
+  const size_t thread_count =
+      std::min<size_t>(tasks.size(), std::max(1u, std::thread::hardware_concurrency()));
+  std::vector<std::future<void>> futures;
+  for (size_t i = 1; i < thread_count; ++i)
+    futures.push_back(std::async(std::launch::async, run_tasks));
+  run_tasks();
+  for (std::future<void>& future : futures)
+    future.get();
+
+  for (size_t i = 0; i < regions.size(); ++i)
+  {
+    regions[i].snapshot = std::move(snapshots[i]);
+    regions[i].inaccessible = std::move(inaccessible[i]);
+    regions[i].results.UpdateIndex();
+  }
+  if (new_search)
+    m_regions = std::move(new_regions);
+  m_values_translated = translated;
+  UpdateResultCounts();
+  return Cheats::SearchErrorCode::Success;
+}
+
+template <typename T>
+void Cheats::CheatSearchSession<T>::UpdateResultCounts()
+{
+  m_region_result_offsets.clear();
+  m_result_count = 0;
+  m_valid_value_count = 0;
+  for (const SearchRegion& region : m_regions)
+  {
+    m_region_result_offsets.push_back(m_result_count);
+    m_result_count += region.results.Count();
+
+    const u64* results = region.results.Words();
+    const u64* inaccessible = region.inaccessible.Words();
+    for (size_t i = 0; i < region.results.WordCount(); ++i)
+      m_valid_value_count += Common::CountSetBits(results[i] & ~inaccessible[i]);
+  }
+}
+
+template <typename T>
+auto Cheats::CheatSearchSession<T>::FindResult(size_t index) const
+    -> std::pair<const SearchRegion*, size_t>
+{
+  const auto offset = std::upper_bound(m_region_result_offsets.begin(),
+                                       m_region_result_offsets.end(), index) -
+                      1;
+  const SearchRegion& region = m_regions[offset - m_region_result_offsets.begin()];
+  return {&region, region.results.Select(index - *offset)};
 }
 
 template <typename T>
 Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::RunSearch()
 {
-  Common::Result<SearchErrorCode, std::vector<SearchResult<T>>> result =
-      Cheats::SearchErrorCode::InvalidParameters;
+  const bool new_search = !m_first_search_done;
+  Cheats::SearchErrorCode error_code = Cheats::SearchErrorCode::InvalidParameters;
   if (m_filter_type == FilterType::CompareAgainstSpecificValue)
   {
     if (!m_value)
       return Cheats::SearchErrorCode::InvalidParameters;
 
-    auto func = MakeCompareFunctionForSpecificValue<T>(m_compare_type, *m_value);
-    if (m_first_search_done)
-    {
-      result = Cheats::NextSearch<T>(
-          m_search_results, m_address_space,
-          [&func](const T& new_value, const T& old_value) { return func(new_value); });
-    }
-    else
-    {
-      result = Cheats::NewSearch<T>(m_memory_ranges, m_address_space, m_aligned, func);
-    }
+    const T value = *m_value;
+    error_code = WithCompareFunction<T>(m_compare_type, m_float_tolerance, [&](auto compare) {
+      return Filter(new_search, [compare, value](T new_value, T old_value) {
+        return compare(new_value, value);
+      });
+    });
   }
   else if (m_filter_type == FilterType::CompareAgainstLastValue)
   {
-    if (!m_first_search_done)
+    if (new_search)
       return Cheats::SearchErrorCode::InvalidParameters;
 
-    result = Cheats::NextSearch<T>(m_search_results, m_address_space,
-                                   MakeCompareFunctionForLastValue<T>(m_compare_type));
+    error_code = WithCompareFunction<T>(m_compare_type, m_float_tolerance, [&](auto compare) {
+      return Filter(false, [compare](T new_value, T old_value) {
+        return compare(new_value, old_value);
+      });
+    });
   }
   else if (m_filter_type == FilterType::DoNotFilter)
   {
-    if (m_first_search_done)
-    {
-      result = Cheats::NextSearch<T>(m_search_results, m_address_space,
-                                     [](const T& v1, const T& v2) { return true; });
-    }
-    else
-    {
-      result = Cheats::NewSearch<T>(m_memory_ranges, m_address_space, m_aligned,
-                                    [](const T& v) { return true; });
-    }
+    error_code = Filter(new_search, [](T new_value, T old_value) { return true; });
   }
 
-  if (result.Succeeded())
-  {
-    m_search_results = std::move(*result);
+  if (error_code == Cheats::SearchErrorCode::Success)
     m_first_search_done = true;
-    return Cheats::SearchErrorCode::Success;
-  }
-
-  return result.Error();
+  return error_code;
 }
 
 template <typename T>
@@ -522,38 +567,33 @@ bool Cheats::CheatSearchSession<T>::IsFloatingType() const
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetResultCount() const
 {
-  return m_search_results.size();
+  return m_result_count;
 }
 
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetValidValueCount() const
 {
-  const auto& results = m_search_results;
-  size_t count = 0;
-  for (const auto& r : results)
-  {
-    if (r.IsValueValid())
-      ++count;
-  }
-  return count;
+  return m_valid_value_count;
 }
 
 template <typename T>
 u32 Cheats::CheatSearchSession<T>::GetResultAddress(size_t index) const
 {
-  return m_search_results[index].m_address;
+  const auto [region, slot] = FindResult(index);
+  return region->first_address + static_cast<u32>(slot) * GetSlotStride();
 }
 
 template <typename T>
 T Cheats::CheatSearchSession<T>::GetResultValue(size_t index) const
 {
-  return m_search_results[index].m_value;
+  const auto [region, slot] = FindResult(index);
+  return LoadValue<T>(region->snapshot.data() + slot * GetSlotStride());
 }
 
 template <typename T>
 Cheats::SearchValue Cheats::CheatSearchSession<T>::GetResultValueAsSearchValue(size_t index) const
 {
-  return Cheats::SearchValue{m_search_results[index].m_value};
+  return Cheats::SearchValue{GetResultValue(index)};
 }
 
 template <typename T>
@@ -562,24 +602,29 @@ std::string Cheats::CheatSearchSession<T>::GetResultValueAsString(size_t index,
   if (GetResultValueState(index) == Cheats::SearchResultValueState::AddressNotAccessible)
     return "(inaccessible)";
 
+  const T value = GetResultValue(index);
   if (hex)
   {
     if constexpr (std::is_same_v<T, float>)
-      return fmt::format("0x{0:08x}", Common::BitCast<u32>(m_search_results[index].m_value));
+      return fmt::format("0x{0:08x}", Common::BitCast<u32>(value));
     else if constexpr (std::is_same_v<T, double>)
-      return fmt::format("0x{0:016x}", Common::BitCast<u64>(m_search_results[index].m_value));
+      return fmt::format("0x{0:016x}", Common::BitCast<u64>(value));
     else
-      return fmt::format("0x{0:0{1}x}", m_search_results[index].m_value, sizeof(T) * 2);
+      return fmt::format("0x{0:0{1}x}", value, sizeof(T) * 2);
   }
 
-  return fmt::format("{}", m_search_results[index].m_value);
+  return fmt::format("{}", value);
 }
 
 template <typename T>
 Cheats::SearchResultValueState
 Cheats::CheatSearchSession<T>::GetResultValueState(size_t index) const
 {
-  return m_search_results[index].m_value_state;
+  const auto [region, slot] = FindResult(index);
+  if (region->inaccessible.Test(slot))
+    return Cheats::SearchResultValueState::AddressNotAccessible;
+  return m_values_translated ? Cheats::SearchResultValueState::ValueFromVirtualMemory :
+                               Cheats::SearchResultValueState::ValueFromPhysicalMemory;
 }
 
 template <typename T>
@@ -598,18 +643,24 @@ template <typename T>
 std::unique_ptr<Cheats::CheatSearchSessionBase>
 Cheats::CheatSearchSession<T>::ClonePartial(const std::vector<size_t>& result_indices) const
 {
-  const auto& results = m_search_results;
-  std::vector<SearchResult<T>> partial_results;
-  partial_results.reserve(result_indices.size());
-  for (size_t idx : result_indices)
-    partial_results.push_back(results[idx]);
-
   auto c =
       std::make_unique<Cheats::CheatSearchSession<T>>(m_memory_ranges, m_address_space, m_aligned);
-  c->m_search_results = std::move(partial_results);
+  c->m_regions = m_regions;
+  for (SearchRegion& region : c->m_regions)
+    region.results.ClearAll();
+  for (size_t idx : result_indices)
+  {
+    const auto [region, slot] = FindResult(idx);
+    c->m_regions[region - m_regions.data()].results.Set(slot);
+  }
+  for (SearchRegion& region : c->m_regions)
+    region.results.UpdateIndex();
+  c->m_values_translated = m_values_translated;
+  c->UpdateResultCounts();
   c->m_compare_type = this->m_compare_type;
   c->m_filter_type = this->m_filter_type;
   c->m_value = this->m_value;
+  c->m_float_tolerance = this->m_float_tolerance;
   c->m_first_search_done = this->m_first_search_done;
   return c;
 }
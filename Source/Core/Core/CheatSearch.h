@@ -3,15 +3,19 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <variant>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/Result.h"
+#include "Common/Swap.h"
 #include "Core/PowerPC/MMU.h"
 
 namespace Cheats
@@ -59,19 +63,85 @@ enum class SearchResultValueState : u8
   AddressNotAccessible,
 };
 
-template <typename T>
-struct SearchResult
+// A bitmap with an index over its population counts, so that the n-th set bit can be found
+// without scanning everything in front of it. Cheat search keeps one bit per candidate address
+// instead of a list of results, which keeps repeated searches over all of RAM cheap.
+class ResultBitmap
 {
-  T m_value;
-  SearchResultValueState m_value_state;
-  u32 m_address;
+public:
+  ResultBitmap() = default;
+  explicit ResultBitmap(size_t size);
+
+  size_t Size() const { return m_size; }
+  size_t WordCount() const { return m_words.size(); }
+
+  bool Test(size_t index) const { return (m_words[index / 64] >> (index % 64)) & 1; }
+  void Set(size_t index) { m_words[index / 64] |= u64(1) << (index % 64); }
+  void SetAll();
+  void ClearAll();
 
-  bool IsValueValid() const
+  // For operating on 64 bits at once. The bits past Size() in the last word must stay clear.
+  // Count() and Select() are only correct again after calling UpdateIndex().
+  u64* Words() { return m_words.data(); }
+  const u64* Words() const { return m_words.data(); }
+  void UpdateIndex();
+
+  size_t Count() const { return m_count; }
+
+  // Returns the index of the n-th set bit. n must be less than Count().
+  size_t Select(size_t n) const;
+
+private:
+  static constexpr size_t WORDS_PER_BLOCK = 8;
+
+  std::vector<u64> m_words;
+  // The number of set bits in front of each block of WORDS_PER_BLOCK words.
+  std::vector<size_t> m_block_ranks;
+  size_t m_size = 0;
+  size_t m_count = 0;
+};
+
+// Reads a big-endian value out of a memory snapshot.
+template <typename T>
+T LoadValue(const u8* data)
+{
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return Common::FromBigEndian(value);
+}
+
+// Narrows down the results in [word_begin, word_end) of a region. The comparisons are done for
+// all 64 slots of a word without branching, which lets the compiler vectorize the inner loop.
+// Slots which couldn't be read are kept around, except in a new search.
+template <typename T, u32 stride, typename Compare>
+void FilterWords(const Compare& compare, size_t slot_count, const u8* new_values,
+                 const u8* old_values, const u64* new_inaccessible, const u64* old_inaccessible,
+                 u64* results, size_t word_begin, size_t word_end)
+{
+  for (size_t word = word_begin; word < word_end; ++word)
   {
-    return m_value_state == SearchResultValueState::ValueFromPhysicalMemory ||
-           m_value_state == SearchResultValueState::ValueFromVirtualMemory;
+    if (results[word] == 0)
+      continue;
+
+    const size_t first_slot = word * 64;
+    const size_t slots = std::min<size_t>(64, slot_count - first_slot);
+    const u8* new_data = new_values + first_slot * stride;
+    const u8* old_data = old_values + first_slot * stride;
+    u64 keep = 0;
+    for (size_t i = 0; i < slots; ++i)
+    {
+      keep |= u64(compare(LoadValue<T>(new_data + i * stride), LoadValue<T>(old_data + i * stride)))
+              << i;
+    }
+
+    if (old_inaccessible)
+      keep |= new_inaccessible[word] | old_inaccessible[word];
+    else
+      keep &= ~new_inaccessible[word];
+    results[word] &= keep;
   }
-};
+}
+
 
 struct MemoryRange
 {
@@ -104,22 +174,6 @@ DataType GetDataType(const SearchValue& value);
 // patches or action replay codes.
 std::vector<u8> GetValueAsByteVector(const SearchValue& value);
 
-// Do a new search across the given memory region in the given address space, only keeping values
-// for which the given validator returns true.
-template <typename T>
-Common::Result<SearchErrorCode, std::vector<SearchResult<T>>>
-NewSearch(const std::vector<MemoryRange>& memory_ranges,
-          PowerPC::RequestedAddressSpace address_space, bool aligned,
-          const std::function<bool(const T& value)>& validator);
-
-// Refresh the values for the given results in the given address space, only keeping values for
-// which the given validator returns true.
-template <typename T>
-Common::Result<SearchErrorCode, std::vector<SearchResult<T>>>
-NextSearch(const std::vector<SearchResult<T>>& previous_results,
-           PowerPC::RequestedAddressSpace address_space,
-           const std::function<bool(const T& new_value, const T& old_value)>& validator);
-
 class CheatSearchSessionBase
 {
 public:
@@ -134,6 +188,10 @@ public:
   // Set the value of the CompareAgainstSpecificValue filter used by subsequent searches.
   virtual bool SetValueFromString(const std::string& value_as_string, bool force_parse_as_hex) = 0;
 
+  // Set how far apart two floating point values may be and still count as equal in subsequent
+  // searches. The ordering comparisons treat such values as equal too. Ignored for integer types.
+  virtual void SetFloatTolerance(double tolerance) = 0;
+
   // Resets the search results, causing the next search to act as a new search.
   virtual void ResetResults() = 0;
 
@@ -182,6 +240,7 @@ public:
   void SetCompareType(CompareType compare_type) override;
   void SetFilterType(FilterType filter_type) override;
   bool SetValueFromString(const std::string& value_as_string, bool force_parse_as_hex) override;
+  void SetFloatTolerance(double tolerance) override;
 
   void ResetResults() override;
   SearchErrorCode RunSearch() override;
@@ -209,12 +268,43 @@ public:
   ClonePartial(const std::vector<size_t>& result_indices) const override;
 
 private:
-  std::vector<SearchResult<T>> m_search_results;
+  // The part of a memory range which holds at least one value, with one result slot for every
+  // address a value can start at.
+  struct SearchRegion
+  {
+    u32 first_address;
+    u32 slot_count;
+
+    // The big-endian contents of emulated memory as of the last search, covering all slots.
+    std::vector<u8> snapshot;
+
+    ResultBitmap results;
+
+    // Slots whose value couldn't be read in the last search.
+    ResultBitmap inaccessible;
+  };
+
+  u32 GetSlotStride() const { return m_aligned ? sizeof(T) : 1; }
+  std::vector<SearchRegion> MakeRegions() const;
+  std::pair<const SearchRegion*, size_t> FindResult(size_t index) const;
+  void UpdateResultCounts();
+
+  template <typename Compare>
+  SearchErrorCode Filter(bool new_search, const Compare& compare);
+
+  std::vector<SearchRegion> m_regions;
+  // The index of the first result of each region.
+  std::vector<size_t> m_region_result_offsets;
+  size_t m_result_count = 0;
+  size_t m_valid_value_count = 0;
+  bool m_values_translated = false;
+
   std::vector<MemoryRange> m_memory_ranges;
   PowerPC::RequestedAddressSpace m_address_space;
   CompareType m_compare_type = CompareType::Equal;
   FilterType m_filter_type = FilterType::DoNotFilter;
   std::optional<T> m_value = std::nullopt;
+  double m_float_tolerance = 0;
   bool m_aligned;
   bool m_first_search_done = false;
 };
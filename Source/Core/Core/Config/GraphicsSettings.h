@@ -28,6 +28,7 @@ extern const Info<AspectMode> GFX_ASPECT_RATIO;
 extern const Info<AspectMode> GFX_SUGGESTED_ASPECT_RATIO;
 extern const Info<bool> GFX_CROP;
 extern const Info<int> GFX_SAFE_TEXTURE_CACHE_COLOR_SAMPLES;
+extern const Info<int> GFX_TEXTURE_CACHE_MEMORY_BUDGET;
 extern const Info<bool> GFX_SHOW_FPS;
 extern const Info<bool> GFX_SHOW_BATTER_FIELDER;
 extern const Info<bool> GFX_TRAINING_MODE;
@@ -84,6 +85,8 @@ extern const Info<bool> GFX_SW_DUMP_TEV_TEX_FETCHES;
 extern const Info<int> GFX_SW_DRAW_START;
 extern const Info<int> GFX_SW_DRAW_END;
 
+extern const Info<bool> GFX_NULL_ANALYSIS_MODE;
+
 extern const Info<bool> GFX_PREFER_GLES;
 
 // Graphics.Enhancements
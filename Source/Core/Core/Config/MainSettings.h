@@ -54,6 +54,7 @@ namespace Config
 extern const Info<bool> MAIN_SKIP_IPL;
 extern const Info<PowerPC::CPUCore> MAIN_CPU_CORE;
 extern const Info<bool> MAIN_JIT_FOLLOW_BRANCH;
+extern const Info<bool> MAIN_JIT_PRECOMPILE_BLOCKS;
 extern const Info<bool> MAIN_FASTMEM;
 // Should really be in the DSP section, but we're kind of stuck with bad decisions made in the past.
 extern const Info<bool> MAIN_DSP_HLE;
@@ -69,6 +70,7 @@ extern const Info<AudioCommon::DPL2Quality> MAIN_DPL2_QUALITY;
 extern const Info<int> MAIN_AUDIO_LATENCY;
 extern const Info<bool> MAIN_AUDIO_STRETCH;
 extern const Info<int> MAIN_AUDIO_STRETCH_LATENCY;
+extern const Info<bool> MAIN_AUDIO_DRIFT_COMPENSATION;
 extern const Info<std::string> MAIN_MEMCARD_A_PATH;
 extern const Info<std::string> MAIN_MEMCARD_B_PATH;
 const Info<std::string>& GetInfoForMemcardPath(ExpansionInterface::Slot slot);
@@ -101,6 +103,8 @@ extern const Info<int> MAIN_SYNC_GPU_MAX_DISTANCE;
 extern const Info<int> MAIN_SYNC_GPU_MIN_DISTANCE;
 extern const Info<float> MAIN_SYNC_GPU_OVERCLOCK;
 extern const Info<bool> MAIN_FAST_DISC_SPEED;
+extern const Info<bool> MAIN_RECORD_DVD_ACCESS_TRACE;
+extern const Info<bool> MAIN_DVD_TRACE_PREFETCH;
 extern const Info<bool> MAIN_LOW_DCBZ_HACK;
 extern const Info<bool> MAIN_FLOAT_EXCEPTIONS;
 extern const Info<bool> MAIN_DIVIDE_BY_ZERO_EXCEPTIONS;
@@ -135,6 +139,16 @@ extern const Info<u32> MAIN_CUSTOM_RTC_VALUE;
 extern const Info<bool> MAIN_AUTO_DISC_CHANGE;
 extern const Info<bool> MAIN_ALLOW_SD_WRITES;
 extern const Info<bool> MAIN_ENABLE_SAVESTATES;
+// Number of in-memory states kept for rewinding (0 disables it), and how many frames apart.
+extern const Info<u32> MAIN_REWIND_SNAPSHOTS;
+extern const Info<u32> MAIN_REWIND_INTERVAL;
+// Whether trace markers are recorded from boot on, and how much HK_CAPTURE_TRACE writes out.
+extern const Info<bool> MAIN_TRACE_MARKERS;
+extern const Info<u32> MAIN_TRACE_CAPTURE_SECONDS;
+// Whether MemoryWatcher publishes to shared memory instead of its socket.
+extern const Info<bool> MAIN_MEMORY_WATCHER_SHARED_MEMORY;
+// Whether plain disc images on local fixed drives are read through a memory mapping.
+extern const Info<bool> MAIN_MAP_DISC_IMAGES;
 extern const Info<DiscIO::Region> MAIN_FALLBACK_REGION;
 extern const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS;
 extern const Info<s32> MAIN_OVERRIDE_BOOT_IOS;
@@ -147,6 +161,7 @@ extern const Info<bool> MAIN_DSP_CAPTURE_LOG;
 extern const Info<bool> MAIN_DSP_JIT;
 extern const Info<bool> MAIN_DUMP_AUDIO;
 extern const Info<bool> MAIN_DUMP_AUDIO_SILENT;
+extern const Info<bool> MAIN_LOG_MIXER_STATS;
 extern const Info<bool> MAIN_DUMP_UCODE;
 extern const Info<std::string> MAIN_AUDIO_BACKEND;
 extern const Info<int> MAIN_AUDIO_VOLUME;
@@ -180,6 +195,7 @@ extern const Info<std::string> MAIN_SD_PATH;
 extern const Info<std::string> MAIN_WFS_PATH;
 extern const Info<bool> MAIN_SHOW_LAG;
 extern const Info<bool> MAIN_SHOW_FRAME_COUNT;
+extern const Info<bool> MAIN_SHOW_AUDIO_STATS;
 extern const Info<std::string> MAIN_WIRELESS_MAC;
 extern const Info<std::string> MAIN_GDB_SOCKET;
 extern const Info<int> MAIN_GDB_PORT;
@@ -297,6 +313,11 @@ extern const Info<bool> MAIN_MOVIE_DUMP_FRAMES_SILENT;
 extern const Info<bool> MAIN_MOVIE_SHOW_INPUT_DISPLAY;
 extern const Info<bool> MAIN_MOVIE_SHOW_RTC;
 extern const Info<bool> MAIN_MOVIE_SHOW_RERECORD;
+// Frames between savestate keyframes stored while recording. 0 disables keyframes.
+extern const Info<u32> MAIN_MOVIE_KEYFRAME_INTERVAL;
+// Frames between hashes of guest RAM stored while recording, which playback checks against to
+// detect desyncs. Hashing stalls the CPU thread, so this is off (0) by default.
+extern const Info<u32> MAIN_MOVIE_RAM_HASH_INTERVAL;
 
 // Main.Input
 
@@ -64,6 +64,7 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_AUDIO_LATENCY.GetLocation(),
       &Config::MAIN_AUDIO_STRETCH.GetLocation(),
       &Config::MAIN_AUDIO_STRETCH_LATENCY.GetLocation(),
+      &Config::MAIN_AUDIO_DRIFT_COMPENSATION.GetLocation(),
       &Config::MAIN_OVERCLOCK.GetLocation(),
       &Config::MAIN_OVERCLOCK_ENABLE.GetLocation(),
       &Config::MAIN_RAM_OVERRIDE_ENABLE.GetLocation(),
@@ -71,6 +72,12 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_MEM2_SIZE.GetLocation(),
       &Config::MAIN_GFX_BACKEND.GetLocation(),
       &Config::MAIN_ENABLE_SAVESTATES.GetLocation(),
+      &Config::MAIN_REWIND_SNAPSHOTS.GetLocation(),
+      &Config::MAIN_REWIND_INTERVAL.GetLocation(),
+      &Config::MAIN_TRACE_MARKERS.GetLocation(),
+      &Config::MAIN_TRACE_CAPTURE_SECONDS.GetLocation(),
+      &Config::MAIN_MEMORY_WATCHER_SHARED_MEMORY.GetLocation(),
+      &Config::MAIN_MAP_DISC_IMAGES.GetLocation(),
       &Config::MAIN_FALLBACK_REGION.GetLocation(),
       &Config::MAIN_REAL_WII_REMOTE_REPEAT_REPORTS.GetLocation(),
       &Config::MAIN_DSP_HLE.GetLocation(),
@@ -86,6 +93,7 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_CUSTOM_RTC_ENABLE.GetLocation(),
       &Config::MAIN_CUSTOM_RTC_VALUE.GetLocation(),
       &Config::MAIN_JIT_FOLLOW_BRANCH.GetLocation(),
+      &Config::MAIN_JIT_PRECOMPILE_BLOCKS.GetLocation(),
       &Config::MAIN_FLOAT_EXCEPTIONS.GetLocation(),
       &Config::MAIN_DIVIDE_BY_ZERO_EXCEPTIONS.GetLocation(),
       &Config::MAIN_LOW_DCBZ_HACK.GetLocation(),
@@ -104,6 +112,8 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_GPU_DETERMINISM_MODE.GetLocation(),
       &Config::MAIN_DISABLE_ICACHE.GetLocation(),
       &Config::MAIN_FAST_DISC_SPEED.GetLocation(),
+      &Config::MAIN_RECORD_DVD_ACCESS_TRACE.GetLocation(),
+      &Config::MAIN_DVD_TRACE_PREFETCH.GetLocation(),
       &Config::MAIN_SYNC_ON_SKIP_IDLE.GetLocation(),
       &Config::MAIN_FASTMEM.GetLocation(),
       &Config::MAIN_TIMING_VARIANCE.GetLocation(),
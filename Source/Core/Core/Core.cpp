@@ -36,6 +36,7 @@
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/Trace.h"
 #include "Common/Version.h"
 
 #include "Core/Boot/Boot.h"
@@ -55,6 +56,7 @@
 #include "Core/HW/GCKeyboard.h"
 #include "Core/HW/GCPad.h"
 #include "Core/HW/HW.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/HW/Wiimote.h"
@@ -68,6 +70,7 @@
 #include "Core/PowerPC/GDBStub.h"
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/SamplingProfiler.h"
 #include "Core/State.h"
 #include "Core/System.h"
 #include "Core/WiiRoot.h"
@@ -206,6 +209,8 @@ void FrameUpdateOnCPUThread()
 // anything that needs to read or write to memory should be getting run from here
 void RunRioFunctions()
 {
+  TRACE_SCOPE("Core::RunRioFunctions");
+
   if (s_stat_tracker)
   {
     s_stat_tracker->Run();
@@ -244,6 +249,9 @@ void RunRioFunctions()
 
 void OnFrameEnd()
 {
+  ::State::OnFrameEnd();
+  SamplingProfiler::ResolveSamples();
+
 #ifdef USE_MEMORYWATCHER
   if (s_memory_watcher)
     s_memory_watcher->Step();
@@ -409,12 +417,17 @@ void TrainingMode()
     int baseOffset= 0x268 * PowerPC::HostRead_U8(0x80892801);  // used to get offsed for baseFielderAddr
     u32 baseFielderAddr = 0x8088F368 + baseOffset;        // 0x0 == x; 0x8 == y; 0xc == z
 
-    float FielderPos_X = roundf(u32ToFloat(PowerPC::HostRead_U32(baseFielderAddr)) * 100) / 100;
-    float FielderPos_Y = roundf(u32ToFloat(PowerPC::HostRead_U32(baseFielderAddr + 0xc)) * 100) / 100;
-    float FielderPos_Z = roundf(u32ToFloat(PowerPC::HostRead_U32(baseFielderAddr + 0x8)) * 100) / 100;
-    float FielderVel_X = roundf(u32ToFloat(PowerPC::HostRead_U32(baseFielderAddr + 0x30)) * 6000) / 100;
+    // One translated view over the fielder's position and velocity fields
+    const auto fielder = PowerPC::HostGetRAMRange(baseFielderAddr, 0x38);
+    const auto fielderField = [&fielder](u32 offset) {
+      return fielder ? fielder->Read<float>(offset) : 0.0f;
+    };
+    float FielderPos_X = roundf(fielderField(0x0) * 100) / 100;
+    float FielderPos_Y = roundf(fielderField(0xc) * 100) / 100;
+    float FielderPos_Z = roundf(fielderField(0x8) * 100) / 100;
+    float FielderVel_X = roundf(fielderField(0x30) * 6000) / 100;
     //float FielderVel_Y = roundf(u32ToFloat(PowerPC::HostRead_U32(baseFielderAddr + 0x15C)) * 6000) / 100; // this addr is wrong
-    float FielderVel_Z = roundf(u32ToFloat(PowerPC::HostRead_U32(baseFielderAddr + 0x34)) * 6000) / 100;
+    float FielderVel_Z = roundf(fielderField(0x34) * 6000) / 100;
     float FielderVel_Net = roundf(vectorMagnitude(FielderVel_X, 0 /*FielderVel_Y*/, FielderVel_Z) * 100) / 100;
 
     OSD::AddTypedMessage(OSD::MessageType::TrainingModeBallCoordinates, fmt::format(
@@ -836,8 +849,10 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
   static_cast<void>(IDCache::GetEnvForThread());
 #endif
 
-  const bool fastmem_enabled = Config::Get(Config::MAIN_FASTMEM);
-  if (fastmem_enabled)
+  // The rewind ring relies on the handler as well, to find out which pages of memory were written.
+  const bool exception_handler_enabled =
+      Config::Get(Config::MAIN_FASTMEM) || Config::Get(Config::MAIN_REWIND_SNAPSHOTS) != 0;
+  if (exception_handler_enabled)
     EMM::InstallExceptionHandler();  // Let's run under memory watch
 
 #ifdef USE_MEMORYWATCHER
@@ -885,14 +900,21 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
   // Enter CPU run loop. When we leave it - we are done.
   CPU::Run();
 
+  // The profiler signals this thread, so it has to be stopped before the thread goes away.
+  SamplingProfiler::Stop();
+
 #ifdef USE_MEMORYWATCHER
   s_memory_watcher.reset();
 #endif
 
   s_is_started = false;
 
-  if (fastmem_enabled)
+  if (exception_handler_enabled)
+  {
+    // Nothing would be left to make write-protected memory writable again
+    Memory::StopDirtyPageTracking();
     EMM::UninstallExceptionHandler();
+  }
 
   if (GDBStub::IsActive())
   {
@@ -921,6 +943,9 @@ static void FifoPlayerThread(const std::optional<std::string>& savestate_path,
     CPUSetInitialExecutionState();
     CPU::Run();
 
+    // As in CpuThread, stop the profiler while this thread can still be signalled
+    SamplingProfiler::Stop();
+
     s_is_started = false;
     PowerPC::InjectExternalCPUCore(nullptr);
     FifoPlayer::GetInstance().Close();
@@ -955,6 +980,9 @@ static void EmuThread(std::unique_ptr<BootParameters> boot, WindowSystemInfo wsi
 
   Common::SetCurrentThreadName("Emuthread - Starting");
 
+  if (Config::Get(Config::MAIN_TRACE_MARKERS))
+    Common::Trace::SetEnabled(true);
+
   DeclareAsGPUThread();
 
   // For a time this acts as the CPU thread...
@@ -1280,6 +1308,33 @@ void SaveScreenShot(std::string_view name)
   });
 }
 
+void CaptureTrace()
+{
+  if (!Common::Trace::IsEnabled())
+  {
+    Common::Trace::SetEnabled(true);
+    DisplayMessage("Recording trace markers", 2000);
+    return;
+  }
+
+  const std::string dir = File::GetUserPath(D_DUMP_IDX) + "Traces" DIR_SEP;
+  if (!File::CreateFullPath(dir))
+  {
+    DisplayMessage("Failed to create the trace directory", 4000);
+    return;
+  }
+
+  const u32 seconds = Config::Get(Config::MAIN_TRACE_CAPTURE_SECONDS);
+  const std::string path =
+      fmt::format("{}{}_{:%Y-%m-%d_%H-%M-%S}.json", dir, SConfig::GetInstance().GetGameID(),
+                  fmt::localtime(std::time(nullptr)));
+  if (Common::Trace::WriteChromeTrace(path, seconds * u64(1000000)))
+    DisplayMessage(fmt::format("Wrote the last {} seconds of trace markers to {}", seconds, path),
+                   4000);
+  else
+    DisplayMessage(fmt::format("Failed to write {}", path), 4000);
+}
+
 static bool PauseAndLock(bool do_lock, bool unpause_on_unlock)
 {
   // WARNING: PauseAndLock is not fully threadsafe so is only valid on the Host Thread
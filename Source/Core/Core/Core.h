@@ -125,6 +125,9 @@ void SetState(State state);
 State GetState();
 
 void SaveScreenShot();
+// Starts recording trace markers, or if they are being recorded already, writes the last
+// MAIN_TRACE_CAPTURE_SECONDS of them to the dump directory.
+void CaptureTrace();
 void SaveScreenShot(std::string_view name);
 
 // This displays messages in a user-visible way.
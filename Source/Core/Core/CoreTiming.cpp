@@ -4,8 +4,9 @@
 #include "Core/CoreTiming.h"
 
 #include <algorithm>
-#include <mutex>
+#include <limits>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
@@ -14,7 +15,8 @@
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/Logging/Log.h"
-#include "Common/SPSCQueue.h"
+#include "Common/MPSCQueue.h"
+#include "Common/Trace.h"
 
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
@@ -25,10 +27,14 @@
 
 namespace CoreTiming
 {
+constexpr u32 NO_SLOT = std::numeric_limits<u32>::max();
+
 struct EventType
 {
   TimedCallback callback;
   const std::string* name;
+  // Head of the list of this type's pending events in s_event_queue
+  u32 first_pending = NO_SLOT;
 };
 
 struct Event
@@ -40,28 +46,185 @@ struct Event
 };
 
 // Sort by time, unless the times are the same, in which case sort by the order added to the queue
-static bool operator>(const Event& left, const Event& right)
-{
-  return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
-}
 static bool operator<(const Event& left, const Event& right)
 {
   return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
 }
 
+namespace
+{
+// A binary min-heap of events, ordered by time and then by the order they were scheduled in.
+//
+// The heap only holds the sort key and the index of a slot containing the event. Each slot knows
+// where its entry is in the heap and is linked to the other pending events of the same type, so
+// RemoveEvent only touches the events it removes instead of filtering and re-heapifying the
+// whole queue. Since (time, fifo_order) is unique, events come out in the same order as with any
+// other correct priority queue.
+class EventQueue
+{
+public:
+  bool Empty() const { return m_heap.empty(); }
+  const Event& Front() const { return m_slots[m_heap.front().slot].event; }
+
+  void Push(const Event& event)
+  {
+    u32 slot;
+    if (m_free_slots.empty())
+    {
+      slot = static_cast<u32>(m_slots.size());
+      m_slots.emplace_back();
+    }
+    else
+    {
+      slot = m_free_slots.back();
+      m_free_slots.pop_back();
+    }
+
+    u32& first_pending = event.type->first_pending;
+    m_slots[slot] = Slot{event, static_cast<u32>(m_heap.size()), NO_SLOT, first_pending};
+    if (first_pending != NO_SLOT)
+      m_slots[first_pending].prev_of_type = slot;
+    first_pending = slot;
+
+    m_heap.push_back(HeapEntry{event.time, event.fifo_order, slot});
+    SiftUp(m_heap.size() - 1);
+  }
+
+  Event Pop()
+  {
+    Event event = Front();
+    RemoveAt(0);
+    return event;
+  }
+
+  void RemoveAll(EventType* type)
+  {
+    while (type->first_pending != NO_SLOT)
+      RemoveAt(m_slots[type->first_pending].heap_index);
+  }
+
+  void Clear()
+  {
+    for (const HeapEntry& entry : m_heap)
+      m_slots[entry.slot].event.type->first_pending = NO_SLOT;
+    m_heap.clear();
+    m_slots.clear();
+    m_free_slots.clear();
+  }
+
+  // In heap order, which is meaningless.
+  std::vector<Event> GetEvents() const
+  {
+    std::vector<Event> events;
+    events.reserve(m_heap.size());
+    for (const HeapEntry& entry : m_heap)
+      events.push_back(m_slots[entry.slot].event);
+    return events;
+  }
+
+  void SetEvents(const std::vector<Event>& events)
+  {
+    Clear();
+    for (const Event& event : events)
+      Push(event);
+  }
+
+private:
+  struct HeapEntry
+  {
+    s64 time;
+    u64 fifo_order;
+    u32 slot;
+  };
+
+  struct Slot
+  {
+    Event event;
+    u32 heap_index;
+    u32 prev_of_type;
+    u32 next_of_type;
+  };
+
+  static bool IsEarlier(const HeapEntry& left, const HeapEntry& right)
+  {
+    return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
+  }
+
+  void Place(size_t index, const HeapEntry& entry)
+  {
+    m_heap[index] = entry;
+    m_slots[entry.slot].heap_index = static_cast<u32>(index);
+  }
+
+  void SiftUp(size_t index)
+  {
+    const HeapEntry entry = m_heap[index];
+    while (index > 0)
+    {
+      const size_t parent = (index - 1) / 2;
+      if (!IsEarlier(entry, m_heap[parent]))
+        break;
+      Place(index, m_heap[parent]);
+      index = parent;
+    }
+    Place(index, entry);
+  }
+
+  void SiftDown(size_t index)
+  {
+    const HeapEntry entry = m_heap[index];
+    while (true)
+    {
+      size_t child = index * 2 + 1;
+      if (child >= m_heap.size())
+        break;
+      if (child + 1 < m_heap.size() && IsEarlier(m_heap[child + 1], m_heap[child]))
+        ++child;
+      if (!IsEarlier(m_heap[child], entry))
+        break;
+      Place(index, m_heap[child]);
+      index = child;
+    }
+    Place(index, entry);
+  }
+
+  void RemoveAt(size_t index)
+  {
+    const u32 slot = m_heap[index].slot;
+    Slot& removed = m_slots[slot];
+    if (removed.prev_of_type != NO_SLOT)
+      m_slots[removed.prev_of_type].next_of_type = removed.next_of_type;
+    else
+      removed.event.type->first_pending = removed.next_of_type;
+    if (removed.next_of_type != NO_SLOT)
+      m_slots[removed.next_of_type].prev_of_type = removed.prev_of_type;
+    m_free_slots.push_back(slot);
+
+    const HeapEntry last = m_heap.back();
+    m_heap.pop_back();
+    if (index == m_heap.size())
+      return;
+
+    Place(index, last);
+    SiftDown(index);
+    SiftUp(m_slots[last.slot].heap_index);
+  }
+
+  std::vector<HeapEntry> m_heap;
+  std::vector<Slot> m_slots;
+  std::vector<u32> m_free_slots;
+};
+}  // namespace
+
 // unordered_map stores each element separately as a linked list node so pointers to elements
 // remain stable regardless of rehashes/resizing.
 static std::unordered_map<std::string, EventType> s_event_types;
 
 // STATE_TO_SAVE
-// The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-// We don't use std::priority_queue because we need to be able to serialize, unserialize and
-// erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accomodated
-// by the standard adaptor class.
-static std::vector<Event> s_event_queue;
+static EventQueue s_event_queue;
 static u64 s_event_fifo_id;
-static std::mutex s_ts_write_lock;
-static Common::SPSCQueue<Event, false> s_ts_queue;
+// Events scheduled from other threads, moved into s_event_queue by the CPU thread.
+static Common::MPSCQueue<Event> s_ts_queue;
 
 static float s_last_OC_factor;
 static constexpr int MAX_SLICE_LENGTH = 20000;
@@ -120,7 +283,7 @@ EventType* RegisterEvent(const std::string& name, TimedCallback callback)
 
 void UnregisterAllEvents()
 {
-  ASSERT_MSG(POWERPC, s_event_queue.empty(), "Cannot unregister events with events pending");
+  ASSERT_MSG(POWERPC, s_event_queue.Empty(), "Cannot unregister events with events pending");
   s_event_types.clear();
 }
 
@@ -149,7 +312,6 @@ void Init()
 
 void Shutdown()
 {
-  std::lock_guard lk(s_ts_write_lock);
   MoveEvents();
   ClearPendingEvents();
   UnregisterAllEvents();
@@ -166,7 +328,6 @@ void RefreshConfig()
 
 void DoState(PointerWrap& p)
 {
-  std::lock_guard lk(s_ts_write_lock);
   p.Do(g.slice_length);
   p.Do(g.global_timer);
   p.Do(s_idled_cycles);
@@ -181,7 +342,8 @@ void DoState(PointerWrap& p)
   p.DoMarker("CoreTimingData");
 
   MoveEvents();
-  p.DoEachElement(s_event_queue, [](PointerWrap& pw, Event& ev) {
+  std::vector<Event> events = s_event_queue.GetEvents();
+  p.DoEachElement(events, [](PointerWrap& pw, Event& ev) {
     pw.Do(ev.time);
     pw.Do(ev.fifo_order);
 
@@ -218,7 +380,7 @@ void DoState(PointerWrap& p)
   // The exact layout of the heap in memory is implementation defined, therefore it is platform
   // and library version specific.
   if (p.IsReadMode())
-    std::make_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    s_event_queue.SetEvents(events);
 }
 
 // This should only be called from the CPU thread. If you are calling
@@ -241,7 +403,7 @@ u64 GetIdleTicks()
 
 void ClearPendingEvents()
 {
-  s_event_queue.clear();
+  s_event_queue.Clear();
 }
 
 void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata, FromThread from)
@@ -269,8 +431,7 @@ void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
     if (!s_is_global_timer_sane)
       ForceExceptionCheck(cycles_into_future);
 
-    s_event_queue.emplace_back(Event{timeout, s_event_fifo_id++, userdata, event_type});
-    std::push_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
+    s_event_queue.Push(Event{timeout, s_event_fifo_id++, userdata, event_type});
   }
   else
   {
@@ -282,22 +443,13 @@ void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
                     *event_type->name);
     }
 
-    std::lock_guard lk(s_ts_write_lock);
     s_ts_queue.Push(Event{g.global_timer + cycles_into_future, 0, userdata, event_type});
   }
 }
 
 void RemoveEvent(EventType* event_type)
 {
-  auto itr = std::remove_if(s_event_queue.begin(), s_event_queue.end(),
-                            [&](const Event& e) { return e.type == event_type; });
-
-  // Removing random items breaks the invariant so we have to re-establish it.
-  if (itr != s_event_queue.end())
-  {
-    s_event_queue.erase(itr, s_event_queue.end());
-    std::make_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
-  }
+  s_event_queue.RemoveAll(event_type);
 }
 
 void RemoveAllEvents(EventType* event_type)
@@ -320,16 +472,16 @@ void ForceExceptionCheck(s64 cycles)
 
 void MoveEvents()
 {
-  for (Event ev; s_ts_queue.Pop(ev);)
-  {
+  s_ts_queue.PopAll([](Event&& ev) {
     ev.fifo_order = s_event_fifo_id++;
-    s_event_queue.emplace_back(std::move(ev));
-    std::push_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
-  }
+    s_event_queue.Push(ev);
+  });
 }
 
 void Advance()
 {
+  TRACE_SCOPE("CoreTiming::Advance");
+
   MoveEvents();
 
   int cyclesExecuted = g.slice_length - DowncountToCycles(PowerPC::ppcState.downcount);
@@ -340,21 +492,19 @@ void Advance()
 
   s_is_global_timer_sane = true;
 
-  while (!s_event_queue.empty() && s_event_queue.front().time <= g.global_timer)
+  while (!s_event_queue.Empty() && s_event_queue.Front().time <= g.global_timer)
   {
-    Event evt = std::move(s_event_queue.front());
-    std::pop_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
-    s_event_queue.pop_back();
+    const Event evt = s_event_queue.Pop();
     evt.type->callback(evt.userdata, g.global_timer - evt.time);
   }
 
   s_is_global_timer_sane = false;
 
   // Still events left (scheduled in the future)
-  if (!s_event_queue.empty())
+  if (!s_event_queue.Empty())
   {
     g.slice_length = static_cast<int>(
-        std::min<s64>(s_event_queue.front().time - g.global_timer, MAX_SLICE_LENGTH));
+        std::min<s64>(s_event_queue.Front().time - g.global_timer, MAX_SLICE_LENGTH));
   }
 
   PowerPC::ppcState.downcount = CyclesToDowncount(g.slice_length);
@@ -368,7 +518,7 @@ void Advance()
 
 void LogPendingEvents()
 {
-  auto clone = s_event_queue;
+  auto clone = s_event_queue.GetEvents();
   std::sort(clone.begin(), clone.end());
   for (const Event& ev : clone)
   {
@@ -380,11 +530,13 @@ void LogPendingEvents()
 // Should only be called from the CPU thread after the PPC clock has changed
 void AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clock)
 {
-  for (Event& ev : s_event_queue)
+  std::vector<Event> events = s_event_queue.GetEvents();
+  for (Event& ev : events)
   {
     const s64 ticks = (ev.time - g.global_timer) * new_ppc_clock / old_ppc_clock;
     ev.time = g.global_timer + ticks;
   }
+  s_event_queue.SetEvents(events);
 }
 
 void Idle()
@@ -407,7 +559,7 @@ std::string GetScheduledEventsSummary()
   std::string text = "Scheduled events\n";
   text.reserve(1000);
 
-  auto clone = s_event_queue;
+  auto clone = s_event_queue.GetEvents();
   std::sort(clone.begin(), clone.end());
   for (const Event& ev : clone)
   {
@@ -257,12 +257,14 @@ void DefaultGeckoCodes::WriteAsm(DefaultGeckoCode CodeBlock)
 
   branchToCode += branchAmount;
 
-  // write asm to free memory
-  for (int i = 0; i < CodeBlock.codeLines.size(); i++)
+  // write asm to free memory; the whole block at once when it lands in contiguous RAM
+  const u32 numLines = static_cast<u32>(CodeBlock.codeLines.size());
+  if (!PowerPC::HostTryWriteArray(CodeBlock.codeLines.data(), aWriteAddr, numLines))
   {
-    PowerPC::HostWrite_U32(CodeBlock.codeLines[i], aWriteAddr);
-    aWriteAddr += 4;
+    for (u32 i = 0; i < numLines; i++)
+      PowerPC::HostWrite_U32(CodeBlock.codeLines[i], aWriteAddr + i * 4);
   }
+  aWriteAddr += numLines * 4;
 
   // write branches
   u32 branchFromCode = 0x48000000;
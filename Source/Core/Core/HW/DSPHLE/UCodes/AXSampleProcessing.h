@@ -0,0 +1,166 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// The sample processing done for every AX voice, which doesn't depend on the AX version or on
+// emulated hardware.
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include "Common/CommonTypes.h"
+#include "Common/MathUtil.h"
+#include "Core/HW/DSPHLE/UCodes/AXStructs.h"
+
+namespace DSP::HLE
+{
+// Returns how many input samples ResampleAudio consumes to produce <count> samples. See below
+// for <curr_pos> and <ratio>.
+inline u32 GetResampleInputCount(u32 count, u32 curr_pos, u32 ratio, int srctype)
+{
+  if (srctype != SRCTYPE_LINEAR && srctype != SRCTYPE_POLYPHASE)
+    return count;
+
+  // Every time the position passes a whole sample, one more input sample is consumed.
+  return static_cast<u32>((curr_pos + u64(count) * ratio) >> 16);
+}
+
+// Resamples input samples to <count> samples at the wanted sample rate (computed from the ratio,
+// see below). <input> holds the four <last_samples> followed by as many input samples as
+// GetResampleInputCount returns.
+//
+// If srctype is SRCTYPE_POLYPHASE, coefficients need to be provided as well
+// (or the srctype will automatically be changed to LINEAR).
+//
+// Returns the current position after resampling (including fractional part).
+//
+// The input to output ratio is set in <ratio>, which is a floating point num
+// stored as a 32b integer:
+//  * Upper 16 bits of the ratio are the integer part
+//  * Lower 16 bits are the decimal part
+//
+// <curr_pos> is a 32b integer structured in the same way as the ratio: the
+// upper 16 bits are the integer part of the current position in the input
+// stream, and the lower 16 bits are the decimal part.
+//
+// We start getting samples not from sample 0, but 0.<curr_pos_frac>. This
+// avoids discontinuities in the audio stream, especially with very low ratios
+// which interpolate a lot of values between two "real" samples.
+//
+// The position of every output sample only depends on its index, so the loops below have no
+// dependencies between iterations and can be vectorized by the compiler.
+inline u32 ResampleAudio(const s16* input, s16* output, u32 count, s16* last_samples,
+                         u32 curr_pos, u32 ratio, int srctype, const s16* coeffs)
+{
+  if (count == 0)
+    return curr_pos;
+
+  const bool resample = srctype == SRCTYPE_LINEAR || srctype == SRCTYPE_POLYPHASE;
+  const u64 end_pos = curr_pos + u64(count) * ratio;
+
+  // If DSP DROM coefficients are available, support polyphase resampling.
+  if (coeffs && srctype == SRCTYPE_POLYPHASE)
+  {
+    for (u32 i = 0; i < count; ++i)
+    {
+      // The four samples used are the last four consumed, oldest first.
+      const u64 pos = curr_pos + u64(i + 1) * ratio;
+      const s16* t = &input[pos >> 16];
+
+      u16 curr_pos_frac = ((pos & 0xFFFF) >> 9) << 2;
+      const s16* c = &coeffs[curr_pos_frac];
+
+      s64 samp = (s64(t[0]) * c[0] + s64(t[1]) * c[1] + s64(t[2]) * c[2] + s64(t[3]) * c[3]) >> 15;
+
+      output[i] = MathUtil::SaturatingCast<s16>(samp);
+    }
+  }
+  else if (resample)
+  {
+    for (u32 i = 0; i < count; ++i)
+    {
+      const u64 pos = curr_pos + u64(i + 1) * ratio;
+      const s16* t = &input[pos >> 16];
+
+      // Get our current fractional position, used to know how much of
+      // curr0 and how much of curr1 the output sample should be.
+      u16 curr_frac = pos & 0xFFFF;
+      u16 inv_curr_frac = -curr_frac;
+
+      // Interpolate! If curr_frac is 0, we can simply take the oldest
+      // sample without any multiplying.
+      const s32 s0 = t[0];
+      const s32 s1 = t[1];
+      output[i] = curr_frac ? s16(((s0 * inv_curr_frac) + (s1 * curr_frac)) >> 16) : s16(s0);
+    }
+  }
+  else  // SRCTYPE_NEAREST
+  {
+    // No sample rate conversion here: simply copy the input samples to the
+    // output buffer.
+    std::copy_n(input + 4, count, output);
+    memcpy(last_samples, output + count - 4, 4 * sizeof(u16));
+    return curr_pos;
+  }
+
+  // Update the four last_samples values.
+  memcpy(last_samples, input + (end_pos >> 16), 4 * sizeof(u16));
+
+  return static_cast<u32>(end_pos & 0xFFFF);
+}
+
+// Add samples to an output buffer, with optional volume ramping.
+inline void MixAdd(int* out, const s16* input, u32 count, VolumeData* vd, s16* dpop, bool ramp)
+{
+  if (count == 0)
+    return;
+
+  const u16 volume = vd->volume;
+  u16 volume_delta = vd->volume_delta;
+
+  // If volume ramping is disabled, set volume_delta to 0. That way, the
+  // mixing loop can avoid testing if volume ramping is enabled at each step,
+  // and just add volume_delta.
+  if (!ramp)
+    volume_delta = 0;
+
+  // The volume for each sample is computed from its index rather than accumulated, so that the
+  // loop vectorizes. s16 * u16 always fits into an s32.
+  for (u32 i = 0; i < count; ++i)
+  {
+    const u16 sample_volume = static_cast<u16>(volume + i * volume_delta);
+    s32 sample = (s32(input[i]) * sample_volume) >> 15;
+    sample = std::clamp(sample, -32767, 32767);  // -32768 ?
+
+    out[i] += (s16)sample;
+  }
+
+  const u16 last_volume = static_cast<u16>(volume + (count - 1) * volume_delta);
+  *dpop = static_cast<s16>(std::clamp((s32(input[count - 1]) * last_volume) >> 15, -32767, 32767));
+  vd->volume = static_cast<u16>(volume + count * volume_delta);
+}
+
+// Execute a low pass filter on the samples using one history value. Returns
+// the new history value.
+inline s16 LowPassFilter(s16* samples, u32 count, s16 yn1, u16 a0, u16 b0)
+{
+  for (u32 i = 0; i < count; ++i)
+    yn1 = samples[i] = (a0 * (s32)samples[i] + b0 * (s32)yn1) >> 15;
+  return yn1;
+}
+
+// Applies a volume ramp starting at <volume> and changing by <volume_delta> every sample, and
+// returns the volume after the last sample. Like in MixAdd, each sample's volume is computed from
+// its index so that the loop vectorizes.
+inline u16 ApplyVolumeEnvelope(s16* samples, u32 count, u16 volume, u16 volume_delta)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    const u16 sample_volume = static_cast<u16>(volume + i * volume_delta);
+    const s32 sample = ((s32)samples[i] * sample_volume) >> 15;
+    samples[i] = std::clamp(sample, -32767, 32767);  // -32768 ?
+  }
+  return static_cast<u16>(volume + count * volume_delta);
+}
+}  // namespace DSP::HLE
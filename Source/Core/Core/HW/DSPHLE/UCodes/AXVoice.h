@@ -12,14 +12,15 @@
 #endif
 
 #include <algorithm>
-#include <functional>
 #include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Core/DSP/DSPAccelerator.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/UCodes/AX.h"
+#include "Core/HW/DSPHLE/UCodes/AXSampleProcessing.h"
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
 #include "Core/HW/Memmap.h"
 
@@ -207,136 +208,17 @@ u16 AcceleratorGetSample()
   return s_accelerator->Read(acc_pb->adpcm.coefs);
 }
 
-// Reads samples from the input callback, resamples them to <count> samples at
-// the wanted sample rate (computed from the ratio, see below).
-//
-// If srctype is SRCTYPE_POLYPHASE, coefficients need to be provided as well
-// (or the srctype will automatically be changed to LINEAR).
-//
-// Returns the current position after resampling (including fractional part).
-//
-// The input to output ratio is set in <ratio>, which is a floating point num
-// stored as a 32b integer:
-//  * Upper 16 bits of the ratio are the integer part
-//  * Lower 16 bits are the decimal part
-//
-// <curr_pos> is a 32b integer structured in the same way as the ratio: the
-// upper 16 bits are the integer part of the current position in the input
-// stream, and the lower 16 bits are the decimal part.
-//
-// We start getting samples not from sample 0, but 0.<curr_pos_frac>. This
-// avoids discontinuities in the audio stream, especially with very low ratios
-// which interpolate a lot of values between two "real" samples.
-u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count, s16* last_samples,
-                  u32 curr_pos, u32 ratio, int srctype, const s16* coeffs)
-{
-  int read_samples_count = 0;
-
-  // If DSP DROM coefficients are available, support polyphase resampling.
-  if (coeffs && srctype == SRCTYPE_POLYPHASE)
-  {
-    s16 temp[4];
-    u32 idx = 0;
-
-    temp[idx++ & 3] = last_samples[0];
-    temp[idx++ & 3] = last_samples[1];
-    temp[idx++ & 3] = last_samples[2];
-    temp[idx++ & 3] = last_samples[3];
-
-    for (u32 i = 0; i < count; ++i)
-    {
-      curr_pos += ratio;
-      while (curr_pos >= 0x10000)
-      {
-        temp[idx++ & 3] = input_callback(read_samples_count++);
-        curr_pos -= 0x10000;
-      }
-
-      u16 curr_pos_frac = ((curr_pos & 0xFFFF) >> 9) << 2;
-      const s16* c = &coeffs[curr_pos_frac];
-
-      s64 t0 = temp[idx++ & 3];
-      s64 t1 = temp[idx++ & 3];
-      s64 t2 = temp[idx++ & 3];
-      s64 t3 = temp[idx++ & 3];
-
-      s64 samp = (t0 * c[0] + t1 * c[1] + t2 * c[2] + t3 * c[3]) >> 15;
-
-      output[i] = MathUtil::SaturatingCast<s16>(samp);
-    }
-
-    last_samples[3] = temp[--idx & 3];
-    last_samples[2] = temp[--idx & 3];
-    last_samples[1] = temp[--idx & 3];
-    last_samples[0] = temp[--idx & 3];
-  }
-  else if (srctype == SRCTYPE_LINEAR || srctype == SRCTYPE_POLYPHASE)
-  {
-    // This is the circular buffer containing samples to use for the
-    // interpolation. It is initialized with the values from the PB, and it
-    // will be stored back to the PB at the end.
-    s16 temp[4];
-    u32 idx = 0;
-
-    temp[idx++ & 3] = last_samples[0];
-    temp[idx++ & 3] = last_samples[1];
-    temp[idx++ & 3] = last_samples[2];
-    temp[idx++ & 3] = last_samples[3];
-
-    for (u32 i = 0; i < count; ++i)
-    {
-      curr_pos += ratio;
-
-      // While our current position is >= 1.0, push new samples to the
-      // circular buffer.
-      while (curr_pos >= 0x10000)
-      {
-        temp[idx++ & 3] = input_callback(read_samples_count++);
-        curr_pos -= 0x10000;
-      }
-
-      // Get our current fractional position, used to know how much of
-      // curr0 and how much of curr1 the output sample should be.
-      u16 curr_frac = curr_pos & 0xFFFF;
-      u16 inv_curr_frac = -curr_frac;
-
-      // Interpolate! If curr_frac is 0, we can simply take the last
-      // sample without any multiplying.
-      s16 sample;
-      if (curr_frac)
-      {
-        s32 s0 = temp[idx++ & 3];
-        s32 s1 = temp[idx++ & 3];
-
-        sample = ((s0 * inv_curr_frac) + (s1 * curr_frac)) >> 16;
-        idx += 2;
-      }
-      else
-      {
-        sample = temp[idx++ & 3];
-        idx += 3;
-      }
-
-      output[i] = sample;
-    }
-
-    // Update the four last_samples values.
-    last_samples[3] = temp[--idx & 3];
-    last_samples[2] = temp[--idx & 3];
-    last_samples[1] = temp[--idx & 3];
-    last_samples[0] = temp[--idx & 3];
-  }
-  else  // SRCTYPE_NEAREST
-  {
-    // No sample rate conversion here: simply read samples from the
-    // accelerator to the output buffer.
-    for (u32 i = 0; i < count; ++i)
-      output[i] = input_callback(i);
+// Scratch space for decoded input samples, which may be more than a frame's worth when the
+// resampling ratio is high.
+std::vector<s16> s_input_samples;
 
-    memcpy(last_samples, output + count - 4, 4 * sizeof(u16));
-  }
-
-  return curr_pos;
+// Returns a buffer with the four <last_samples> followed by room for <count> input samples.
+s16* PrepareInputSamples(const s16* last_samples, u32 count)
+{
+  if (s_input_samples.size() < count + 4)
+    s_input_samples.resize(count + 4);
+  std::copy_n(last_samples, 4, s_input_samples.begin());
+  return s_input_samples.data();
 }
 
 // Read <count> input samples from ARAM, decoding and converting rate
@@ -347,9 +229,16 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
 
   if (coeffs)
     coeffs += pb.coef_select * 0x200;
-  u32 curr_pos =
-      ResampleAudio([](u32) { return AcceleratorGetSample(); }, samples, count, pb.src.last_samples,
-                    pb.src.cur_addr_frac, HILO_TO_32(pb.src.ratio), pb.src_type, coeffs);
+
+  // Decode everything the resampler needs in one go, then resample from the contiguous buffer.
+  const u32 ratio = HILO_TO_32(pb.src.ratio);
+  const u32 input_count = GetResampleInputCount(count, pb.src.cur_addr_frac, ratio, pb.src_type);
+  s16* input = PrepareInputSamples(pb.src.last_samples, input_count);
+  for (u32 i = 0; i < input_count; ++i)
+    input[i + 4] = AcceleratorGetSample();
+
+  u32 curr_pos = ResampleAudio(input, samples, count, pb.src.last_samples, pb.src.cur_addr_frac,
+                               ratio, pb.src_type, coeffs);
   pb.src.cur_addr_frac = (curr_pos & 0xFFFF);
 
   // Update current position, YN1, YN2 and pred scale in the PB.
@@ -360,41 +249,6 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
   pb.adpcm.pred_scale = s_accelerator->GetPredScale();
 }
 
-// Add samples to an output buffer, with optional volume ramping.
-void MixAdd(int* out, const s16* input, u32 count, VolumeData* vd, s16* dpop, bool ramp)
-{
-  u16& volume = vd->volume;
-  u16 volume_delta = vd->volume_delta;
-
-  // If volume ramping is disabled, set volume_delta to 0. That way, the
-  // mixing loop can avoid testing if volume ramping is enabled at each step,
-  // and just add volume_delta.
-  if (!ramp)
-    volume_delta = 0;
-
-  for (u32 i = 0; i < count; ++i)
-  {
-    s64 sample = input[i];
-    sample *= volume;
-    sample >>= 15;
-    sample = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
-
-    out[i] += (s16)sample;
-    volume += volume_delta;
-
-    *dpop = (s16)sample;
-  }
-}
-
-// Execute a low pass filter on the samples using one history value. Returns
-// the new history value.
-s16 LowPassFilter(s16* samples, u32 count, s16 yn1, u16 a0, u16 b0)
-{
-  for (u32 i = 0; i < count; ++i)
-    yn1 = samples[i] = (a0 * (s32)samples[i] + b0 * (s32)yn1) >> 15;
-  return yn1;
-}
-
 // Process 1ms of audio (for AX GC) or 3ms of audio (for AX Wii) from a PB and
 // mix it to the output buffers.
 void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl mctrl,
@@ -409,12 +263,8 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
   GetInputSamples(pb, samples, count, coeffs);
 
   // Apply a global volume ramp using the volume envelope parameters.
-  for (u32 i = 0; i < count; ++i)
-  {
-    const s32 sample = ((s32)samples[i] * pb.vol_env.cur_volume) >> 15;
-    samples[i] = std::clamp(sample, -32767, 32767);  // -32768 ?
-    pb.vol_env.cur_volume += pb.vol_env.cur_volume_delta;
-  }
+  pb.vol_env.cur_volume = ApplyVolumeEnvelope(samples, count, pb.vol_env.cur_volume,
+                                              static_cast<u16>(pb.vol_env.cur_volume_delta));
 
   // Optionally, execute a low pass filter
   if (pb.lpf.enabled)
@@ -516,9 +366,12 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
 
     // We use ratio 0x55555 == (5 * 65536 + 21845) / 65536 == 5.3333 which
     // is the nearest we can get to 96/18
-    u32 curr_pos = ResampleAudio([&samples](u32 i) { return samples[i]; }, wm_samples, wm_count,
-                                 pb.remote_src.last_samples, pb.remote_src.cur_addr_frac, 0x55555,
-                                 SRCTYPE_POLYPHASE, coeffs);
+    const u32 input_count = GetResampleInputCount(wm_count, pb.remote_src.cur_addr_frac, 0x55555,
+                                                  SRCTYPE_POLYPHASE);
+    s16* input = PrepareInputSamples(pb.remote_src.last_samples, input_count);
+    std::copy_n(samples, input_count, input + 4);
+    u32 curr_pos = ResampleAudio(input, wm_samples, wm_count, pb.remote_src.last_samples,
+                                 pb.remote_src.cur_addr_frac, 0x55555, SRCTYPE_POLYPHASE, coeffs);
     pb.remote_src.cur_addr_frac = curr_pos & 0xFFFF;
 
 // Mix to main[0-3] and aux[0-3]
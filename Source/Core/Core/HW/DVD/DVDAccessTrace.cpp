@@ -0,0 +1,318 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DVD/DVDAccessTrace.h"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+#include "Core/Config/MainSettings.h"
+
+#include "DiscIO/Volume.h"
+
+namespace DVDAccessTrace
+{
+struct TraceHeader
+{
+  u32 magic;
+  u32 version;
+  u32 entry_count;
+  u32 reserved;
+};
+
+struct TraceEntry
+{
+  u64 offset;
+  // The offset of the partition, as in DiscIO::Partition
+  u64 partition;
+  u32 length;
+  // Emulated time since boot
+  u32 time_ms;
+};
+static_assert(sizeof(TraceEntry) == 24);
+
+constexpr u32 TRACE_MAGIC = 0x54445644;  // "DVDT"
+constexpr u32 TRACE_VERSION = 1;
+
+// Contiguous reads that happen this close to each other are stored as one entry
+constexpr u32 MERGE_WINDOW_MS = 100;
+
+// Data that was read more than this long after the data that is being read right now isn't
+// prefetched yet
+constexpr u32 PREFETCH_WINDOW_MS = 5000;
+
+// Stay well below the size of the chunk cache of the compressed blob readers, so that prefetched
+// data doesn't get evicted before the game gets around to reading it
+constexpr u64 MAX_PREFETCH_AHEAD = 16 * 1024 * 1024;
+
+// Prefetching is done in small pieces so that the DVD thread can get back to real requests quickly
+constexpr u32 PREFETCH_PIECE_SIZE = 256 * 1024;
+
+static std::string s_trace_path;
+
+static bool s_recording = false;
+static std::vector<TraceEntry> s_recorded;
+
+static std::vector<TraceEntry> s_trace;
+static std::vector<bool> s_prefetched;
+static std::vector<u8> s_prefetch_buffer;
+// The entry that contained the most recent read
+static size_t s_cursor = 0;
+// The entry that is being prefetched, and how many bytes of it have been prefetched
+static size_t s_prefetch_index = 0;
+static u32 s_prefetch_progress = 0;
+// Bytes prefetched past s_cursor
+static u64 s_prefetched_ahead = 0;
+
+static u64 s_reads = 0;
+static u64 s_warm_reads = 0;
+static u64 s_untraced_reads = 0;
+static u64 s_prefetched_bytes = 0;
+
+static std::string GetTracePath(const DiscIO::Volume& volume)
+{
+  const std::string game_id = volume.GetGameID();
+  if (game_id.empty())
+    return {};
+
+  return fmt::format("{}{}{}_r{}.dvdtrace", File::GetUserPath(D_LOAD_IDX), "DVDTraces" DIR_SEP,
+                     game_id, volume.GetRevision().value_or(0));
+}
+
+static std::vector<TraceEntry> LoadTrace(const std::string& path)
+{
+  File::IOFile file(path, "rb");
+  if (!file)
+    return {};
+
+  TraceHeader header;
+  if (!file.ReadArray(&header, 1) || header.magic != TRACE_MAGIC ||
+      header.version != TRACE_VERSION ||
+      header.entry_count > (file.GetSize() - sizeof(TraceHeader)) / sizeof(TraceEntry))
+  {
+    WARN_LOG_FMT(DVDINTERFACE, "Ignoring invalid DVD access trace {}", path);
+    return {};
+  }
+
+  std::vector<TraceEntry> entries(header.entry_count);
+  if (!file.ReadArray(entries.data(), entries.size()))
+    return {};
+
+  return entries;
+}
+
+static void SaveTrace(const std::string& path, const std::vector<TraceEntry>& entries)
+{
+  File::CreateFullPath(path);
+  File::IOFile file(path, "wb");
+
+  const TraceHeader header{TRACE_MAGIC, TRACE_VERSION, static_cast<u32>(entries.size()), 0};
+  if (!file.WriteArray(&header, 1) || !file.WriteArray(entries.data(), entries.size()))
+  {
+    ERROR_LOG_FMT(DVDINTERFACE, "Failed to write DVD access trace {}", path);
+    return;
+  }
+
+  NOTICE_LOG_FMT(DVDINTERFACE, "Wrote DVD access trace with {} entries to {}", entries.size(),
+                 path);
+}
+
+void Start(const DiscIO::Volume* volume)
+{
+  Stop();
+
+  if (!volume)
+    return;
+
+  const bool record = Config::Get(Config::MAIN_RECORD_DVD_ACCESS_TRACE);
+  const bool prefetch = Config::Get(Config::MAIN_DVD_TRACE_PREFETCH);
+  if (!record && !prefetch)
+    return;
+
+  s_trace_path = GetTracePath(*volume);
+  if (s_trace_path.empty())
+    return;
+
+  s_recording = record;
+
+  if (prefetch)
+  {
+    s_trace = LoadTrace(s_trace_path);
+    s_prefetched.assign(s_trace.size(), false);
+    if (!s_trace.empty())
+      INFO_LOG_FMT(DVDINTERFACE, "Prefetching using DVD access trace {}", s_trace_path);
+  }
+}
+
+void Stop()
+{
+  if (s_recording && !s_recorded.empty())
+    SaveTrace(s_trace_path, s_recorded);
+
+  if (!s_trace.empty() && s_reads != 0)
+  {
+    NOTICE_LOG_FMT(DVDINTERFACE,
+                   "DVD prefetch: {} of {} reads were served warm, {} reads were not in the "
+                   "trace, {} MiB prefetched",
+                   s_warm_reads, s_reads, s_untraced_reads, s_prefetched_bytes / (1024 * 1024));
+  }
+
+  s_trace_path.clear();
+  s_recording = false;
+  s_recorded.clear();
+  s_trace.clear();
+  s_prefetched.clear();
+  s_prefetch_buffer.clear();
+  s_prefetch_buffer.shrink_to_fit();
+  s_cursor = 0;
+  s_prefetch_index = 0;
+  s_prefetch_progress = 0;
+  s_prefetched_ahead = 0;
+  s_reads = 0;
+  s_warm_reads = 0;
+  s_untraced_reads = 0;
+  s_prefetched_bytes = 0;
+}
+
+static void Record(u64 offset, u32 length, const DiscIO::Partition& partition, u32 time_ms)
+{
+  if (!s_recorded.empty())
+  {
+    TraceEntry& last = s_recorded.back();
+    if (last.partition == partition.offset && last.offset + last.length == offset &&
+        time_ms - last.time_ms <= MERGE_WINDOW_MS &&
+        u64(last.length) + length <= std::numeric_limits<u32>::max())
+    {
+      last.length += length;
+      return;
+    }
+  }
+
+  s_recorded.push_back({offset, partition.offset, length, time_ms});
+}
+
+static std::optional<size_t> FindEntry(u64 offset, const DiscIO::Partition& partition)
+{
+  const auto contains = [&](const TraceEntry& entry) {
+    return entry.partition == partition.offset && offset >= entry.offset &&
+           offset < entry.offset + entry.length;
+  };
+
+  // Games mostly read in the order they did last time, so look forward from the last match first
+  for (size_t i = s_cursor; i < s_trace.size(); ++i)
+  {
+    if (contains(s_trace[i]))
+      return i;
+  }
+  for (size_t i = 0; i < s_cursor; ++i)
+  {
+    if (contains(s_trace[i]))
+      return i;
+  }
+
+  return std::nullopt;
+}
+
+static void Match(u64 offset, u32 length, const DiscIO::Partition& partition)
+{
+  ++s_reads;
+
+  const std::optional<size_t> index = FindEntry(offset, partition);
+  if (!index)
+  {
+    ++s_untraced_reads;
+    return;
+  }
+
+  const TraceEntry& entry = s_trace[*index];
+  u64 prefetched_size = 0;
+  if (s_prefetched[*index])
+    prefetched_size = entry.length;
+  else if (*index == s_prefetch_index)
+    prefetched_size = s_prefetch_progress;
+
+  if (offset + length <= entry.offset + prefetched_size)
+    ++s_warm_reads;
+
+  if (*index == s_cursor)
+    return;
+
+  const bool went_back = *index < s_cursor;
+  s_cursor = *index;
+
+  if (went_back || s_prefetch_index <= s_cursor)
+  {
+    // The game went back to something it read earlier, or got ahead of the prefetching.
+    // Continue from the rest of the current entry.
+    s_prefetch_index = s_cursor;
+    s_prefetch_progress = static_cast<u32>(
+        std::min<u64>(offset + length - entry.offset, entry.length));
+    s_prefetched_ahead = 0;
+  }
+  else
+  {
+    s_prefetched_ahead = s_prefetch_progress;
+    for (size_t i = s_cursor + 1; i < s_prefetch_index; ++i)
+      s_prefetched_ahead += s_trace[i].length;
+  }
+}
+
+void LogRead(u64 offset, u32 length, const DiscIO::Partition& partition, u64 time_ms)
+{
+  if (s_recording)
+  {
+    Record(offset, length, partition,
+           static_cast<u32>(std::min<u64>(time_ms, std::numeric_limits<u32>::max())));
+  }
+
+  if (!s_trace.empty())
+    Match(offset, length, partition);
+}
+
+bool Prefetch(const DiscIO::Volume& volume)
+{
+  if (s_prefetch_index >= s_trace.size() || s_prefetched_ahead >= MAX_PREFETCH_AHEAD)
+    return false;
+
+  const TraceEntry& entry = s_trace[s_prefetch_index];
+  if (entry.time_ms > s_trace[s_cursor].time_ms + PREFETCH_WINDOW_MS)
+    return false;
+
+  const u32 size = std::min(PREFETCH_PIECE_SIZE, entry.length - s_prefetch_progress);
+  s_prefetch_buffer.resize(PREFETCH_PIECE_SIZE);
+
+  // The data itself isn't needed. Reading it is what gets it into the caches.
+  if (size == 0 || !volume.Read(entry.offset + s_prefetch_progress, size,
+                                s_prefetch_buffer.data(), DiscIO::Partition(entry.partition)))
+  {
+    // Skip entries that can't be read, e.g. because the trace was made with a different dump
+    ++s_prefetch_index;
+    s_prefetch_progress = 0;
+    return true;
+  }
+
+  s_prefetch_progress += size;
+  s_prefetched_ahead += size;
+  s_prefetched_bytes += size;
+
+  if (s_prefetch_progress >= entry.length)
+  {
+    s_prefetched[s_prefetch_index] = true;
+    ++s_prefetch_index;
+    s_prefetch_progress = 0;
+  }
+
+  return true;
+}
+}  // namespace DVDAccessTrace
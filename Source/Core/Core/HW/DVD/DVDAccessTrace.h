@@ -0,0 +1,35 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace DiscIO
+{
+struct Partition;
+class Volume;
+}  // namespace DiscIO
+
+// Records which parts of the disc a game reads and when, and uses such a recording from an earlier
+// session to read the same data ahead of time while the DVD thread is otherwise idle. This doesn't
+// change anything the emulated software sees. It only warms up the OS page cache and the caches of
+// the blob reader, which helps with slow storage and compressed disc images.
+//
+// Traces are stored per game and revision in Load/DVDTraces/ and can be shared between users.
+namespace DVDAccessTrace
+{
+// Must only be called while the DVD thread is idle. Passing nullptr ends the session without
+// starting a new one. Ending a session saves the trace if one was being recorded and logs how many
+// reads were served by prefetched data.
+void Start(const DiscIO::Volume* volume);
+void Stop();
+
+// Called on the DVD thread before every read requested by the emulated software.
+// time_ms is the emulated time since boot.
+void LogRead(u64 offset, u32 length, const DiscIO::Partition& partition, u64 time_ms);
+
+// Called on the DVD thread when it has no requests to handle. Reads at most one small piece of
+// upcoming data and returns false if there is nothing left to prefetch for now.
+bool Prefetch(const DiscIO::Volume& volume);
+}  // namespace DVDAccessTrace
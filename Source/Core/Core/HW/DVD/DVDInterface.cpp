@@ -515,7 +515,8 @@ static void EjectDiscCallback(u64 userdata, s64 cyclesLate)
 
 static void InsertDiscCallback(u64 userdata, s64 cyclesLate)
 {
-  std::unique_ptr<DiscIO::VolumeDisc> new_disc = DiscIO::CreateDisc(s_disc_path_to_insert);
+  std::unique_ptr<DiscIO::VolumeDisc> new_disc =
+      DiscIO::CreateDisc(s_disc_path_to_insert, Config::Get(Config::MAIN_MAP_DISC_IMAGES));
 
   if (new_disc)
     SetDisc(std::move(new_disc), {});
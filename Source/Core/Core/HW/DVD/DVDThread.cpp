@@ -24,6 +24,7 @@
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
+#include "Core/HW/DVD/DVDAccessTrace.h"
 #include "Core/HW/DVD/DVDInterface.h"
 #include "Core/HW/DVD/FileMonitor.h"
 #include "Core/HW/Memmap.h"
@@ -113,6 +114,7 @@ static void StartDVDThread()
 void Stop()
 {
   StopDVDThread();
+  DVDAccessTrace::Stop();
   s_disc.reset();
 }
 
@@ -157,9 +159,14 @@ void DoState(PointerWrap& p)
   if (had_disc != HasDisc())
   {
     if (had_disc)
+    {
       PanicAlertFmtT("An inserted disc was expected but not found.");
+    }
     else
+    {
+      DVDAccessTrace::Stop();
       s_disc.reset();
+    }
   }
 
   // TODO: Savestates can be smaller if the buffers of results aren't saved,
@@ -176,6 +183,7 @@ void DoState(PointerWrap& p)
 void SetDisc(std::unique_ptr<DiscIO::Volume> disc)
 {
   WaitUntilIdle();
+  DVDAccessTrace::Start(disc.get());
   s_disc = std::move(disc);
 }
 
@@ -376,6 +384,9 @@ static void DVDThread()
     while (s_request_queue.Pop(request))
     {
       FileMonitor::Log(*s_disc, request.partition, request.dvd_offset);
+      DVDAccessTrace::LogRead(request.dvd_offset, request.length, request.partition,
+                              request.time_started_ticks /
+                                  (SystemTimers::GetTicksPerSecond() / 1000));
 
       std::vector<u8> buffer(request.length);
       if (!s_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
@@ -389,6 +400,13 @@ static void DVDThread()
       if (s_dvd_thread_exiting.IsSet())
         return;
     }
+
+    // Until the next request comes in, read data that the game read soon after this point the
+    // last time it was played
+    while (s_disc && s_request_queue.Empty() && !s_dvd_thread_exiting.IsSet() &&
+           DVDAccessTrace::Prefetch(*s_disc))
+    {
+    }
   }
 }
 }  // namespace DVDThread
@@ -10,10 +10,14 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <tuple>
+#include <utility>
 
+#include "Common/Align.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -33,6 +37,7 @@
 #include "Core/HW/SI/SI.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/HW/WII_IPC.h"
+#include "Core/MemTools.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
@@ -177,6 +182,7 @@ struct LogicalMemoryView
 {
   void* mapped_pointer;
   u32 mapped_size;
+  u32 shm_position;
 };
 
 // Dolphin allocates memory to represent four regions:
@@ -223,6 +229,51 @@ static std::array<PhysicalMemoryRegion, 4> s_physical_regions;
 
 static std::vector<LogicalMemoryView> logical_mapped_entries;
 
+// Dirty page tracking
+//
+// Every view of emulated memory is write-protected. The first write to a page through a view
+// faults, and the fault handler marks the page as dirty and makes it writable in that view. Each
+// view of a page faults separately the first time it's written through.
+struct TrackedView
+{
+  u8* pointer;
+  u32 size;
+  u32 shm_position;
+};
+
+static u32 s_shm_size = 0;
+static size_t s_host_page_size = 0;
+static std::atomic<bool> s_dirty_page_tracking = false;
+// Also taken by the fault handler, so emulated memory must not be written to while holding it.
+static std::mutex s_tracked_views_mutex;
+static std::vector<TrackedView> s_tracked_views;
+static std::unique_ptr<std::atomic<bool>[]> s_dirty_pages;
+
+static std::function<void(PointerWrap&)> s_state_memory_handler;
+
+// Must be called with s_tracked_views_mutex held.
+static void CollectTrackedViews()
+{
+  s_tracked_views.clear();
+  for (const PhysicalMemoryRegion& region : s_physical_regions)
+  {
+    if (!region.active)
+      continue;
+
+    s_tracked_views.push_back({*region.out_pointer, region.size, region.shm_position});
+    if (is_fastmem_arena_initialized)
+    {
+      s_tracked_views.push_back(
+          {physical_base + region.physical_address, region.size, region.shm_position});
+    }
+  }
+  for (const LogicalMemoryView& entry : logical_mapped_entries)
+  {
+    s_tracked_views.push_back(
+        {static_cast<u8*>(entry.mapped_pointer), entry.mapped_size, entry.shm_position});
+  }
+}
+
 void Init()
 {
   const auto get_mem1_size = [] {
@@ -279,6 +330,9 @@ void Init()
     mem_size += region.size;
   }
   g_arena.GrabSHMSegment(mem_size);
+  s_shm_size = mem_size;
+  s_host_page_size = g_arena.GetPageSize();
+  s_dirty_pages = std::make_unique<std::atomic<bool>[]>(mem_size / DIRTY_PAGE_SIZE);
 
   // Create an anonymous view of the physical memory
   for (const PhysicalMemoryRegion& region : s_physical_regions)
@@ -350,6 +404,8 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
   if (!is_fastmem_arena_initialized)
     return;
 
+  std::lock_guard lk(s_tracked_views_mutex);
+
   for (auto& entry : logical_mapped_entries)
   {
     g_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
@@ -387,11 +443,152 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
                           intersection_start, mapped_size, logical_address);
             exit(0);
           }
-          logical_mapped_entries.push_back({mapped_pointer, mapped_size});
+          logical_mapped_entries.push_back({mapped_pointer, mapped_size, position});
         }
       }
     }
   }
+
+  // The new views start out writable, so writes through them would go unnoticed
+  if (s_dirty_page_tracking)
+  {
+    CollectTrackedViews();
+    for (const LogicalMemoryView& entry : logical_mapped_entries)
+      g_arena.SetViewWritable(entry.mapped_pointer, entry.mapped_size, false);
+  }
+}
+
+u32 GetTrackedMemorySize()
+{
+  return s_shm_size;
+}
+
+u8* GetTrackedMemoryPointer(u32 offset)
+{
+  for (const PhysicalMemoryRegion& region : s_physical_regions)
+  {
+    if (region.active && offset >= region.shm_position &&
+        offset - region.shm_position < region.size)
+    {
+      return *region.out_pointer + (offset - region.shm_position);
+    }
+  }
+  return nullptr;
+}
+
+// Must be called with s_tracked_views_mutex held. offset and size must be multiples of the host
+// page size.
+static bool MarkDirtyAndMakeWritable(const TrackedView& view, size_t offset, size_t size)
+{
+  const size_t first_page = (view.shm_position + offset) / DIRTY_PAGE_SIZE;
+  for (size_t i = 0; i < size / DIRTY_PAGE_SIZE; ++i)
+    s_dirty_pages[first_page + i].store(true, std::memory_order_relaxed);
+
+  return g_arena.SetViewWritable(view.pointer + offset, size, true);
+}
+
+// Must be called with s_tracked_views_mutex held.
+static void StopDirtyPageTrackingLocked()
+{
+  if (!s_dirty_page_tracking)
+    return;
+
+  // Views are made writable before tracking is turned off so that faults still being handled
+  // on other threads are recognized as ours.
+  for (const TrackedView& view : s_tracked_views)
+    g_arena.SetViewWritable(view.pointer, view.size, true);
+  s_tracked_views.clear();
+  s_dirty_page_tracking = false;
+}
+
+bool ResetDirtyPages()
+{
+  if (!EMM::IsHandlingFaultsOnAllThreads() || s_host_page_size < DIRTY_PAGE_SIZE ||
+      s_host_page_size % DIRTY_PAGE_SIZE != 0)
+  {
+    return false;
+  }
+
+  std::lock_guard lk(s_tracked_views_mutex);
+
+  for (u32 i = 0; i < s_shm_size / DIRTY_PAGE_SIZE; ++i)
+    s_dirty_pages[i].store(false, std::memory_order_relaxed);
+
+  CollectTrackedViews();
+  s_dirty_page_tracking = true;
+  for (const TrackedView& view : s_tracked_views)
+  {
+    if (!g_arena.SetViewWritable(view.pointer, view.size, false))
+    {
+      StopDirtyPageTrackingLocked();
+      return false;
+    }
+  }
+  return true;
+}
+
+void StopDirtyPageTracking()
+{
+  std::lock_guard lk(s_tracked_views_mutex);
+  StopDirtyPageTrackingLocked();
+}
+
+std::vector<u32> GetDirtyPages()
+{
+  const u32 num_pages = s_shm_size / DIRTY_PAGE_SIZE;
+  const bool tracking = s_dirty_page_tracking;
+
+  std::vector<u32> pages;
+  for (u32 i = 0; i < num_pages; ++i)
+  {
+    if (!tracking || s_dirty_pages[i].load(std::memory_order_relaxed))
+      pages.push_back(i);
+  }
+  return pages;
+}
+
+bool HandleFault(uintptr_t fault_address)
+{
+  if (!s_dirty_page_tracking)
+    return false;
+
+  std::lock_guard lk(s_tracked_views_mutex);
+  for (const TrackedView& view : s_tracked_views)
+  {
+    const uintptr_t start = reinterpret_cast<uintptr_t>(view.pointer);
+    if (fault_address < start || fault_address - start >= view.size)
+      continue;
+
+    const size_t offset = (fault_address - start) & ~(s_host_page_size - 1);
+    return MarkDirtyAndMakeWritable(view, offset, s_host_page_size);
+  }
+  return false;
+}
+
+void PrepareForExternalWrite(void* pointer, size_t size)
+{
+  if (!s_dirty_page_tracking || size == 0)
+    return;
+
+  std::lock_guard lk(s_tracked_views_mutex);
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(pointer);
+  const uintptr_t end = begin + size;
+  for (const TrackedView& view : s_tracked_views)
+  {
+    const uintptr_t start = reinterpret_cast<uintptr_t>(view.pointer);
+    if (end <= start || begin >= start + view.size)
+      continue;
+
+    const size_t first = (std::max(begin, start) - start) & ~(s_host_page_size - 1);
+    const size_t last = std::min<size_t>(
+        Common::AlignUp(std::min(end, start + view.size) - start, s_host_page_size), view.size);
+    MarkDirtyAndMakeWritable(view, first, last - first);
+  }
+}
+
+void SetStateMemoryHandler(std::function<void(PointerWrap&)> handler)
+{
+  s_state_memory_handler = std::move(handler);
 }
 
 void DoState(PointerWrap& p)
@@ -432,6 +629,13 @@ void DoState(PointerWrap& p)
     return;
   }
 
+  if (s_state_memory_handler)
+  {
+    s_state_memory_handler(p);
+    p.DoMarker("Memory");
+    return;
+  }
+
   p.DoArray(m_pRAM, current_ram_size);
   p.DoArray(m_pL1Cache, current_l1_cache_size);
   p.DoMarker("Memory RAM");
@@ -446,6 +650,9 @@ void DoState(PointerWrap& p)
 void Shutdown()
 {
   ShutdownFastmemArena();
+  StopDirtyPageTracking();
+  s_dirty_pages.reset();
+  s_shm_size = 0;
 
   m_IsInitialized = false;
   for (const PhysicalMemoryRegion& region : s_physical_regions)
@@ -466,6 +673,9 @@ void ShutdownFastmemArena()
   if (!is_fastmem_arena_initialized)
     return;
 
+  // Tracking restarts with the next ResetDirtyPages()
+  StopDirtyPageTracking();
+
   for (const PhysicalMemoryRegion& region : s_physical_regions)
   {
     if (!region.active)
@@ -3,8 +3,12 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
@@ -70,6 +74,30 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
 void Clear();
 
+// Dirty page tracking, used by rewinding to copy only the memory that was written to.
+//
+// All of emulated memory is treated as a single range made up of the regions in the order DoState
+// saves them in: RAM, locked L1, FakeVMEM and EXRAM, skipping those that don't exist.
+constexpr u32 DIRTY_PAGE_SIZE = 0x1000;
+u32 GetTrackedMemorySize();
+// Returns the memory at the given offset of that range. A page never spans two regions.
+u8* GetTrackedMemoryPointer(u32 offset);
+// Forgets which pages were written to and write-protects emulated memory, so that the next write
+// to each page is noticed. Must be called while nothing is writing to emulated memory. Returns
+// false if writes can't be tracked, in which case every page counts as written to.
+bool ResetDirtyPages();
+void StopDirtyPageTracking();
+// Returns the indices of the pages written to since the last ResetDirtyPages().
+std::vector<u32> GetDirtyPages();
+// Called by the exception handler. Returns true if the fault was a write to tracked memory.
+bool HandleFault(uintptr_t fault_address);
+// Writes by the host kernel fail instead of faulting, so this must be called before handing
+// emulated memory to the system to write to, like for reading a file or a socket.
+void PrepareForExternalWrite(void* pointer, size_t size);
+
+// While a handler is set, DoState calls it in place of saving or loading the contents of memory.
+void SetStateMemoryHandler(std::function<void(PointerWrap&)> handler);
+
 // Routines to access physically addressed memory, designed for use by
 // emulated hardware outside the CPU. Use "Device_" prefix.
 std::string GetString(u32 em_address, size_t size = 0);
@@ -27,6 +27,7 @@ enum Hotkey
   HK_RESET,
   HK_FULLSCREEN,
   HK_SCREENSHOT,
+  HK_CAPTURE_TRACE,
   HK_EXIT,
   HK_UNLOCK_CURSOR,
   HK_ACTIVATE_CHAT,
@@ -164,6 +165,7 @@ enum Hotkey
   HK_UNDO_SAVE_STATE,
   HK_SAVE_STATE_FILE,
   HK_LOAD_STATE_FILE,
+  HK_REWIND,
 
   HK_GBA_LOAD,
   HK_GBA_UNLOAD,
@@ -283,7 +283,9 @@ s32 SDIOSlot0Device::ExecuteCommand(const Request& request, u32 buffer_in, u32 b
       if (!m_card.Seek(address, File::SeekOrigin::Begin))
         ERROR_LOG_FMT(IOS_SD, "Seek failed");
 
-      if (m_card.ReadBytes(Memory::GetPointer(req.addr), size))
+      u8* const buffer = Memory::GetPointer(req.addr);
+      Memory::PrepareForExternalWrite(buffer, size);
+      if (m_card.ReadBytes(buffer, size))
       {
         DEBUG_LOG_FMT(IOS_SD, "Outbuffer size {} got {}", rw_buffer_size, size);
       }
@@ -513,7 +513,9 @@ std::optional<IPCReply> WFSIDevice::IOCtl(const IOCtlRequest& request)
     }
     else
     {
-      fp.ReadBytes(Memory::GetPointer(dol_addr), max_dol_size);
+      u8* const buffer = Memory::GetPointer(dol_addr);
+      Memory::PrepareForExternalWrite(buffer, max_dol_size);
+      fp.ReadBytes(buffer, max_dol_size);
     }
     Memory::Write_U32(real_dol_size, request.buffer_out);
     break;
@@ -561,7 +563,9 @@ u32 WFSIDevice::GetTmd(u16 group_id, u32 title_id, u64 subtitle_id, u32 address,
   }
   if (address)
   {
-    fp.ReadBytes(Memory::GetPointer(address), fp.GetSize());
+    u8* const buffer = Memory::GetPointer(address);
+    Memory::PrepareForExternalWrite(buffer, fp.GetSize());
+    fp.ReadBytes(buffer, fp.GetSize());
   }
   *size = fp.GetSize();
   return IPC_SUCCESS;
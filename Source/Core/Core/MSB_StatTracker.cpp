@@ -619,20 +619,26 @@ void StatTracker::logDefensiveStats(int in_team_id, int roster_id){
 
     m_game_info.character_summaries[idx][roster_id].is_starred = PowerPC::HostRead_U8(aPitcher_IsStarred + is_starred_offset);
 
-    stat.batters_faced       = PowerPC::HostRead_U8(aPitcher_BattersFaced + offset);
-    stat.runs_allowed        = PowerPC::HostRead_U16(aPitcher_RunsAllowed + offset);
-    stat.earned_runs         = PowerPC::HostRead_U16(aPitcher_RunsAllowed + offset);
-    stat.batters_walked      = PowerPC::HostRead_U16(aPitcher_BattersWalked + offset);
-    stat.batters_hit         = PowerPC::HostRead_U16(aPitcher_BattersHit + offset);
-    stat.hits_allowed        = PowerPC::HostRead_U16(aPitcher_HitsAllowed + offset);
-    stat.homeruns_allowed    = PowerPC::HostRead_U16(aPitcher_HRsAllowed + offset);
-    stat.pitches_thrown      = PowerPC::HostRead_U16(aPitcher_PitchesThrown + offset);
-    stat.stamina             = PowerPC::HostRead_U16(aPitcher_Stamina + offset);
-    stat.was_pitcher         = PowerPC::HostRead_U8(aPitcher_WasPitcher + offset);
-    stat.batter_outs         = PowerPC::HostRead_U8(aPitcher_BatterOuts + offset);
-    stat.outs_pitched        = PowerPC::HostRead_U8(aPitcher_OutsPitched + offset);
-    stat.strike_outs         = PowerPC::HostRead_U8(aPitcher_StrikeOuts + offset);
-    stat.star_pitches_thrown = PowerPC::HostRead_U8(aPitcher_StarPitchesThrown + offset);
+    // Read the whole stat block through one translated view instead of field by field
+    const auto block = PowerPC::HostGetRAMRange(aPitcher_BattersFaced + offset,
+                                                aPitcher_StarPitchesThrown - aPitcher_BattersFaced + 1);
+    if (block){
+        const auto field = [](u32 addr) { return addr - aPitcher_BattersFaced; };
+        stat.batters_faced       = block->Read<u8>(field(aPitcher_BattersFaced));
+        stat.runs_allowed        = block->Read<u16>(field(aPitcher_RunsAllowed));
+        stat.earned_runs         = block->Read<u16>(field(aPitcher_RunsAllowed));
+        stat.batters_walked      = block->Read<u16>(field(aPitcher_BattersWalked));
+        stat.batters_hit         = block->Read<u16>(field(aPitcher_BattersHit));
+        stat.hits_allowed        = block->Read<u16>(field(aPitcher_HitsAllowed));
+        stat.homeruns_allowed    = block->Read<u16>(field(aPitcher_HRsAllowed));
+        stat.pitches_thrown      = block->Read<u16>(field(aPitcher_PitchesThrown));
+        stat.stamina             = block->Read<u16>(field(aPitcher_Stamina));
+        stat.was_pitcher         = block->Read<u8>(field(aPitcher_WasPitcher));
+        stat.batter_outs         = block->Read<u8>(field(aPitcher_BatterOuts));
+        stat.outs_pitched        = block->Read<u8>(field(aPitcher_OutsPitched));
+        stat.strike_outs         = block->Read<u8>(field(aPitcher_StrikeOuts));
+        stat.star_pitches_thrown = block->Read<u8>(field(aPitcher_StarPitchesThrown));
+    }
 
     //Get inherent values. Doesn't strictly belong here but we need the adjusted_team_id
     m_game_info.character_summaries[idx][roster_id].char_id = PowerPC::HostRead_U8(aInGame_CharAttributes_CharId + ingame_attribute_table_offset);
@@ -649,22 +655,29 @@ void StatTracker::logOffensiveStats(int in_team_id, int roster_id){
 
     auto& stat = m_game_info.character_summaries[idx][roster_id].end_game_offensive_stats;
 
-    stat.at_bats          = PowerPC::HostRead_U8(aBatter_AtBats + offset);
-    stat.hits             = PowerPC::HostRead_U8(aBatter_Hits + offset);
-    stat.singles          = PowerPC::HostRead_U8(aBatter_Singles + offset);
-    stat.doubles          = PowerPC::HostRead_U8(aBatter_Doubles + offset);
-    stat.triples          = PowerPC::HostRead_U8(aBatter_Triples + offset);
-    stat.homeruns         = PowerPC::HostRead_U8(aBatter_Homeruns + offset);
-    stat.successful_bunts = PowerPC::HostRead_U8(aBatter_BuntSuccess + offset);
-    stat.sac_flys         = PowerPC::HostRead_U8(aBatter_SacFlys + offset);
-    stat.strikouts        = PowerPC::HostRead_U8(aBatter_Strikeouts + offset);
-    stat.walks_4balls     = PowerPC::HostRead_U8(aBatter_Walks_4Balls + offset);
-    stat.walks_hit        = PowerPC::HostRead_U8(aBatter_Walks_Hit + offset);
-    stat.rbi              = PowerPC::HostRead_U8(aBatter_RBI + offset);
-    stat.bases_stolen     = PowerPC::HostRead_U8(aBatter_BasesStolen + offset);
-    stat.star_hits        = PowerPC::HostRead_U8(aBatter_StarHits + offset);
-
-    m_game_info.character_summaries[idx][roster_id].end_game_defensive_stats.big_plays = PowerPC::HostRead_U8(aBatter_BigPlays + offset);
+    // Read the whole stat block through one translated view instead of field by field
+    const auto block = PowerPC::HostGetRAMRange(aBatter_AtBats + offset,
+                                                aBatter_StarHits - aBatter_AtBats + 1);
+    if (!block)
+        return;
+
+    const auto field = [](u32 addr) { return addr - aBatter_AtBats; };
+    stat.at_bats          = block->Read<u8>(field(aBatter_AtBats));
+    stat.hits             = block->Read<u8>(field(aBatter_Hits));
+    stat.singles          = block->Read<u8>(field(aBatter_Singles));
+    stat.doubles          = block->Read<u8>(field(aBatter_Doubles));
+    stat.triples          = block->Read<u8>(field(aBatter_Triples));
+    stat.homeruns         = block->Read<u8>(field(aBatter_Homeruns));
+    stat.successful_bunts = block->Read<u8>(field(aBatter_BuntSuccess));
+    stat.sac_flys         = block->Read<u8>(field(aBatter_SacFlys));
+    stat.strikouts        = block->Read<u8>(field(aBatter_Strikeouts));
+    stat.walks_4balls     = block->Read<u8>(field(aBatter_Walks_4Balls));
+    stat.walks_hit        = block->Read<u8>(field(aBatter_Walks_Hit));
+    stat.rbi              = block->Read<u8>(field(aBatter_RBI));
+    stat.bases_stolen     = block->Read<u8>(field(aBatter_BasesStolen));
+    stat.star_hits        = block->Read<u8>(field(aBatter_StarHits));
+
+    m_game_info.character_summaries[idx][roster_id].end_game_defensive_stats.big_plays = block->Read<u8>(field(aBatter_BigPlays));
 }
 
 void StatTracker::logEventState(Event& in_event){
@@ -14,6 +14,7 @@
 #include "Common/MsgHandler.h"
 #include "Common/Thread.h"
 
+#include "Core/HW/Memmap.h"
 #include "Core/MachineContext.h"
 #include "Core/PowerPC/JitInterface.h"
 
@@ -60,7 +61,7 @@ static LONG NTAPI Handler(PEXCEPTION_POINTERS pPtrs)
     uintptr_t fault_address = (uintptr_t)pPtrs->ExceptionRecord->ExceptionInformation[1];
     SContext* ctx = pPtrs->ContextRecord;
 
-    if (JitInterface::HandleFault(fault_address, ctx))
+    if (Memory::HandleFault(fault_address) || JitInterface::HandleFault(fault_address, ctx))
     {
       return EXCEPTION_CONTINUE_EXECUTION;
     }
@@ -118,6 +119,11 @@ bool IsExceptionHandlerSupported()
   return true;
 }
 
+bool IsHandlingFaultsOnAllThreads()
+{
+  return s_veh_handle != nullptr;
+}
+
 #elif defined(__APPLE__) && !defined(USE_SIGACTION_ON_APPLE)
 
 static void CheckKR(const char* name, kern_return_t kr)
@@ -190,7 +196,8 @@ static void ExceptionThread(mach_port_t port)
 
     thread_state64_t* state = (thread_state64_t*)msg_in.old_state;
 
-    bool ok = JitInterface::HandleFault((uintptr_t)msg_in.code[1], state);
+    bool ok = Memory::HandleFault((uintptr_t)msg_in.code[1]) ||
+              JitInterface::HandleFault((uintptr_t)msg_in.code[1], state);
 
     // Set up the reply.
     msg_out.Head.msgh_bits = MACH_MSGH_BITS(MACH_MSGH_BITS_REMOTE(msg_in.Head.msgh_bits), 0);
@@ -253,10 +260,17 @@ bool IsExceptionHandlerSupported()
   return true;
 }
 
+bool IsHandlingFaultsOnAllThreads()
+{
+  // The exception port only belongs to the thread that installed the handler.
+  return false;
+}
+
 #elif defined(_POSIX_VERSION) && !defined(_M_GENERIC)
 
 static struct sigaction old_sa_segv;
 static struct sigaction old_sa_bus;
+static bool s_handler_installed = false;
 
 static void sigsegv_handler(int sig, siginfo_t* info, void* raw_context)
 {
@@ -280,6 +294,9 @@ static void sigsegv_handler(int sig, siginfo_t* info, void* raw_context)
 #else
   mcontext_t* ctx = &context->uc_mcontext;
 #endif
+  if (Memory::HandleFault(bad_address))
+    return;
+
   // assume it's not a write
   if (!JitInterface::HandleFault(bad_address,
 #ifdef __APPLE__
@@ -346,6 +363,7 @@ void InstallExceptionHandler()
 #ifdef __APPLE__
   sigaction(SIGBUS, &sa, &old_sa_bus);
 #endif
+  s_handler_installed = true;
 }
 
 void UninstallExceptionHandler()
@@ -360,6 +378,7 @@ void UninstallExceptionHandler()
 #ifdef __APPLE__
   sigaction(SIGBUS, &old_sa_bus, nullptr);
 #endif
+  s_handler_installed = false;
 }
 
 bool IsExceptionHandlerSupported()
@@ -367,6 +386,11 @@ bool IsExceptionHandlerSupported()
   return true;
 }
 
+bool IsHandlingFaultsOnAllThreads()
+{
+  return s_handler_installed;
+}
+
 #else  // _M_GENERIC or unsupported platform
 
 void InstallExceptionHandler()
@@ -382,6 +406,11 @@ bool IsExceptionHandlerSupported()
   return false;
 }
 
+bool IsHandlingFaultsOnAllThreads()
+{
+  return false;
+}
+
 #endif
 
 }  // namespace EMM
@@ -8,4 +8,8 @@ namespace EMM
 void InstallExceptionHandler();
 void UninstallExceptionHandler();
 bool IsExceptionHandlerSupported();
+
+// Whether an exception handler is installed which also sees faults on threads other than the one
+// that installed it.
+bool IsHandlingFaultsOnAllThreads();
 }  // namespace EMM
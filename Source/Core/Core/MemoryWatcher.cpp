@@ -3,13 +3,20 @@
 
 #include "Core/MemoryWatcher.h"
 
+#include <algorithm>
 #include <cstring>
+#include <fcntl.h>
 #include <fstream>
 #include <iostream>
+#include <new>
 #include <sstream>
+#include <sys/mman.h>
 #include <unistd.h>
 
+#include "Common/CommonFuncs.h"
 #include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/PowerPC/MMU.h"
 
@@ -18,8 +25,16 @@ MemoryWatcher::MemoryWatcher()
   m_running = false;
   if (!LoadAddresses(File::GetUserPath(F_MEMORYWATCHERLOCATIONS_IDX)))
     return;
-  if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
+
+  if (Config::Get(Config::MAIN_MEMORY_WATCHER_SHARED_MEMORY))
+  {
+    if (!OpenSharedMemory(File::GetUserPath(F_MEMORYWATCHERSHAREDMEMORY_IDX)))
+      return;
+  }
+  else if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
+  {
     return;
+  }
   m_running = true;
 }
 
@@ -29,7 +44,10 @@ MemoryWatcher::~MemoryWatcher()
     return;
 
   m_running = false;
-  close(m_fd);
+  if (m_shared)
+    munmap(m_shared, m_shared_size);
+  else
+    close(m_fd);
 }
 
 bool MemoryWatcher::LoadAddresses(const std::string& path)
@@ -43,19 +61,19 @@ bool MemoryWatcher::LoadAddresses(const std::string& path)
   while (std::getline(locations, line))
     ParseLine(line);
 
-  return !m_values.empty();
+  return !m_watches.empty();
 }
 
 void MemoryWatcher::ParseLine(const std::string& line)
 {
-  m_values[line] = 0;
-  m_addresses[line] = std::vector<u32>();
+  Watch& watch = m_watches.emplace_back();
+  watch.line = line;
 
   std::istringstream offsets(line);
   offsets >> std::hex;
   u32 offset;
   while (offsets >> offset)
-    m_addresses[line].push_back(offset);
+    watch.offsets.push_back(offset);
 }
 
 bool MemoryWatcher::OpenSocket(const std::string& path)
@@ -67,10 +85,48 @@ bool MemoryWatcher::OpenSocket(const std::string& path)
   return m_fd >= 0;
 }
 
-u32 MemoryWatcher::ChasePointer(const std::string& line)
+bool MemoryWatcher::OpenSharedMemory(const std::string& path)
+{
+  const u32 entry_count = static_cast<u32>(m_watches.size());
+  m_changed.resize((entry_count + 31) / 32);
+  const u32 values_offset = static_cast<u32>(sizeof(SharedHeader) + m_changed.size() * sizeof(u32));
+  const size_t size = values_offset + entry_count * sizeof(u32);
+
+  // Replace the file of a previous session rather than resizing it, so that readers which still
+  // have it mapped aren't cut off.
+  unlink(path.c_str());
+  const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+  if (fd < 0)
+    return false;
+
+  void* memory = MAP_FAILED;
+  if (ftruncate(fd, size) == 0)
+    memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED)
+  {
+    ERROR_LOG_FMT(CORE, "Failed to map MemoryWatcher shared memory {}: {}", path,
+                  LastStrerrorString());
+    return false;
+  }
+
+  m_shared = new (memory) SharedHeader{};
+  m_shared_size = size;
+  m_shared->entry_count = entry_count;
+  m_shared->values_offset = values_offset;
+  m_shared->version = SHARED_VERSION;
+  m_shared->sequence.store(0, std::memory_order_relaxed);
+  m_shared->update_count = 0;
+  // Readers check the magic last, so write it once everything else is in place.
+  std::atomic_thread_fence(std::memory_order_release);
+  m_shared->magic = SHARED_MAGIC;
+  return true;
+}
+
+u32 MemoryWatcher::ChasePointer(const Watch& watch)
 {
   u32 value = 0;
-  for (u32 offset : m_addresses[line])
+  for (u32 offset : watch.offsets)
   {
     value = PowerPC::HostRead_U32(value + offset);
     if (!PowerPC::HostIsRAMAddress(value))
@@ -84,28 +140,64 @@ std::string MemoryWatcher::ComposeMessages()
   std::ostringstream message_stream;
   message_stream << std::hex;
 
-  for (auto& entry : m_values)
+  for (Watch& watch : m_watches)
   {
-    std::string address = entry.first;
-    u32& current_value = entry.second;
-
-    u32 new_value = ChasePointer(address);
-    if (new_value != current_value)
+    u32 new_value = ChasePointer(watch);
+    if (new_value != watch.value)
     {
       // Update the value
-      current_value = new_value;
-      message_stream << address << '\n' << new_value << '\n';
+      watch.value = new_value;
+      message_stream << watch.line << '\n' << new_value << '\n';
     }
   }
 
   return message_stream.str();
 }
 
+void MemoryWatcher::PublishSharedMemory()
+{
+  // Do the reads before taking the seqlock, so that readers only ever have to retry for the
+  // duration of a few memcpys.
+  std::fill(m_changed.begin(), m_changed.end(), 0);
+  for (size_t i = 0; i < m_watches.size(); ++i)
+  {
+    Watch& watch = m_watches[i];
+    const u32 new_value = ChasePointer(watch);
+    if (new_value != watch.value)
+    {
+      watch.value = new_value;
+      m_changed[i / 32] |= 1U << (i % 32);
+    }
+  }
+
+  u8* const base = reinterpret_cast<u8*>(m_shared);
+  const u32 sequence = m_shared->sequence.load(std::memory_order_relaxed);
+  m_shared->sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  std::memcpy(base + sizeof(SharedHeader), m_changed.data(), m_changed.size() * sizeof(u32));
+  u8* values = base + m_shared->values_offset;
+  for (const Watch& watch : m_watches)
+  {
+    std::memcpy(values, &watch.value, sizeof(u32));
+    values += sizeof(u32);
+  }
+  ++m_shared->update_count;
+
+  m_shared->sequence.store(sequence + 2, std::memory_order_release);
+}
+
 void MemoryWatcher::Step()
 {
   if (!m_running)
     return;
 
+  if (m_shared)
+  {
+    PublishSharedMemory();
+    return;
+  }
+
   std::string message = ComposeMessages();
   sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
          sizeof(m_addr));
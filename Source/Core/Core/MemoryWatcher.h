@@ -5,7 +5,7 @@
 
 #include "Common/CommonTypes.h"
 
-#include <map>
+#include <atomic>
 #include <string>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -19,28 +19,67 @@
 // "ABCD EF" will watch the address at (*0xABCD) + 0xEF.
 // The output to the socket is two lines. The first is the address from the
 // input file, and the second is the new value in hex.
+//
+// With MAIN_MEMORY_WATCHER_SHARED_MEMORY set, all values are instead published once per frame to
+// a shared memory file next to the socket, which any number of local readers can map. Its layout
+// is described by MemoryWatcher::SharedHeader.
 class MemoryWatcher final
 {
 public:
+  static constexpr u32 SHARED_MAGIC = 0x534D5744;  // "DWMS"
+  static constexpr u32 SHARED_VERSION = 1;
+
+  // All fields are in host byte order. The header is followed by the change bitmap, one bit per
+  // line of the input file (u32 words, bit i % 32 of word i / 32), and then one u32 value per
+  // line. A bit is set if the value changed in the most recent update.
+  //
+  // The region is protected by a seqlock: the sequence number is odd while an update is being
+  // written. Readers load the sequence, copy what they need, and retry if the sequence was odd or
+  // has changed in the meantime. The magic is written last when the region is set up, and a new
+  // file replaces the old one every time emulation starts.
+  struct SharedHeader
+  {
+    u32 magic;
+    u32 version;
+    u32 entry_count;
+    u32 values_offset;
+    std::atomic<u32> sequence;
+    u32 reserved;
+    // The number of updates published so far.
+    u64 update_count;
+  };
+
   MemoryWatcher();
   ~MemoryWatcher();
   void Step();
 
 private:
+  struct Watch
+  {
+    // The line from the input file
+    std::string line;
+    std::vector<u32> offsets;
+    u32 value = 0;
+  };
+
   bool LoadAddresses(const std::string& path);
   bool OpenSocket(const std::string& path);
+  bool OpenSharedMemory(const std::string& path);
 
   void ParseLine(const std::string& line);
-  u32 ChasePointer(const std::string& line);
+  u32 ChasePointer(const Watch& watch);
   std::string ComposeMessages();
+  void PublishSharedMemory();
 
   bool m_running = false;
 
-  int m_fd;
+  int m_fd = -1;
   sockaddr_un m_addr{};
 
-  // Address as stored in the file -> list of offsets to follow
-  std::map<std::string, std::vector<u32>> m_addresses;
-  // Address as stored in the file -> current value
-  std::map<std::string, u32> m_values;
+  SharedHeader* m_shared = nullptr;
+  size_t m_shared_size = 0;
+  std::vector<u32> m_changed;
+
+  // One entry per line of the input file, in order
+  std::vector<Watch> m_watches;
 };
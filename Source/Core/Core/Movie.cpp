@@ -19,6 +19,13 @@
 #include <vector>
 
 #include <fmt/format.h>
+#include <xxhash.h>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
 
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
@@ -47,6 +54,7 @@
 #include "Core/HW/EXI/EXI.h"
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
 #include "Core/HW/EXI/EXI_DeviceMemoryCard.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/HW/SI/SI.h"
 #include "Core/HW/SI/SI_Device.h"
@@ -61,6 +69,8 @@
 
 #include "Core/IOS/USB/Bluetooth/BTEmu.h"
 #include "Core/IOS/USB/Bluetooth/WiimoteDevice.h"
+#include "Core/MovieInputLog.h"
+#include "Core/MovieSeekIndex.h"
 #include "Core/NetPlayProto.h"
 #include "Core/State.h"
 #include "Core/WiiUtils.h"
@@ -72,9 +82,6 @@
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoConfig.h"
 
-// The chunk to allocate movie data in multiples of.
-#define DTM_BASE_LENGTH (1024)
-
 namespace Movie
 {
 using namespace WiimoteCommon;
@@ -95,7 +102,21 @@ static std::array<ControllerType, 4> s_controllers{};
 static std::array<bool, 4> s_wiimotes{};
 static ControllerState s_padState;
 static DTMHeader tmpHeader;
-static std::vector<u8> s_temp_input;
+// The temporary files are named after the process, since several instances of Dolphin may share
+// the same user folder
+static std::string GetMovieTempFileName(std::string_view name)
+{
+#ifdef _WIN32
+  const u64 process_id = _getpid();
+#else
+  const u64 process_id = getpid();
+#endif
+  return fmt::format("{}.{}.tmp", name, process_id);
+}
+
+static InputLog s_input_log{GetMovieTempFileName("MovieInput"), sizeof(DTMHeader)};
+static SeekIndex s_seek_index{GetMovieTempFileName("MovieKeyframes")};
+static RAMHashResults s_ram_hash_results;
 static u64 s_currentByte = 0;
 static u64 s_currentFrame = 0, s_totalFrames = 0;  // VI
 static u64 s_currentLagCount = 0;
@@ -220,6 +241,63 @@ std::string GetRerecords()
   return "Rerecords: N/A";
 }
 
+static u64 HashRAM()
+{
+  u64 hash = XXH64(Memory::m_pRAM, Memory::GetRamSizeReal(), 0);
+  if (SConfig::GetInstance().bWii)
+    hash = XXH64(Memory::m_pEXRAM, Memory::GetExRamSizeReal(), hash);
+  return hash;
+}
+
+// NOTE: CPU Thread
+static void CheckRAMHash()
+{
+  const std::optional<u64> expected_hash = s_seek_index.GetRAMHash(s_currentFrame);
+  if (!expected_hash)
+    return;
+
+  ++s_ram_hash_results.checked;
+  if (HashRAM() == *expected_hash)
+    return;
+
+  ++s_ram_hash_results.mismatched;
+  if (!s_ram_hash_results.first_mismatch_frame)
+  {
+    s_ram_hash_results.first_mismatch_frame = s_currentFrame;
+    Core::DisplayMessage(
+        fmt::format("Movie desync: RAM differs from the recording on frame {}", s_currentFrame),
+        5000);
+  }
+}
+
+// NOTE: CPU Thread
+static void UpdateSeekIndex()
+{
+  const u32 ram_hash_interval = Config::Get(Config::MAIN_MOVIE_RAM_HASH_INTERVAL);
+  if (ram_hash_interval != 0 && s_currentFrame % ram_hash_interval == 0)
+    s_seek_index.AddRAMHash(s_currentFrame, s_currentByte, HashRAM());
+
+  const u32 keyframe_interval = Config::Get(Config::MAIN_MOVIE_KEYFRAME_INTERVAL);
+  if (keyframe_interval == 0 || s_currentFrame % keyframe_interval != 0)
+    return;
+
+  // Savestates can't be made from inside FrameUpdate, so make the keyframe once the CPU thread
+  // gets back to a point where it can be paused. The frame counter may have moved on by then.
+  Core::QueueHostJob([] {
+    Core::RunOnCPUThread(
+        [] {
+          if (!IsRecordingInput())
+            return;
+
+          std::vector<u8> state;
+          State::SaveToBuffer(state);
+          s_seek_index.AddKeyframe(s_currentFrame, s_currentInputCount, s_currentByte,
+                                   std::move(state));
+        },
+        true);
+  });
+}
+
 void FrameUpdate()
 {
   s_currentFrame++;
@@ -230,6 +308,11 @@ void FrameUpdate()
   {
     s_totalFrames = s_currentFrame;
     s_totalLagCount = s_currentLagCount;
+    UpdateSeekIndex();
+  }
+  else if (IsPlayingInput())
+  {
+    CheckRAMHash();
   }
 
   s_bPolled = false;
@@ -596,7 +679,8 @@ bool BeginRecordingInput(const ControllerTypeArray& controllers,
 
     s_playMode = PlayMode::Recording;
     s_author = Config::Get(Config::MAIN_MOVIE_MOVIE_AUTHOR);
-    s_temp_input.clear();
+    s_input_log.Clear();
+    s_seek_index.Clear();
 
     s_currentByte = 0;
 
@@ -877,8 +961,9 @@ void RecordInput(const GCPadStatus* PadStatus, int controllerID)
 
   CheckPadStatus(PadStatus, controllerID);
 
-  s_temp_input.resize(s_currentByte + sizeof(ControllerState));
-  memcpy(&s_temp_input[s_currentByte], &s_padState, sizeof(ControllerState));
+  // Anything after the current input is from before a rerecord
+  s_input_log.Resize(s_currentByte);
+  s_input_log.Write(s_currentByte, &s_padState, sizeof(ControllerState));
   s_currentByte += sizeof(ControllerState);
 }
 
@@ -898,9 +983,9 @@ void RecordWiimote(int wiimote, const u8* data, u8 size)
     return;
 
   InputUpdate();
-  s_temp_input.resize(s_currentByte + size + 1);
-  s_temp_input[s_currentByte++] = size;
-  memcpy(&s_temp_input[s_currentByte], data, size);
+  s_input_log.Resize(s_currentByte);
+  s_input_log.Write(s_currentByte++, &size, sizeof(size));
+  s_input_log.Write(s_currentByte, data, size);
   s_currentByte += size;
 }
 
@@ -959,6 +1044,13 @@ bool PlayInput(const std::string& movie_path, std::optional<std::string>* savest
     return false;
   }
 
+  recording_file.Close();
+  if (!s_input_log.Load(movie_path))
+  {
+    PanicAlertFmtT("Failed to read {0}", movie_path);
+    return false;
+  }
+
   ReadHeader();
   s_totalFrames = tmpHeader.frameCount;
   s_totalLagCount = tmpHeader.lagCount;
@@ -975,10 +1067,14 @@ bool PlayInput(const std::string& movie_path, std::optional<std::string>* savest
 
   Core::UpdateWantDeterminism();
 
-  s_temp_input.resize(recording_file.GetSize() - 256);
-  recording_file.ReadBytes(s_temp_input.data(), s_temp_input.size());
   s_currentByte = 0;
-  recording_file.Close();
+
+  const std::string index_path = movie_path + ".idx";
+  if (!File::Exists(index_path) || !s_seek_index.Load(index_path))
+    s_seek_index.Clear();
+
+  s_ram_hash_results = {};
+  s_ram_hash_results.total = s_seek_index.GetRAMHashCount();
 
   // Load savestate (and skip to frame data)
   if (tmpHeader.bFromSaveState && savestate_path)
@@ -1002,6 +1098,26 @@ bool PlayInput(const std::string& movie_path, std::optional<std::string>* savest
   return true;
 }
 
+RAMHashResults GetRAMHashResults()
+{
+  return s_ram_hash_results;
+}
+
+// NOTE: Host Thread
+std::optional<u64> SeekToFrame(u64 frame)
+{
+  if (!IsPlayingInput())
+    return std::nullopt;
+
+  std::optional<SeekIndex::Keyframe> keyframe = s_seek_index.ReadKeyframe(frame);
+  if (!keyframe)
+    return std::nullopt;
+
+  // The keyframe has the movie state in it, so playback carries on from there
+  State::LoadFromBuffer(keyframe->state);
+  return keyframe->entry.frame;
+}
+
 void DoState(PointerWrap& p)
 {
   // many of these could be useful to save even when no movie is active,
@@ -1015,6 +1131,47 @@ void DoState(PointerWrap& p)
   // other variables (such as s_totalBytes and s_totalFrames) are set in LoadInput
 }
 
+// Compares the first size bytes of input in the log and in the given DTM file, and returns the
+// offset of the first difference.
+static std::optional<u64> FindInputMismatch(File::IOFile& file, u64 size)
+{
+  std::vector<u8> file_input(InputLog::BLOCK_SIZE);
+  std::vector<u8> log_input(InputLog::BLOCK_SIZE);
+
+  file.Seek(sizeof(DTMHeader), File::SeekOrigin::Begin);
+  for (u64 offset = 0; offset < size; offset += file_input.size())
+  {
+    const size_t chunk_size = static_cast<size_t>(std::min<u64>(size - offset, file_input.size()));
+    if (!file.ReadBytes(file_input.data(), chunk_size) ||
+        !s_input_log.Read(offset, log_input.data(), chunk_size))
+    {
+      return offset;
+    }
+
+    const auto result =
+        std::mismatch(file_input.begin(), file_input.begin() + chunk_size, log_input.begin());
+    if (result.first != file_input.begin() + chunk_size)
+      return offset + static_cast<u64>(result.first - file_input.begin());
+  }
+
+  return std::nullopt;
+}
+
+// Replaces the input in the log from start to end with the input in the given DTM file.
+static void CopyInputFromFile(File::IOFile& file, u64 start, u64 end)
+{
+  std::vector<u8> buffer(InputLog::BLOCK_SIZE);
+
+  file.Seek(sizeof(DTMHeader) + start, File::SeekOrigin::Begin);
+  for (u64 offset = start; offset < end; offset += buffer.size())
+  {
+    const size_t chunk_size = static_cast<size_t>(std::min<u64>(end - offset, buffer.size()));
+    if (!file.ReadBytes(buffer.data(), chunk_size))
+      return;
+    s_input_log.Write(offset, buffer.data(), chunk_size);
+  }
+}
+
 // NOTE: Host Thread
 void LoadInput(const std::string& movie_path)
 {
@@ -1060,48 +1217,59 @@ void LoadInput(const std::string& movie_path)
     afterEnd = true;
   }
 
-  if (!s_bReadOnly || s_temp_input.empty())
+  if (!s_bReadOnly || s_input_log.IsEmpty())
   {
     s_totalFrames = tmpHeader.frameCount;
     s_totalLagCount = tmpHeader.lagCount;
     s_totalInputCount = tmpHeader.inputCount;
     s_totalTickCount = s_tickCountAtLastInput = tmpHeader.tickCount;
 
-    s_temp_input.resize(static_cast<size_t>(totalSavedBytes));
-    t_record.ReadBytes(s_temp_input.data(), s_temp_input.size());
+    // The savestate's movie may be from another take than the one being recorded, so the index is
+    // only kept up to the first input that differs, and the input after the savestate is going to
+    // be rerecorded.
+    if (!s_bReadOnly)
+    {
+      const u64 common_size = std::min(s_input_log.GetSize(), totalSavedBytes);
+      const u64 mismatch = FindInputMismatch(t_record, common_size).value_or(common_size);
+      s_seek_index.Truncate(std::min(mismatch, s_currentByte));
+    }
+
+    t_record.Flush();
+    if (!s_input_log.Load(movie_path))
+    {
+      PanicAlertFmtT("Failed to read {0}", movie_path);
+      EndPlayInput(false);
+      return;
+    }
   }
   else if (s_currentByte > 0)
   {
     if (s_currentByte > totalSavedBytes)
     {
     }
-    else if (s_currentByte > s_temp_input.size())
+    else if (s_currentByte > s_input_log.GetSize())
     {
       afterEnd = true;
       PanicAlertFmtT(
           "Warning: You loaded a save that's after the end of the current movie. (byte {0} "
           "> {1}) (input {2} > {3}). You should load another save before continuing, or load "
           "this state with read-only mode off.",
-          s_currentByte + 256, s_temp_input.size() + 256, s_currentInputCount, s_totalInputCount);
+          s_currentByte + 256, s_input_log.GetSize() + 256, s_currentInputCount,
+          s_totalInputCount);
     }
-    else if (s_currentByte > 0 && !s_temp_input.empty())
+    else if (s_currentByte > 0 && !s_input_log.IsEmpty())
     {
       // verify identical from movie start to the save's current frame
-      std::vector<u8> movInput(s_currentByte);
-      t_record.ReadArray(movInput.data(), movInput.size());
+      const std::optional<u64> mismatch_index = FindInputMismatch(t_record, s_currentByte);
 
-      const auto result = std::mismatch(movInput.begin(), movInput.end(), s_temp_input.begin());
-
-      if (result.first != movInput.end())
+      if (mismatch_index)
       {
-        const ptrdiff_t mismatch_index = std::distance(movInput.begin(), result.first);
-
         // this is a "you did something wrong" alert for the user's benefit.
         // we'll try to say what's going on in excruciating detail, otherwise the user might not
         // believe us.
         if (IsUsingWiimote(0))
         {
-          const size_t byte_offset = static_cast<size_t>(mismatch_index) + sizeof(DTMHeader);
+          const u64 byte_offset = *mismatch_index + sizeof(DTMHeader);
 
           // TODO: more detail
           PanicAlertFmtT("Warning: You loaded a save whose movie mismatches on byte {0} ({1:#x}). "
@@ -1109,16 +1277,18 @@ void LoadInput(const std::string& movie_path)
                          "read-only mode off. Otherwise you'll probably get a desync.",
                          byte_offset, byte_offset);
 
-          std::copy(movInput.begin(), movInput.end(), s_temp_input.begin());
+          CopyInputFromFile(t_record, *mismatch_index, s_currentByte);
         }
         else
         {
-          const ptrdiff_t frame = mismatch_index / sizeof(ControllerState);
+          const u64 frame = *mismatch_index / sizeof(ControllerState);
           ControllerState curPadState;
-          memcpy(&curPadState, &s_temp_input[frame * sizeof(ControllerState)],
-                 sizeof(ControllerState));
-          ControllerState movPadState;
-          memcpy(&movPadState, &movInput[frame * sizeof(ControllerState)], sizeof(ControllerState));
+          s_input_log.Read(frame * sizeof(ControllerState), &curPadState,
+                           sizeof(ControllerState));
+          ControllerState movPadState{};
+          t_record.Seek(sizeof(DTMHeader) + frame * sizeof(ControllerState),
+                        File::SeekOrigin::Begin);
+          t_record.ReadArray(&movPadState, 1);
           PanicAlertFmtT(
               "Warning: You loaded a save whose movie mismatches on frame {0}. You should load "
               "another save before continuing, or load this state with read-only mode off. "
@@ -1183,7 +1353,7 @@ void LoadInput(const std::string& movie_path)
 // NOTE: CPU Thread
 static void CheckInputEnd()
 {
-  if (s_currentByte >= s_temp_input.size() ||
+  if (s_currentByte >= s_input_log.GetSize() ||
       (CoreTiming::GetTicks() > s_totalTickCount && !IsRecordingInputFromSaveState()))
   {
     EndPlayInput(!s_bReadOnly);
@@ -1195,18 +1365,17 @@ void PlayController(GCPadStatus* PadStatus, int controllerID)
 {
   // Correct playback is entirely dependent on the emulator polling the controllers
   // in the same order done during recording
-  if (!IsPlayingInput() || !IsUsingPad(controllerID) || s_temp_input.empty())
+  if (!IsPlayingInput() || !IsUsingPad(controllerID) || s_input_log.IsEmpty())
     return;
 
-  if (s_currentByte + sizeof(ControllerState) > s_temp_input.size())
+  if (!s_input_log.Read(s_currentByte, &s_padState, sizeof(ControllerState)))
   {
     PanicAlertFmtT("Premature movie end in PlayController. {0} + {1} > {2}", s_currentByte,
-                   sizeof(ControllerState), s_temp_input.size());
+                   sizeof(ControllerState), s_input_log.GetSize());
     EndPlayInput(!s_bReadOnly);
     return;
   }
 
-  memcpy(&s_padState, &s_temp_input[s_currentByte], sizeof(ControllerState));
   s_currentByte += sizeof(ControllerState);
 
   PadStatus->isConnected = s_padState.is_connected;
@@ -1281,19 +1450,19 @@ void PlayController(GCPadStatus* PadStatus, int controllerID)
 bool PlayWiimote(int wiimote, WiimoteCommon::DataReportBuilder& rpt, int ext,
                  const EncryptionKey& key)
 {
-  if (!IsPlayingInput() || !IsUsingWiimote(wiimote) || s_temp_input.empty())
+  if (!IsPlayingInput() || !IsUsingWiimote(wiimote) || s_input_log.IsEmpty())
     return false;
 
-  if (s_currentByte > s_temp_input.size())
+  u8 sizeInMovie;
+  if (!s_input_log.Read(s_currentByte, &sizeInMovie, sizeof(sizeInMovie)))
   {
     PanicAlertFmtT("Premature movie end in PlayWiimote. {0} > {1}", s_currentByte,
-                   s_temp_input.size());
+                   s_input_log.GetSize());
     EndPlayInput(!s_bReadOnly);
     return false;
   }
 
   const u8 size = rpt.GetDataSize();
-  const u8 sizeInMovie = s_temp_input[s_currentByte];
 
   if (size != sizeInMovie)
   {
@@ -1310,15 +1479,14 @@ bool PlayWiimote(int wiimote, WiimoteCommon::DataReportBuilder& rpt, int ext,
 
   s_currentByte++;
 
-  if (s_currentByte + size > s_temp_input.size())
+  if (!s_input_log.Read(s_currentByte, rpt.GetDataPtr(), size))
   {
     PanicAlertFmtT("Premature movie end in PlayWiimote. {0} + {1} > {2}", s_currentByte, size,
-                   s_temp_input.size());
+                   s_input_log.GetSize());
     EndPlayInput(!s_bReadOnly);
     return false;
   }
 
-  memcpy(rpt.GetDataPtr(), &s_temp_input[s_currentByte], size);
   s_currentByte += size;
 
   s_currentInputCount++;
@@ -1360,9 +1528,8 @@ void EndPlayInput(bool cont)
 }
 
 // NOTE: Save State + Host Thread
-void SaveRecording(const std::string& filename)
+void SaveRecording(const std::string& filename, bool save_seek_index)
 {
-  File::IOFile save_record(filename, "wb");
   // Create the real header now and write it
   DTMHeader header;
   memset(&header, 0, sizeof(DTMHeader));
@@ -1410,9 +1577,14 @@ void SaveRecording(const std::string& filename)
   header.uniqueID = 0;
   // header.audioEmulator;
 
-  save_record.WriteArray(&header, 1);
+  bool success = s_input_log.Save(filename, &header, sizeof(header));
 
-  bool success = save_record.WriteBytes(s_temp_input.data(), s_temp_input.size());
+  // An index is only written if there is something in it, but an old one must not be left behind
+  const std::string index_path = filename + ".idx";
+  if (success && save_seek_index && !s_seek_index.IsEmpty())
+    success = s_seek_index.Save(index_path);
+  else if (success && save_seek_index && File::Exists(index_path))
+    File::Delete(index_path);
 
   if (success && s_bRecordingFromSaveState)
   {
@@ -1577,6 +1749,7 @@ static void GetMD5()
 void Shutdown()
 {
   s_currentInputCount = s_totalInputCount = s_totalFrames = s_tickCountAtLastInput = 0;
-  s_temp_input.clear();
+  s_input_log.Clear();
+  s_seek_index.Clear();
 }
 }  // namespace Movie
@@ -189,7 +189,22 @@ void PlayController(GCPadStatus* PadStatus, int controllerID);
 bool PlayWiimote(int wiimote, WiimoteCommon::DataReportBuilder& rpt, int ext,
                  const WiimoteEmu::EncryptionKey& key);
 void EndPlayInput(bool cont);
-void SaveRecording(const std::string& filename);
+struct RAMHashResults
+{
+  // Number of RAM hashes stored in the movie's seek index
+  u64 total = 0;
+  u64 checked = 0;
+  u64 mismatched = 0;
+  std::optional<u64> first_mismatch_frame;
+};
+
+// How playback of the current or last movie compared to the RAM hashes taken while recording it
+RAMHashResults GetRAMHashResults();
+// Jumps to the last keyframe at or before the given frame during playback. Returns the frame that
+// was jumped to, or nothing if there is no such keyframe.
+std::optional<u64> SeekToFrame(u64 frame);
+// Savestates don't save the seek index, since only the input is needed to load them.
+void SaveRecording(const std::string& filename, bool save_seek_index = true);
 void DoState(PointerWrap& p);
 void Shutdown();
 void CheckPadStatus(const GCPadStatus* PadStatus, int controllerID);
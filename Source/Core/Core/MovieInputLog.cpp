@@ -0,0 +1,290 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/MovieInputLog.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+
+namespace Movie
+{
+InputLog::InputLog(std::string cache_file_name, u64 data_offset)
+    : m_cache_file_name(std::move(cache_file_name)), m_data_offset(data_offset)
+{
+}
+
+InputLog::~InputLog()
+{
+  WaitForWrites();
+}
+
+const std::string& InputLog::GetPath()
+{
+  // The user directory isn't known yet when the log is constructed
+  if (m_path.empty())
+  {
+    m_path = File::GetUserPath(D_CACHE_IDX) + m_cache_file_name;
+    File::CreateFullPath(m_path);
+  }
+
+  return m_path;
+}
+
+bool InputLog::OpenFile(bool truncate)
+{
+  return m_file.Open(GetPath(), truncate ? "w+b" : "r+b");
+}
+
+bool InputLog::Load(const std::string& path)
+{
+  std::lock_guard lk(m_mutex);
+  WaitForWrites();
+  m_blocks.clear();
+  m_size = 0;
+
+  std::lock_guard file_lk(m_file_mutex);
+  m_file.Close();
+
+  // The movie is copied rather than read directly, so that it can be modified and overwritten
+  // without affecting the log
+  if (!File::Copy(path, GetPath()) || !OpenFile(false) || m_file.GetSize() < m_data_offset)
+  {
+    ERROR_LOG_FMT(CORE, "Failed to load movie input from {}", path);
+    m_file.Close();
+    return false;
+  }
+
+  m_size = m_file.GetSize() - m_data_offset;
+  return true;
+}
+
+void InputLog::Clear()
+{
+  std::lock_guard lk(m_mutex);
+  WaitForWrites();
+  m_blocks.clear();
+  m_size = 0;
+
+  std::lock_guard file_lk(m_file_mutex);
+  if (m_file.IsOpen())
+  {
+    m_file.Close();
+    File::Delete(m_path);
+  }
+}
+
+u64 InputLog::GetSize() const
+{
+  std::lock_guard lk(m_mutex);
+  return m_size;
+}
+
+bool InputLog::IsEmpty() const
+{
+  return GetSize() == 0;
+}
+
+bool InputLog::Read(u64 offset, void* data, u64 size)
+{
+  std::lock_guard lk(m_mutex);
+  if (offset > m_size || size > m_size - offset)
+    return false;
+
+  u8* out = static_cast<u8*>(data);
+  while (size > 0)
+  {
+    const u64 offset_in_block = offset % BLOCK_SIZE;
+    const u64 bytes_to_copy = std::min(size, BLOCK_SIZE - offset_in_block);
+
+    const Block* block = GetBlock(offset / BLOCK_SIZE);
+    std::memcpy(out, block->data->data() + offset_in_block, bytes_to_copy);
+
+    out += bytes_to_copy;
+    offset += bytes_to_copy;
+    size -= bytes_to_copy;
+  }
+
+  return true;
+}
+
+void InputLog::Write(u64 offset, const void* data, u64 size)
+{
+  std::lock_guard lk(m_mutex);
+  m_size = std::max(m_size, offset + size);
+
+  const u8* in = static_cast<const u8*>(data);
+  while (size > 0)
+  {
+    const u64 offset_in_block = offset % BLOCK_SIZE;
+    const u64 bytes_to_copy = std::min(size, BLOCK_SIZE - offset_in_block);
+
+    Block* block = GetBlock(offset / BLOCK_SIZE);
+    std::memcpy(block->data->data() + offset_in_block, in, bytes_to_copy);
+    block->dirty = true;
+
+    in += bytes_to_copy;
+    offset += bytes_to_copy;
+    size -= bytes_to_copy;
+  }
+}
+
+void InputLog::Resize(u64 new_size)
+{
+  std::lock_guard lk(m_mutex);
+  if (new_size < m_size)
+  {
+    // Make sure that none of the discarded data can come back if the log grows again
+    WaitForWrites();
+
+    for (auto it = m_blocks.begin(); it != m_blocks.end();)
+      it = it->first * BLOCK_SIZE >= new_size ? m_blocks.erase(it) : std::next(it);
+
+    const auto tail = m_blocks.find(new_size / BLOCK_SIZE);
+    if (tail != m_blocks.end())
+    {
+      std::fill(tail->second.data->begin() + new_size % BLOCK_SIZE, tail->second.data->end(), 0);
+      tail->second.dirty = true;
+    }
+
+    std::lock_guard file_lk(m_file_mutex);
+    if (m_file.IsOpen())
+      m_file.Resize(m_data_offset + new_size);
+  }
+
+  m_size = new_size;
+}
+
+bool InputLog::Save(const std::string& path, const void* header, u64 header_size)
+{
+  std::lock_guard lk(m_mutex);
+  WaitForWrites();
+
+  for (auto& [index, block] : m_blocks)
+  {
+    if (block.dirty)
+    {
+      WriteBlock(index, *block.data);
+      block.dirty = false;
+    }
+  }
+
+  bool success;
+  {
+    std::lock_guard file_lk(m_file_mutex);
+    if (!m_file.IsOpen() && !OpenFile(true))
+      return false;
+
+    const u64 header_bytes = std::min(header_size, m_data_offset);
+    success = m_file.Seek(0, File::SeekOrigin::Begin) && m_file.WriteBytes(header, header_bytes) &&
+              m_file.Flush() && m_file.Resize(m_data_offset + m_size);
+  }
+
+  return success && File::Copy(m_path, path);
+}
+
+InputLog::Block* InputLog::GetBlock(u64 index)
+{
+  auto it = m_blocks.find(index);
+  if (it == m_blocks.end())
+  {
+    if (m_blocks.size() >= MAX_RESIDENT_BLOCKS)
+      EvictBlock();
+
+    Block block;
+    block.data = std::make_shared<std::vector<u8>>(BLOCK_SIZE);
+
+    bool found = false;
+    {
+      std::lock_guard lk(m_pending_mutex);
+      const auto pending = m_pending.find(index);
+      if (pending != m_pending.end())
+      {
+        *block.data = *pending->second;
+        found = true;
+      }
+    }
+
+    if (!found)
+    {
+      // Anything that hasn't been written to the file yet reads as zeroes
+      std::lock_guard lk(m_file_mutex);
+      if (m_file.IsOpen() &&
+          m_file.Seek(m_data_offset + index * BLOCK_SIZE, File::SeekOrigin::Begin))
+      {
+        m_file.ReadArray(block.data->data(), BLOCK_SIZE);
+        m_file.ClearError();
+      }
+    }
+
+    it = m_blocks.emplace(index, std::move(block)).first;
+  }
+
+  it->second.last_use = ++m_use_counter;
+  return &it->second;
+}
+
+void InputLog::EvictBlock()
+{
+  const auto it =
+      std::min_element(m_blocks.begin(), m_blocks.end(), [](const auto& a, const auto& b) {
+        return a.second.last_use < b.second.last_use;
+      });
+
+  if (it->second.dirty)
+  {
+    if (!m_writer_started)
+    {
+      m_writer.Reset([this](WriteRequest request) {
+        WriteBlock(request.index, *request.data);
+
+        {
+          std::lock_guard lk(m_pending_mutex);
+          const auto pending = m_pending.find(request.index);
+          if (pending != m_pending.end() && pending->second == request.data)
+            m_pending.erase(pending);
+        }
+        m_pending_written.notify_all();
+      });
+      m_writer_started = true;
+    }
+
+    std::shared_ptr<const std::vector<u8>> data = std::move(it->second.data);
+    {
+      std::lock_guard lk(m_pending_mutex);
+      m_pending[it->first] = data;
+    }
+    m_writer.EmplaceItem(WriteRequest{it->first, std::move(data)});
+  }
+
+  m_blocks.erase(it);
+}
+
+void InputLog::WriteBlock(u64 index, const std::vector<u8>& data)
+{
+  std::lock_guard lk(m_file_mutex);
+
+  if (!m_file.IsOpen() && !OpenFile(true))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to create {}", m_path);
+    return;
+  }
+
+  if (!m_file.Seek(m_data_offset + index * BLOCK_SIZE, File::SeekOrigin::Begin) ||
+      !m_file.WriteBytes(data.data(), data.size()))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to write movie input to {}", m_path);
+    m_file.ClearError();
+  }
+}
+
+void InputLog::WaitForWrites()
+{
+  std::unique_lock lk(m_pending_mutex);
+  m_pending_written.wait(lk, [&] { return m_pending.empty(); });
+}
+}  // namespace Movie
@@ -0,0 +1,101 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/WorkQueueThread.h"
+
+namespace Movie
+{
+// The input data of a movie, stored in a file in the cache directory. Only a limited number of
+// recently used blocks are kept in memory, so memory usage doesn't grow with the length of the
+// movie. Modified blocks are written back to the file on a background thread when they are evicted.
+//
+// The file is laid out like a DTM file, with data_offset bytes of room for the header at the
+// start, so saving a movie only takes writing the header and copying the file.
+//
+// Thread-safe, since savestates save the movie on their own thread while the CPU thread keeps
+// recording.
+class InputLog
+{
+public:
+  static constexpr u64 BLOCK_SIZE = 0x10000;
+
+  InputLog(std::string cache_file_name, u64 data_offset);
+  ~InputLog();
+
+  InputLog(const InputLog&) = delete;
+  InputLog& operator=(const InputLog&) = delete;
+
+  // Replaces the contents with the data that follows the header in the given file.
+  bool Load(const std::string& path);
+  void Clear();
+
+  u64 GetSize() const;
+  bool IsEmpty() const;
+
+  // Returns false if the range isn't inside the log.
+  bool Read(u64 offset, void* data, u64 size);
+  // Overwrites data, growing the log if the range ends past the end.
+  void Write(u64 offset, const void* data, u64 size);
+  // Discards data past new_size, or adds zeroes up to it.
+  void Resize(u64 new_size);
+
+  // Writes the given header followed by the contents of the log to path.
+  bool Save(const std::string& path, const void* header, u64 header_size);
+
+private:
+  static constexpr size_t MAX_RESIDENT_BLOCKS = 16;
+
+  struct Block
+  {
+    std::shared_ptr<std::vector<u8>> data;
+    bool dirty = false;
+    u64 last_use = 0;
+  };
+
+  struct WriteRequest
+  {
+    u64 index;
+    std::shared_ptr<const std::vector<u8>> data;
+  };
+
+  const std::string& GetPath();
+  bool OpenFile(bool truncate);
+  Block* GetBlock(u64 index);
+  void EvictBlock();
+  void WriteBlock(u64 index, const std::vector<u8>& data);
+  void WaitForWrites();
+
+  const std::string m_cache_file_name;
+  const u64 m_data_offset;
+  std::string m_path;
+
+  // Guards everything but the file, which is also used by the writer thread
+  mutable std::mutex m_mutex;
+  u64 m_size = 0;
+  u64 m_use_counter = 0;
+  std::map<u64, Block> m_blocks;
+
+  std::mutex m_file_mutex;
+  File::IOFile m_file;
+
+  // Evicted blocks that haven't been written to the file yet
+  std::mutex m_pending_mutex;
+  std::condition_variable m_pending_written;
+  std::map<u64, std::shared_ptr<const std::vector<u8>>> m_pending;
+
+  // Started the first time a block is evicted
+  Common::WorkQueueThread<WriteRequest> m_writer;
+  bool m_writer_started = false;
+};
+}  // namespace Movie
@@ -0,0 +1,368 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/MovieSeekIndex.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include <zstd.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+
+namespace Movie
+{
+namespace
+{
+#pragma pack(push, 1)
+struct IndexHeader
+{
+  u32 magic;
+  u32 version;
+  u64 entry_count;
+  u64 ram_hash_count;
+};
+static_assert(sizeof(IndexHeader) == 24);
+#pragma pack(pop)
+
+constexpr u32 INDEX_MAGIC = 0x494D5444;  // "DTMI"
+constexpr u32 INDEX_VERSION = 3;
+
+// Keyframes are written while recording, so compression has to be fast
+constexpr int KEYFRAME_ZSTD_LEVEL = 1;
+}  // namespace
+
+SeekIndex::SeekIndex(std::string cache_file_name) : m_cache_file_name(std::move(cache_file_name))
+{
+}
+
+SeekIndex::~SeekIndex()
+{
+  WaitForKeyframes();
+}
+
+void SeekIndex::Clear()
+{
+  WaitForKeyframes();
+
+  {
+    std::lock_guard lk(m_entries_mutex);
+    m_entries.clear();
+    m_ram_hashes.clear();
+    m_loaded_path.clear();
+  }
+
+  std::lock_guard lk(m_file_mutex);
+  if (m_cache_file.IsOpen())
+  {
+    m_cache_file.Close();
+    File::Delete(m_cache_path);
+  }
+}
+
+bool SeekIndex::Load(const std::string& path)
+{
+  Clear();
+
+  File::IOFile file(path, "rb");
+  const u64 file_size = file.GetSize();
+
+  IndexHeader header;
+  if (!file.ReadArray(&header, 1) || header.magic != INDEX_MAGIC ||
+      header.version != INDEX_VERSION ||
+      header.entry_count > (file_size - sizeof(header)) / sizeof(Entry) ||
+      header.ram_hash_count >
+          (file_size - sizeof(header) - header.entry_count * sizeof(Entry)) / sizeof(RAMHash))
+  {
+    WARN_LOG_FMT(CORE, "Ignoring invalid movie index {}", path);
+    return false;
+  }
+
+  std::vector<Entry> entries(header.entry_count);
+  std::vector<RAMHash> ram_hashes(header.ram_hash_count);
+  if (!file.ReadArray(entries.data(), entries.size()) ||
+      !file.ReadArray(ram_hashes.data(), ram_hashes.size()))
+  {
+    WARN_LOG_FMT(CORE, "Failed to read movie index {}", path);
+    return false;
+  }
+
+  std::lock_guard lk(m_entries_mutex);
+  m_entries.reserve(entries.size());
+  for (const Entry& entry : entries)
+  {
+    if (entry.keyframe_size == 0 || entry.keyframe_offset > file_size ||
+        entry.keyframe_size > file_size - entry.keyframe_offset)
+    {
+      continue;
+    }
+
+    if (m_entries.empty() || entry.frame > m_entries.back().entry.frame)
+      m_entries.push_back(StoredEntry{entry, false, 0});
+  }
+  for (const RAMHash& ram_hash : ram_hashes)
+  {
+    if (m_ram_hashes.empty() || ram_hash.frame > m_ram_hashes.back().frame)
+      m_ram_hashes.push_back(ram_hash);
+  }
+  m_loaded_path = path;
+
+  return true;
+}
+
+bool SeekIndex::Save(const std::string& path)
+{
+  WaitForKeyframes();
+
+  // Keyframes which failed to be stored have no data to save
+  std::vector<StoredEntry> entries;
+  std::vector<RAMHash> ram_hashes;
+  {
+    std::lock_guard lk(m_entries_mutex);
+    std::copy_if(m_entries.begin(), m_entries.end(), std::back_inserter(entries),
+                 [](const StoredEntry& e) { return e.entry.keyframe_size != 0; });
+    ram_hashes = m_ram_hashes;
+  }
+
+  // The keyframes are laid out in the same order as the entries, after the RAM hashes
+  std::vector<Entry> saved_entries(entries.size());
+  u64 keyframe_offset =
+      sizeof(IndexHeader) + entries.size() * sizeof(Entry) + ram_hashes.size() * sizeof(RAMHash);
+  for (size_t i = 0; i < entries.size(); ++i)
+  {
+    saved_entries[i] = entries[i].entry;
+    saved_entries[i].keyframe_offset = keyframe_offset;
+    keyframe_offset += saved_entries[i].keyframe_size;
+  }
+
+  // The keyframes may be read from the file being replaced, so write to a new file first
+  const std::string temp_path = path + ".tmp";
+  bool success;
+  {
+    File::IOFile file(temp_path, "wb");
+    const IndexHeader header{INDEX_MAGIC, INDEX_VERSION, saved_entries.size(), ram_hashes.size()};
+    success = file.WriteArray(&header, 1) &&
+              file.WriteArray(saved_entries.data(), saved_entries.size()) &&
+              file.WriteArray(ram_hashes.data(), ram_hashes.size());
+
+    std::vector<u8> keyframe;
+    for (size_t i = 0; success && i < entries.size(); ++i)
+    {
+      success = ReadCompressedKeyframe(entries[i], &keyframe) &&
+                file.WriteBytes(keyframe.data(), keyframe.size());
+    }
+  }
+
+  if (!success || !File::Rename(temp_path, path))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to save movie index to {}", path);
+    File::Delete(temp_path);
+    return false;
+  }
+
+  // If the loaded file was replaced, its keyframes have moved
+  std::lock_guard lk(m_entries_mutex);
+  if (path == m_loaded_path)
+  {
+    for (StoredEntry& stored_entry : m_entries)
+    {
+      if (stored_entry.in_cache || stored_entry.entry.keyframe_size == 0)
+        continue;
+
+      const u64 frame = stored_entry.entry.frame;
+      const auto it = std::find_if(saved_entries.begin(), saved_entries.end(),
+                                   [&](const Entry& e) { return e.frame == frame; });
+      if (it != saved_entries.end())
+        stored_entry.entry.keyframe_offset = it->keyframe_offset;
+    }
+  }
+
+  return true;
+}
+
+bool SeekIndex::IsEmpty() const
+{
+  std::lock_guard lk(m_entries_mutex);
+  return m_entries.empty() && m_ram_hashes.empty();
+}
+
+void SeekIndex::AddKeyframe(u64 frame, u64 input_count, u64 byte_offset, std::vector<u8> state)
+{
+  if (!m_writer_started)
+  {
+    m_writer.Reset([this](KeyframeRequest request) { StoreKeyframe(request); });
+    m_writer_started = true;
+  }
+
+  const u64 id = m_next_keyframe_id++;
+
+  // The entry doesn't get a keyframe size until the keyframe has been stored
+  const Entry entry{frame, input_count, byte_offset, 0, 0, static_cast<u32>(state.size())};
+  Insert(StoredEntry{entry, true, id});
+
+  {
+    std::lock_guard lk(m_pending_mutex);
+    ++m_pending_keyframes;
+  }
+  m_writer.EmplaceItem(KeyframeRequest{id, std::move(state)});
+}
+
+void SeekIndex::AddRAMHash(u64 frame, u64 byte_offset, u64 hash)
+{
+  std::lock_guard lk(m_entries_mutex);
+  while (!m_ram_hashes.empty() && m_ram_hashes.back().frame >= frame)
+    m_ram_hashes.pop_back();
+  m_ram_hashes.push_back(RAMHash{frame, byte_offset, hash});
+}
+
+void SeekIndex::Truncate(u64 byte_offset)
+{
+  std::lock_guard lk(m_entries_mutex);
+  while (!m_entries.empty() && m_entries.back().entry.byte_offset > byte_offset)
+    m_entries.pop_back();
+  while (!m_ram_hashes.empty() && m_ram_hashes.back().byte_offset > byte_offset)
+    m_ram_hashes.pop_back();
+}
+
+std::optional<u64> SeekIndex::GetRAMHash(u64 frame) const
+{
+  std::lock_guard lk(m_entries_mutex);
+  const auto it = std::lower_bound(m_ram_hashes.begin(), m_ram_hashes.end(), frame,
+                                   [](const RAMHash& h, u64 f) { return h.frame < f; });
+  if (it == m_ram_hashes.end() || it->frame != frame)
+    return std::nullopt;
+  return it->hash;
+}
+
+size_t SeekIndex::GetRAMHashCount() const
+{
+  std::lock_guard lk(m_entries_mutex);
+  return m_ram_hashes.size();
+}
+
+std::optional<SeekIndex::Keyframe> SeekIndex::ReadKeyframe(u64 frame)
+{
+  std::optional<StoredEntry> found;
+  {
+    std::lock_guard lk(m_entries_mutex);
+    const auto it = std::find_if(m_entries.rbegin(), m_entries.rend(), [&](const StoredEntry& e) {
+      return e.entry.frame <= frame && e.entry.keyframe_size != 0;
+    });
+    if (it != m_entries.rend())
+      found = *it;
+  }
+
+  if (!found)
+    return std::nullopt;
+
+  std::vector<u8> compressed;
+  if (!ReadCompressedKeyframe(*found, &compressed))
+    return std::nullopt;
+
+  // The state size comes from the index file, so check it against the compressed data before
+  // allocating that much
+  const unsigned long long content_size =
+      ZSTD_getFrameContentSize(compressed.data(), compressed.size());
+  if (content_size != found->entry.state_size)
+  {
+    ERROR_LOG_FMT(CORE, "Movie keyframe at frame {} is corrupted", found->entry.frame);
+    return std::nullopt;
+  }
+
+  Keyframe keyframe{found->entry, std::vector<u8>(found->entry.state_size)};
+  const size_t size = ZSTD_decompress(keyframe.state.data(), keyframe.state.size(),
+                                      compressed.data(), compressed.size());
+  if (ZSTD_isError(size) || size != keyframe.state.size())
+  {
+    ERROR_LOG_FMT(CORE, "Failed to decompress movie keyframe at frame {}", found->entry.frame);
+    return std::nullopt;
+  }
+
+  return keyframe;
+}
+
+void SeekIndex::Insert(const StoredEntry& entry)
+{
+  std::lock_guard lk(m_entries_mutex);
+  while (!m_entries.empty() && m_entries.back().entry.frame >= entry.entry.frame)
+    m_entries.pop_back();
+  m_entries.push_back(entry);
+}
+
+void SeekIndex::StoreKeyframe(const KeyframeRequest& request)
+{
+  std::vector<u8> compressed(ZSTD_compressBound(request.state.size()));
+  const size_t compressed_size = ZSTD_compress(compressed.data(), compressed.size(),
+                                               request.state.data(), request.state.size(),
+                                               KEYFRAME_ZSTD_LEVEL);
+
+  bool success = !ZSTD_isError(compressed_size);
+  u64 offset = 0;
+  if (success)
+  {
+    std::lock_guard lk(m_file_mutex);
+    if (!m_cache_file.IsOpen())
+    {
+      m_cache_path = File::GetUserPath(D_CACHE_IDX) + m_cache_file_name;
+      File::CreateFullPath(m_cache_path);
+      m_cache_file.Open(m_cache_path, "w+b");
+    }
+
+    success = m_cache_file.Seek(0, File::SeekOrigin::End);
+    offset = m_cache_file.Tell();
+    success = success && m_cache_file.WriteBytes(compressed.data(), compressed_size);
+    if (!success)
+      m_cache_file.ClearError();
+  }
+
+  if (success)
+  {
+    // The entry is gone if the movie was truncated before it in the meantime
+    std::lock_guard lk(m_entries_mutex);
+    const auto it = std::find_if(m_entries.begin(), m_entries.end(), [&](const StoredEntry& e) {
+      return e.in_cache && e.keyframe_id == request.id;
+    });
+    if (it != m_entries.end())
+    {
+      it->entry.keyframe_offset = offset;
+      it->entry.keyframe_size = static_cast<u32>(compressed_size);
+    }
+  }
+  else
+  {
+    ERROR_LOG_FMT(CORE, "Failed to store movie keyframe");
+  }
+
+  {
+    std::lock_guard lk(m_pending_mutex);
+    --m_pending_keyframes;
+  }
+  m_pending_done.notify_all();
+}
+
+bool SeekIndex::ReadCompressedKeyframe(const StoredEntry& entry, std::vector<u8>* data)
+{
+  data->resize(entry.entry.keyframe_size);
+
+  if (!entry.in_cache)
+  {
+    File::IOFile file(m_loaded_path, "rb");
+    return file.Seek(entry.entry.keyframe_offset, File::SeekOrigin::Begin) &&
+           file.ReadBytes(data->data(), data->size());
+  }
+
+  std::lock_guard lk(m_file_mutex);
+  const bool success = m_cache_file.Seek(entry.entry.keyframe_offset, File::SeekOrigin::Begin) &&
+                       m_cache_file.ReadBytes(data->data(), data->size());
+  m_cache_file.ClearError();
+  return success;
+}
+
+void SeekIndex::WaitForKeyframes()
+{
+  std::unique_lock lk(m_pending_mutex);
+  m_pending_done.wait(lk, [&] { return m_pending_keyframes == 0; });
+}
+}  // namespace Movie
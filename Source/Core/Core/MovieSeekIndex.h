@@ -0,0 +1,129 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/WorkQueueThread.h"
+
+namespace Movie
+{
+// Stores savestate keyframes and hashes of guest RAM at some frames of a movie, along with where
+// those frames are in its input data. It is saved next to the movie as <movie>.idx, so that the
+// DTM file itself stays readable by other programs. With keyframes, playback can jump to any point
+// in a long movie by loading the closest keyframe before it instead of replaying from the start.
+// The RAM hashes let playback check that it is still in sync with the recording.
+//
+// Keyframes are compressed and written to a file in the cache directory on a background thread
+// while recording, and read from the index file on demand during playback, so they don't take up
+// memory.
+class SeekIndex
+{
+public:
+#pragma pack(push, 1)
+  struct Entry
+  {
+    u64 frame;
+    u64 input_count;
+    // Offset in the input data, not counting the DTM header
+    u64 byte_offset;
+    // Where the compressed keyframe is stored in the index file. A size of 0 means that it is still
+    // being compressed.
+    u64 keyframe_offset;
+    u32 keyframe_size;
+    u32 state_size;
+  };
+  static_assert(sizeof(Entry) == 40);
+
+  struct RAMHash
+  {
+    u64 frame;
+    u64 byte_offset;
+    u64 hash;
+  };
+  static_assert(sizeof(RAMHash) == 24);
+#pragma pack(pop)
+
+  explicit SeekIndex(std::string cache_file_name);
+  ~SeekIndex();
+
+  SeekIndex(const SeekIndex&) = delete;
+  SeekIndex& operator=(const SeekIndex&) = delete;
+
+  void Clear();
+  bool Load(const std::string& path);
+  bool Save(const std::string& path);
+
+  bool IsEmpty() const;
+
+  // Keyframes and RAM hashes must be added in order. Each replaces any of its kind at the same or
+  // later frames. The state is compressed and stored on a background thread.
+  void AddKeyframe(u64 frame, u64 input_count, u64 byte_offset, std::vector<u8> state);
+  void AddRAMHash(u64 frame, u64 byte_offset, u64 hash);
+  // Drops everything recorded after the given offset in the input data, for when a movie is being
+  // rerecorded from there.
+  void Truncate(u64 byte_offset);
+
+  std::optional<u64> GetRAMHash(u64 frame) const;
+  size_t GetRAMHashCount() const;
+
+  struct Keyframe
+  {
+    Entry entry;
+    std::vector<u8> state;
+  };
+
+  // Reads the last keyframe at or before the given frame. Keyframes that are still being
+  // compressed are skipped.
+  std::optional<Keyframe> ReadKeyframe(u64 frame);
+
+private:
+  struct StoredEntry
+  {
+    Entry entry;
+    // Whether the keyframe is in the cache file rather than the loaded index file
+    bool in_cache;
+    // Tells apart keyframes at the same frame in different takes of a rerecorded movie
+    u64 keyframe_id;
+  };
+
+  struct KeyframeRequest
+  {
+    u64 id;
+    std::vector<u8> state;
+  };
+
+  void Insert(const StoredEntry& entry);
+  void StoreKeyframe(const KeyframeRequest& request);
+  bool ReadCompressedKeyframe(const StoredEntry& entry, std::vector<u8>* data);
+  void WaitForKeyframes();
+
+  const std::string m_cache_file_name;
+
+  mutable std::mutex m_entries_mutex;
+  std::vector<StoredEntry> m_entries;
+  std::vector<RAMHash> m_ram_hashes;
+
+  std::string m_loaded_path;
+
+  std::mutex m_file_mutex;
+  File::IOFile m_cache_file;
+  std::string m_cache_path;
+  u64 m_next_keyframe_id = 1;
+
+  std::mutex m_pending_mutex;
+  std::condition_variable m_pending_done;
+  size_t m_pending_keyframes = 0;
+
+  // Started the first time a keyframe is added
+  Common::WorkQueueThread<KeyframeRequest> m_writer;
+  bool m_writer_started = false;
+};
+}  // namespace Movie
@@ -30,6 +30,7 @@
 #include "Common/SFMLHelper.h"
 #include "Common/StringUtil.h"
 #include "Common/Timer.h"
+#include "Common/Trace.h"
 #include "Common/Version.h"
 
 #include "Core/HW/Memmap.h"
@@ -353,6 +354,7 @@ static void ReceiveSyncIdentifier(sf::Packet& spac, SyncIdentifier& sync_identif
 // called from ---NETPLAY--- thread
 void NetPlayClient::OnData(sf::Packet& packet)
 {
+  TRACE_SCOPE("NetPlayClient::OnData");
   MessageID mid;
   packet >> mid;
 
@@ -1631,6 +1633,7 @@ void NetPlayClient::OnStadiumMsg(sf::Packet& packet)
 
 void NetPlayClient::Send(const sf::Packet& packet, const u8 channel_id)
 {
+  TRACE_SCOPE("NetPlayClient::Send");
   ENetPacket* epac =
       enet_packet_create(packet.getData(), packet.getDataSize(), ENET_PACKET_FLAG_RELIABLE);
   enet_peer_send(m_server, channel_id, epac);
@@ -26,6 +26,7 @@
 #include "Common/MsgHandler.h"
 #include "Common/SFMLHelper.h"
 #include "Common/StringUtil.h"
+#include "Common/Trace.h"
 #include "Common/UPnP.h"
 #include "Common/Version.h"
 
@@ -799,6 +800,7 @@ void NetPlayServer::SendChunkedToClients(sf::Packet&& packet, const PlayerId ski
 // called from ---NETPLAY--- thread
 unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
 {
+  TRACE_SCOPE("NetPlayServer::OnData");
   MessageID mid;
   packet >> mid;
 
@@ -2253,6 +2255,7 @@ void NetPlayServer::SendToClients(const sf::Packet& packet, const PlayerId skip_
 
 void NetPlayServer::Send(ENetPeer* socket, const sf::Packet& packet, const u8 channel_id)
 {
+  TRACE_SCOPE("NetPlayServer::Send");
   ENetPacket* epac =
       enet_packet_create(packet.getData(), packet.getDataSize(), ENET_PACKET_FLAG_RELIABLE);
   enet_peer_send(socket, channel_id, epac);
@@ -3,7 +3,14 @@
 
 #include "Core/PowerPC/JitCommon/JitBase.h"
 
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <xxhash.h>
+
 #include "Common/CommonTypes.h"
+#include "Common/Trace.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -19,7 +26,9 @@ const u8* JitBase::Dispatch(JitBase& jit)
 
 void JitTrampoline(JitBase& jit, u32 em_address)
 {
+  TRACE_SCOPE("JitBase::Jit");
   jit.Jit(em_address);
+  jit.UpdateBlockHistory(em_address);
 }
 
 JitBase::JitBase() : m_code_buffer(code_buffer_size)
@@ -57,6 +66,7 @@ void JitBase::RefreshConfig()
   m_accurate_nans = Config::Get(Config::MAIN_ACCURATE_NANS);
   m_fastmem_enabled = Config::Get(Config::MAIN_FASTMEM);
   m_mmu_enabled = Core::System::GetInstance().IsMMUMode();
+  m_precompile_blocks = Config::Get(Config::MAIN_JIT_PRECOMPILE_BLOCKS);
   analyzer.SetDebuggingEnabled(m_enable_debugging);
   analyzer.SetBranchFollowingEnabled(Config::Get(Config::MAIN_JIT_FOLLOW_BRANCH));
   analyzer.SetFloatExceptionsEnabled(m_enable_float_exceptions);
@@ -96,3 +106,73 @@ bool JitBase::ShouldHandleFPExceptionForInstruction(const PPCAnalyst::CodeOp* op
   else
     return false;
 }
+
+u64 JitBase::HashCodeBlock() const
+{
+  std::vector<u32> data;
+  data.reserve(code_block.m_num_instructions * 2);
+  for (u32 i = 0; i < code_block.m_num_instructions; i++)
+  {
+    data.push_back(m_code_buffer[i].address);
+    data.push_back(m_code_buffer[i].inst.hex);
+  }
+  return XXH64(data.data(), data.size() * sizeof(u32), 0);
+}
+
+void JitBase::UpdateBlockHistory(u32 em_address)
+{
+  if (!m_precompile_blocks || m_enable_debugging || SConfig::GetInstance().bJITNoBlockCache)
+    return;
+
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  if (game_id.empty())
+    return;
+  if (game_id != m_block_history.GetGameID())
+    m_block_history.Open(game_id);
+
+  // code_block still holds the analysis of the block that was just compiled.
+  const u32 msr_bits = MSR.Hex & JitBaseBlockCache::JIT_CACHE_MSR_MASK;
+  if (GetBlockCache()->GetBlockFromStartAddress(em_address, msr_bits))
+    m_block_history.Record({em_address, msr_bits, HashCodeBlock()});
+
+  PrecompileBlocksFromHistory();
+}
+
+void JitBase::PrecompileBlocksFromHistory()
+{
+  // Spread the work over several misses so that a large history doesn't stall a single frame.
+  constexpr u32 MAX_BLOCKS_PER_CALL = 64;
+
+  const u32 msr_bits = MSR.Hex & JitBaseBlockCache::JIT_CACHE_MSR_MASK;
+  u32 num_compiled = 0;
+  while (num_compiled < MAX_BLOCKS_PER_CALL)
+  {
+    const std::optional<JitBlockHistory::Entry> entry = m_block_history.PopPending();
+    if (!entry)
+      break;
+
+    if (GetBlockCache()->GetBlockFromStartAddress(entry->effective_address, entry->msr_bits))
+      continue;
+
+    // Analysis is cheap compared to code generation, and checking the hash against what is in
+    // memory now keeps code from other overlays loaded at the same address from being compiled.
+    if (entry->msr_bits == msr_bits)
+    {
+      analyzer.Analyze(entry->effective_address, &code_block, &m_code_buffer, m_code_buffer.size());
+      if (!code_block.m_memory_exception && HashCodeBlock() == entry->code_hash)
+      {
+        Jit(entry->effective_address);
+        ++num_compiled;
+        continue;
+      }
+    }
+
+    m_block_history.Defer(*entry);
+  }
+}
+
+void JitBase::OnCodeChanged(u32 address, u32 length)
+{
+  if (m_precompile_blocks)
+    m_block_history.OnCodeChanged(address, length);
+}
@@ -14,6 +14,7 @@
 #include "Core/MachineContext.h"
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/JitCommon/JitAsmCommon.h"
+#include "Core/PowerPC/JitCommon/JitBlockHistory.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 
@@ -112,6 +113,8 @@ protected:
   PPCAnalyst::CodeBuffer m_code_buffer;
   PPCAnalyst::PPCAnalyzer analyzer;
 
+  JitBlockHistory m_block_history;
+
   size_t m_registered_config_callback_id;
   bool bJITOff = false;
   bool bJITLoadStoreOff = false;
@@ -134,6 +137,7 @@ protected:
   bool m_accurate_nans = false;
   bool m_fastmem_enabled = false;
   bool m_mmu_enabled = false;
+  bool m_precompile_blocks = false;
 
   void RefreshConfig();
 
@@ -143,6 +147,10 @@ protected:
 
   bool ShouldHandleFPExceptionForInstruction(const PPCAnalyst::CodeOp* op);
 
+  // Hash of the instructions in code_block, as last analyzed.
+  u64 HashCodeBlock() const;
+  void PrecompileBlocksFromHistory();
+
 public:
   JitBase();
   ~JitBase() override;
@@ -159,6 +167,10 @@ public:
   virtual bool HandleFault(uintptr_t access_address, SContext* ctx) = 0;
   virtual bool HandleStackFault() { return false; }
 
+  // Called by the dispatcher after compiling the block at em_address.
+  void UpdateBlockHistory(u32 em_address);
+  void OnCodeChanged(u32 address, u32 length);
+
   static constexpr std::size_t code_buffer_size = 32000;
 
   // This should probably be removed from public:
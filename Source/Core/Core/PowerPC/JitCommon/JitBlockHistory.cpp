@@ -0,0 +1,90 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/JitCommon/JitBlockHistory.h"
+
+#include <algorithm>
+
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+
+constexpr u32 HISTORY_FILE_MAGIC = 0x42544A44;  // "DJTB"
+constexpr u32 HISTORY_FILE_VERSION = 1;
+
+void JitBlockHistory::Open(const std::string& game_id)
+{
+  Close();
+  m_game_id = game_id;
+
+  const std::string filename = File::GetUserPath(D_CACHE_IDX) + game_id + ".jitblocks";
+  const u32 header[2] = {HISTORY_FILE_MAGIC, HISTORY_FILE_VERSION};
+
+  m_file.Open(filename, "rb+");
+  u32 file_header[2];
+  if (m_file.IsOpen() && m_file.ReadArray(file_header, 2) && file_header[0] == header[0] &&
+      file_header[1] == header[1] && (m_file.GetSize() - sizeof(header)) % sizeof(Entry) == 0)
+  {
+    Entry entry;
+    while (m_file.ReadArray(&entry, 1))
+    {
+      if (m_known_entries.emplace(entry.effective_address, entry.msr_bits, entry.code_hash).second)
+        m_pending.push_back(entry);
+    }
+
+    // Try the blocks in the order they were first compiled in.
+    std::reverse(m_pending.begin(), m_pending.end());
+    INFO_LOG_FMT(DYNA_REC, "Loaded {} blocks from {}", m_pending.size(), filename);
+  }
+  else
+  {
+    m_file.Close();
+    m_file.Open(filename, "wb");
+    m_file.WriteArray(header, 2);
+  }
+
+  m_file.Seek(0, File::SeekOrigin::End);
+}
+
+void JitBlockHistory::Close()
+{
+  m_file.Close();
+  m_game_id.clear();
+  m_known_entries.clear();
+  m_pending.clear();
+  m_deferred.clear();
+}
+
+void JitBlockHistory::Record(const Entry& entry)
+{
+  if (!m_file.IsOpen() ||
+      !m_known_entries.emplace(entry.effective_address, entry.msr_bits, entry.code_hash).second)
+  {
+    return;
+  }
+
+  m_file.WriteArray(&entry, 1);
+}
+
+std::optional<JitBlockHistory::Entry> JitBlockHistory::PopPending()
+{
+  if (m_pending.empty())
+    return std::nullopt;
+
+  const Entry entry = m_pending.back();
+  m_pending.pop_back();
+  return entry;
+}
+
+void JitBlockHistory::Defer(const Entry& entry)
+{
+  m_deferred.emplace(entry.effective_address, entry);
+}
+
+void JitBlockHistory::OnCodeChanged(u32 address, u32 length)
+{
+  const auto begin = m_deferred.lower_bound(address);
+  const auto end = length > ~address ? m_deferred.end() : m_deferred.lower_bound(address + length);
+  for (auto it = begin; it != end; ++it)
+    m_pending.push_back(it->second);
+  m_deferred.erase(begin, end);
+}
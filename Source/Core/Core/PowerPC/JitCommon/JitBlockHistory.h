@@ -0,0 +1,50 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+
+// Remembers which blocks were compiled in earlier sessions of a game, so that they can be compiled
+// in a batch once their code is in memory again instead of one at a time as execution reaches
+// them. Each block is identified by its entry address and MSR bits, along with a hash of the
+// instructions it was compiled from, which is checked before precompiling it.
+class JitBlockHistory
+{
+public:
+  struct Entry
+  {
+    u32 effective_address;
+    u32 msr_bits;
+    u64 code_hash;
+  };
+  static_assert(sizeof(Entry) == 16);
+
+  void Open(const std::string& game_id);
+  void Close();
+  const std::string& GetGameID() const { return m_game_id; }
+
+  // Adds a block compiled this session to the file, if it isn't there already.
+  void Record(const Entry& entry);
+
+  // Blocks from earlier sessions that have not been tried yet.
+  std::optional<Entry> PopPending();
+  // Sets aside a block whose code is not in memory (yet) until the memory it starts in changes.
+  void Defer(const Entry& entry);
+  void OnCodeChanged(u32 address, u32 length);
+
+private:
+  File::IOFile m_file;
+  std::string m_game_id;
+  std::set<std::tuple<u32, u32, u64>> m_known_entries;
+  std::vector<Entry> m_pending;
+  std::multimap<u32, Entry> m_deferred;
+};
@@ -7,9 +7,9 @@
 #include <array>
 #include <cstring>
 #include <functional>
-#include <map>
 #include <set>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/JitRegister.h"
@@ -28,11 +28,13 @@ using namespace Gen;
 
 bool JitBlock::OverlapsPhysicalRange(u32 address, u32 length) const
 {
-  return physical_addresses.lower_bound(address) !=
-         physical_addresses.lower_bound(address + length);
+  const auto iter =
+      std::lower_bound(physical_addresses.begin(), physical_addresses.end(), address);
+  return iter != physical_addresses.end() && *iter - address < length;
 }
 
-JitBaseBlockCache::JitBaseBlockCache(JitBase& jit) : m_jit{jit}
+JitBaseBlockCache::JitBaseBlockCache(JitBase& jit)
+    : m_jit{jit}, range_page_bits(RANGE_PAGE_COUNT / 64)
 {
 }
 
@@ -59,13 +61,19 @@ void JitBaseBlockCache::Clear()
 #endif
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
-  for (auto& e : block_map)
-  {
-    DestroyBlock(e.second);
-  }
-  block_map.clear();
-  links_to.clear();
-  block_range_map.clear();
+  block_map.ForEach([this](u32, JitBlock* block) {
+    for (; block; block = block->next_at_address)
+      DestroyBlock(*block);
+  });
+  block_map.Clear();
+  links_to.Clear();
+  block_range_map.Clear();
+  std::fill(range_page_bits.begin(), range_page_bits.end(), 0);
+
+  free_blocks.clear();
+  block_slabs.clear();
+  host_code_index.clear();
+  host_code_index_dirty = true;
 
   valid_block.ClearAll();
 
@@ -85,20 +93,53 @@ JitBlock** JitBaseBlockCache::GetFastBlockMap()
 
 void JitBaseBlockCache::RunOnBlocks(std::function<void(const JitBlock&)> f)
 {
-  for (const auto& e : block_map)
-    f(e.second);
+  block_map.ForEach([&f](u32, const JitBlock* block) {
+    for (; block; block = block->next_at_address)
+      f(*block);
+  });
+}
+
+JitBlock* JitBaseBlockCache::NewBlock()
+{
+  if (free_blocks.empty())
+  {
+    block_slabs.push_back(std::make_unique<JitBlock[]>(BLOCKS_PER_SLAB));
+    JitBlock* slab = block_slabs.back().get();
+    for (size_t i = BLOCKS_PER_SLAB; i-- > 0;)
+      free_blocks.push_back(&slab[i]);
+  }
+
+  JitBlock* block = free_blocks.back();
+  free_blocks.pop_back();
+  return block;
+}
+
+void JitBaseBlockCache::FreeBlock(JitBlock* block)
+{
+  // Keep the vectors' storage around for the next block that uses this slot.
+  static_cast<JitBlockData&>(*block) = {};
+  block->linkData.clear();
+  block->physical_addresses.clear();
+  block->next_at_address = nullptr;
+  block->profile_data = {};
+  free_blocks.push_back(block);
+  host_code_index_dirty = true;
 }
 
 JitBlock* JitBaseBlockCache::AllocateBlock(u32 em_address)
 {
   const u32 physical_address = PowerPC::JitCache_TranslateAddress(em_address).address;
-  JitBlock& b = block_map.emplace(physical_address, JitBlock())->second;
-  b.effectiveAddress = em_address;
-  b.physicalAddress = physical_address;
-  b.msrBits = MSR.Hex & JIT_CACHE_MSR_MASK;
-  b.linkData.clear();
-  b.fast_block_map_index = 0;
-  return &b;
+  JitBlock* b = NewBlock();
+  b->effectiveAddress = em_address;
+  b->physicalAddress = physical_address;
+  b->msrBits = MSR.Hex & JIT_CACHE_MSR_MASK;
+  b->linkData.clear();
+  b->fast_block_map_index = 0;
+
+  JitBlock*& first = block_map[physical_address];
+  b->next_at_address = first;
+  first = b;
+  return b;
 }
 
 void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
@@ -108,20 +149,35 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
   fast_block_map[index] = &block;
   block.fast_block_map_index = index;
 
-  block.physical_addresses = physical_addresses;
+  host_code_index_dirty = true;
+
+  block.physical_addresses.assign(physical_addresses.begin(), physical_addresses.end());
 
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
-  for (u32 addr : physical_addresses)
+  // The addresses are sorted, so every macro block only shows up once in a row.
+  bool first = true;
+  u32 previous_range = 0;
+  for (u32 addr : block.physical_addresses)
   {
     valid_block.Set(addr / 32);
-    block_range_map[addr & range_mask].insert(&block);
+
+    const u32 range = addr / BLOCK_RANGE_MAP_ELEMENTS;
+    if (first || range != previous_range)
+    {
+      block_range_map[range].push_back(&block);
+      const u32 page = addr >> RANGE_PAGE_SHIFT;
+      range_page_bits[page / 64] |= u64(1) << (page % 64);
+    }
+    first = false;
+    previous_range = range;
   }
 
   if (block_link)
   {
     for (const auto& e : block.linkData)
     {
-      links_to[e.exitAddress].insert(&block);
+      std::vector<JitBlock*>& sources = links_to[e.exitAddress];
+      if (std::find(sources.begin(), sources.end(), &block) == sources.end())
+        sources.push_back(&block);
     }
 
     LinkBlock(block);
@@ -154,17 +210,41 @@ JitBlock* JitBaseBlockCache::GetBlockFromStartAddress(u32 addr, u32 msr)
     translated_addr = translated.address;
   }
 
-  auto iter = block_map.equal_range(translated_addr);
-  for (; iter.first != iter.second; iter.first++)
+  JitBlock* const* first = block_map.Find(translated_addr);
+  for (JitBlock* b = first ? *first : nullptr; b; b = b->next_at_address)
   {
-    JitBlock& b = iter.first->second;
-    if (b.effectiveAddress == addr && b.msrBits == (msr & JIT_CACHE_MSR_MASK))
-      return &b;
+    if (b->effectiveAddress == addr && b->msrBits == (msr & JIT_CACHE_MSR_MASK))
+      return b;
   }
 
   return nullptr;
 }
 
+const JitBlock* JitBaseBlockCache::GetBlockFromHostAddress(const u8* host_address)
+{
+  if (host_code_index_dirty)
+  {
+    host_code_index.clear();
+    RunOnBlocks([this](const JitBlock& block) {
+      if (block.near_begin != block.near_end)
+        host_code_index.push_back({block.near_begin, block.near_end, &block});
+      if (block.far_begin != block.far_end)
+        host_code_index.push_back({block.far_begin, block.far_end, &block});
+    });
+    std::sort(host_code_index.begin(), host_code_index.end(),
+              [](const HostCodeRange& a, const HostCodeRange& b) { return a.begin < b.begin; });
+    host_code_index_dirty = false;
+  }
+
+  auto iter = std::upper_bound(
+      host_code_index.begin(), host_code_index.end(), host_address,
+      [](const u8* address, const HostCodeRange& range) { return address < range.begin; });
+  if (iter == host_code_index.begin())
+    return nullptr;
+  --iter;
+  return host_address < iter->end ? iter->block : nullptr;
+}
+
 const u8* JitBaseBlockCache::Dispatch()
 {
   JitBlock* block = fast_block_map[FastLookupIndexForAddress(PC)];
@@ -262,53 +342,121 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
 
 void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
 {
-  // Iterate over all macro blocks which overlap the given range.
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
-  auto start = block_range_map.lower_bound(address & range_mask);
-  auto end = block_range_map.lower_bound(address + length);
-  while (start != end)
+  constexpr u32 RANGES_PER_PAGE = (1u << RANGE_PAGE_SHIFT) / BLOCK_RANGE_MAP_ELEMENTS;
+  const u64 end_range =
+      (u64(address) + length + BLOCK_RANGE_MAP_ELEMENTS - 1) / BLOCK_RANGE_MAP_ELEMENTS;
+
+  // Collect the overlapping blocks first. Removing them modifies block_range_map, which would
+  // invalidate the lists being walked.
+  std::vector<JitBlock*> overlapping;
+  u64 range = address / BLOCK_RANGE_MAP_ELEMENTS;
+  while (range < end_range)
   {
-    // Iterate over all blocks in the macro block.
-    auto iter = start->second.begin();
-    while (iter != start->second.end())
+    const u64 page = range / RANGES_PER_PAGE;
+    const u64 page_bits = range_page_bits[page / 64];
+    if (page_bits == 0)
     {
-      JitBlock* block = *iter;
-      if (block->OverlapsPhysicalRange(address, length))
-      {
-        // If the block overlaps, also remove all other occupied slots in the other macro blocks.
-        // This will leak empty macro blocks, but they may be reused or cleared later on.
-        for (u32 addr : block->physical_addresses)
-          if ((addr & range_mask) != start->first)
-            block_range_map[addr & range_mask].erase(block);
-
-        // And remove the block.
-        DestroyBlock(*block);
-        auto block_map_iter = block_map.equal_range(block->physicalAddress);
-        while (block_map_iter.first != block_map_iter.second)
-        {
-          if (&block_map_iter.first->second == block)
-          {
-            block_map.erase(block_map_iter.first);
-            break;
-          }
-          block_map_iter.first++;
-        }
-        iter = start->second.erase(iter);
-      }
-      else
+      range = (page / 64 + 1) * 64 * RANGES_PER_PAGE;
+      continue;
+    }
+    if ((page_bits & (u64(1) << (page % 64))) == 0)
+    {
+      range = (page + 1) * RANGES_PER_PAGE;
+      continue;
+    }
+
+    const u64 page_end_range = std::min(end_range, (page + 1) * RANGES_PER_PAGE);
+    for (; range < page_end_range; range++)
+    {
+      const std::vector<JitBlock*>* blocks = block_range_map.Find(static_cast<u32>(range));
+      if (!blocks)
+        continue;
+
+      for (JitBlock* block : *blocks)
       {
-        iter++;
+        if (block->OverlapsPhysicalRange(address, length))
+          overlapping.push_back(block);
       }
     }
+  }
+
+  if (overlapping.empty())
+    return;
+
+  // A block which spans several macro blocks was found once for each of them.
+  std::sort(overlapping.begin(), overlapping.end());
+  overlapping.erase(std::unique(overlapping.begin(), overlapping.end()), overlapping.end());
+
+  for (JitBlock* block : overlapping)
+  {
+    RemoveFromRangeMap(block);
+    DestroyBlock(*block);
+    RemoveFromBlockTable(block);
+    FreeBlock(block);
+  }
+}
+
+void JitBaseBlockCache::RemoveFromRangeMap(JitBlock* block)
+{
+  constexpr u32 RANGES_PER_PAGE = (1u << RANGE_PAGE_SHIFT) / BLOCK_RANGE_MAP_ELEMENTS;
+
+  bool first = true;
+  u32 previous_range = 0;
+  for (u32 addr : block->physical_addresses)
+  {
+    const u32 range = addr / BLOCK_RANGE_MAP_ELEMENTS;
+    if (!first && range == previous_range)
+      continue;
+    first = false;
+    previous_range = range;
+
+    std::vector<JitBlock*>* blocks = block_range_map.Find(range);
+    if (!blocks)
+      continue;
+
+    const auto iter = std::find(blocks->begin(), blocks->end(), block);
+    if (iter != blocks->end())
+    {
+      *iter = blocks->back();
+      blocks->pop_back();
+    }
+    if (!blocks->empty())
+      continue;
 
-    // If the macro block is empty, drop it.
-    if (start->second.empty())
-      start = block_range_map.erase(start);
-    else
-      start++;
+    block_range_map.Erase(range);
+
+    // Drop the page from the bitmap once none of its macro blocks are left.
+    const u32 page_first_range = range - range % RANGES_PER_PAGE;
+    bool page_empty = true;
+    for (u32 i = 0; i < RANGES_PER_PAGE && page_empty; i++)
+      page_empty = block_range_map.Find(page_first_range + i) == nullptr;
+    if (page_empty)
+    {
+      const u32 page = addr >> RANGE_PAGE_SHIFT;
+      range_page_bits[page / 64] &= ~(u64(1) << (page % 64));
+    }
   }
 }
 
+void JitBaseBlockCache::RemoveFromBlockTable(JitBlock* block)
+{
+  JitBlock** first = block_map.Find(block->physicalAddress);
+  if (!first)
+    return;
+
+  for (JitBlock** link = first; *link; link = &(*link)->next_at_address)
+  {
+    if (*link == block)
+    {
+      *link = block->next_at_address;
+      break;
+    }
+  }
+
+  if (!*first)
+    block_map.Erase(block->physicalAddress);
+}
+
 u32* JitBaseBlockCache::GetBlockBitSet() const
 {
   return valid_block.m_valid_block.get();
@@ -343,11 +491,11 @@ void JitBaseBlockCache::LinkBlockExits(JitBlock& block)
 void JitBaseBlockCache::LinkBlock(JitBlock& block)
 {
   LinkBlockExits(block);
-  const auto it = links_to.find(block.effectiveAddress);
-  if (it == links_to.end())
+  const std::vector<JitBlock*>* sources = links_to.Find(block.effectiveAddress);
+  if (!sources)
     return;
 
-  for (JitBlock* b2 : it->second)
+  for (JitBlock* b2 : *sources)
   {
     if (block.msrBits == b2->msrBits)
       LinkBlockExits(*b2);
@@ -363,10 +511,10 @@ void JitBaseBlockCache::UnlinkBlock(const JitBlock& block)
   }
 
   // Unlink all exits of other blocks which points to this block
-  const auto it = links_to.find(block.effectiveAddress);
-  if (it == links_to.end())
+  const std::vector<JitBlock*>* sources = links_to.Find(block.effectiveAddress);
+  if (!sources)
     return;
-  for (JitBlock* sourceBlock : it->second)
+  for (JitBlock* sourceBlock : *sources)
   {
     if (sourceBlock->msrBits != block.msrBits)
       continue;
@@ -392,12 +540,17 @@ void JitBaseBlockCache::DestroyBlock(JitBlock& block)
   // Delete linking addresses
   for (const auto& e : block.linkData)
   {
-    auto it = links_to.find(e.exitAddress);
-    if (it == links_to.end())
+    std::vector<JitBlock*>* sources = links_to.Find(e.exitAddress);
+    if (!sources)
       continue;
-    it->second.erase(&block);
-    if (it->second.empty())
-      links_to.erase(it);
+    const auto it = std::find(sources->begin(), sources->end(), &block);
+    if (it != sources->end())
+    {
+      *it = sources->back();
+      sources->pop_back();
+    }
+    if (sources->empty())
+      links_to.Erase(e.exitAddress);
   }
 
   // Raise an signal if we are going to call this block again
@@ -7,15 +7,13 @@
 #include <bitset>
 #include <cstring>
 #include <functional>
-#include <map>
 #include <memory>
 #include <set>
 #include <type_traits>
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/FlatHashMap.h"
 
 class JitBase;
 
@@ -78,8 +76,11 @@ struct JitBlock : public JitBlockData
   };
   std::vector<LinkData> linkData;
 
-  // This set stores all physical addresses of all occupied instructions.
-  std::set<u32> physical_addresses;
+  // The physical addresses of all occupied instructions, sorted in ascending order.
+  std::vector<u32> physical_addresses;
+
+  // The next block in the block table which starts at the same physical address.
+  JitBlock* next_at_address = nullptr;
 
   // Block profiling data, structure is inlined in Jit.cpp
   struct ProfileData
@@ -154,6 +155,11 @@ public:
   // This might return nullptr if there is no such block.
   JitBlock* GetBlockFromStartAddress(u32 em_address, u32 msr);
 
+  // Find the block whose near or far code contains host_address. The index used for this is
+  // rebuilt lazily whenever blocks have changed, so this is meant for tools such as the sampling
+  // profiler rather than for emulation itself.
+  const JitBlock* GetBlockFromHostAddress(const u8* host_address);
+
   // Get the normal entry for the block associated with the current program
   // counter. This will JIT code if necessary. (This is the reference
   // implementation; high-performance JITs will want to use a custom
@@ -185,19 +191,48 @@ private:
   // Fast but risky block lookup based on fast_block_map.
   size_t FastLookupIndexForAddress(u32 address);
 
+  JitBlock* NewBlock();
+  void FreeBlock(JitBlock* block);
+  void RemoveFromBlockTable(JitBlock* block);
+  void RemoveFromRangeMap(JitBlock* block);
+
   // links_to hold all exit points of all valid blocks in a reverse way.
   // It is used to query all blocks which links to an address.
-  std::unordered_map<u32, std::unordered_set<JitBlock*>> links_to;  // destination_PC -> number
+  Common::FlatHashMap<u32, std::vector<JitBlock*>> links_to;  // destination_PC -> blocks
+
+  // Blocks are allocated from slabs so that their addresses stay stable; the assembly dispatchers
+  // and the link lists hold raw pointers to them. Destroyed blocks go onto a free list.
+  static constexpr size_t BLOCKS_PER_SLAB = 1024;
+  std::vector<std::unique_ptr<JitBlock[]>> block_slabs;
+  std::vector<JitBlock*> free_blocks;
 
-  // Map indexed by the physical address of the entry point.
+  // Map indexed by the physical address of the entry point. Blocks with the same entry point are
+  // chained through JitBlock::next_at_address.
   // This is used to query the block based on the current PC in a slow way.
-  std::multimap<u32, JitBlock> block_map;  // start_addr -> block
+  Common::FlatHashMap<u32, JitBlock*> block_map;  // start_addr -> first block
 
-  // Range of overlapping code indexed by a masked physical address.
+  // Range of overlapping code indexed by a physical address divided by BLOCK_RANGE_MAP_ELEMENTS.
   // This is used for invalidation of memory regions. The range is grouped
   // in macro blocks of each 0x100 bytes.
   static constexpr u32 BLOCK_RANGE_MAP_ELEMENTS = 0x100;
-  std::map<u32, std::unordered_set<JitBlock*>> block_range_map;
+  Common::FlatHashMap<u32, std::vector<JitBlock*>> block_range_map;
+
+  // One bit per 4 KiB page of physical address space, set if block_range_map might have entries
+  // within that page. This lets invalidation of large ranges skip untouched memory 64 pages at a
+  // time instead of probing every macro block.
+  static constexpr u32 RANGE_PAGE_SHIFT = 12;
+  static constexpr size_t RANGE_PAGE_COUNT = (1ULL << 32) >> RANGE_PAGE_SHIFT;
+  std::vector<u64> range_page_bits;
+
+  // Sorted host code ranges of all blocks, for GetBlockFromHostAddress.
+  struct HostCodeRange
+  {
+    const u8* begin;
+    const u8* end;
+    const JitBlock* block;
+  };
+  std::vector<HostCodeRange> host_code_index;
+  bool host_code_index_dirty = true;
 
   // This bitsets shows which cachelines overlap with any blocks.
   // It is used to provide a fast way to query if no icache invalidation is needed.
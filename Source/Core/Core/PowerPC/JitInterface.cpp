@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <optional>
 #include <string>
 #include <unordered_set>
 
@@ -185,6 +186,18 @@ int GetHostCode(u32* address, const u8** code, u32* code_size)
   return 0;
 }
 
+std::optional<u32> GetBlockAddressFromHostCode(const u8* host_address)
+{
+  if (!g_jit)
+    return std::nullopt;
+
+  const JitBlock* block = g_jit->GetBlockCache()->GetBlockFromHostAddress(host_address);
+  if (!block)
+    return std::nullopt;
+
+  return block->effectiveAddress;
+}
+
 bool HandleFault(uintptr_t access_address, SContext* ctx)
 {
   // Prevent nullptr dereference on a crash with no JIT present
@@ -220,13 +233,19 @@ void ClearSafe()
 void InvalidateICache(u32 address, u32 size, bool forced)
 {
   if (g_jit)
+  {
     g_jit->GetBlockCache()->InvalidateICache(address, size, forced);
+    g_jit->OnCodeChanged(address, size);
+  }
 }
 
 void InvalidateICacheLine(u32 address)
 {
   if (g_jit)
+  {
     g_jit->GetBlockCache()->InvalidateICacheLine(address);
+    g_jit->OnCodeChanged(address & ~0x1f, 32);
+  }
 }
 
 void InvalidateICacheLines(u32 address, u32 count)
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 
 #include "Common/CommonTypes.h"
@@ -48,6 +49,10 @@ void WriteProfileResults(const std::string& filename);
 void GetProfileResults(Profiler::ProfileStats* prof_stats);
 int GetHostCode(u32* address, const u8** code, u32* code_size);
 
+// Returns the effective address of the block whose host code contains host_address.
+// CPU thread only.
+std::optional<u32> GetBlockAddressFromHostCode(const u8* host_address);
+
 // Memory Utilities
 bool HandleFault(uintptr_t access_address, SContext* ctx);
 bool HandleStackFault();
@@ -3,6 +3,7 @@
 
 #include "Core/PowerPC/MMU.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
 #include <string>
@@ -823,16 +824,25 @@ std::optional<WriteResult> HostTryWriteF64(const double var, const u32 address,
 std::string HostGetString(u32 address, size_t size)
 {
   std::string s;
-  do
+
+  // Scan a page at a time, as the next page may be mapped somewhere else entirely.
+  while (size == 0 || s.length() < size)
   {
-    if (!HostIsRAMAddress(address))
+    u32 chunk_size = static_cast<u32>(HW_PAGE_SIZE - (address & HW_PAGE_MASK));
+    if (size != 0)
+      chunk_size = static_cast<u32>(std::min<size_t>(chunk_size, size - s.length()));
+
+    const std::optional<HostRAMRange> range = HostGetRAMRange(address, chunk_size);
+    if (!range)
       break;
-    u8 res = HostRead_U8(address);
-    if (!res)
+
+    const char* chunk = reinterpret_cast<const char*>(range->data);
+    const char* terminator = static_cast<const char*>(std::memchr(chunk, 0, chunk_size));
+    s.append(chunk, terminator ? terminator - chunk : chunk_size);
+    if (terminator)
       break;
-    s += static_cast<char>(res);
-    ++address;
-  } while (size == 0 || s.length() < size);
+    address += chunk_size;
+  }
   return s;
 }
 
@@ -947,6 +957,93 @@ bool HostIsInstructionRAMAddress(u32 address, RequestedAddressSpace space)
   return false;
 }
 
+// Returns the host memory backing a physical RAM address, and how many bytes of the same region
+// follow it, or nullptr if the address isn't RAM. Matches the regions accepted by IsRAMAddress.
+static u8* GetRAMPointer(u32 address, u32* bytes_left)
+{
+  const u32 segment = address >> 28;
+  const u32 offset = address & 0x0FFFFFFF;
+  if (Memory::m_pRAM && segment == 0x0 && offset < Memory::GetRamSizeReal())
+  {
+    *bytes_left = Memory::GetRamSizeReal() - offset;
+    return Memory::m_pRAM + offset;
+  }
+  if (Memory::m_pEXRAM && segment == 0x1 && offset < Memory::GetExRamSizeReal())
+  {
+    *bytes_left = Memory::GetExRamSizeReal() - offset;
+    return Memory::m_pEXRAM + offset;
+  }
+  if (Memory::m_pFakeVMEM && ((address & 0xFE000000) == 0x7E000000))
+  {
+    const u32 fake_vmem_offset = address & Memory::GetFakeVMemMask();
+    *bytes_left = Memory::GetFakeVMemSize() - fake_vmem_offset;
+    return Memory::m_pFakeVMEM + fake_vmem_offset;
+  }
+  if (Memory::m_pL1Cache && segment == 0xE && offset < Memory::GetL1CacheSize())
+  {
+    *bytes_left = Memory::GetL1CacheSize() - offset;
+    return Memory::m_pL1Cache + offset;
+  }
+  return nullptr;
+}
+
+std::optional<HostRAMRange> HostGetRAMRange(u32 address, u32 size, RequestedAddressSpace space)
+{
+  bool translate;
+  switch (space)
+  {
+  case RequestedAddressSpace::Effective:
+    translate = MSR.DR;
+    break;
+  case RequestedAddressSpace::Physical:
+    translate = false;
+    break;
+  case RequestedAddressSpace::Virtual:
+    if (!MSR.DR)
+      return std::nullopt;
+    translate = true;
+    break;
+  default:
+    ASSERT(0);
+    return std::nullopt;
+  }
+
+  if (size == 0 || size - 1 > ~address)
+    return std::nullopt;
+
+  u32 physical_address = address;
+  if (translate)
+  {
+    const auto result = TranslateAddress<XCheckTLBFlag::NoException>(address);
+    if (!result.Success())
+      return std::nullopt;
+    physical_address = result.address;
+  }
+
+  u32 bytes_left;
+  u8* data = GetRAMPointer(physical_address, &bytes_left);
+  if (!data || size > bytes_left)
+    return std::nullopt;
+
+  // BATs map at least 128 KiB contiguously, but a page table may scatter the pages of a range all
+  // over physical memory, so every page the range touches has to be checked.
+  if (translate)
+  {
+    const u32 first_page = address & ~HW_PAGE_MASK;
+    const u32 extra_pages =
+        static_cast<u32>(((address & HW_PAGE_MASK) + (size - 1)) / HW_PAGE_SIZE);
+    for (u32 i = 1; i <= extra_pages; ++i)
+    {
+      const u32 page = first_page + i * static_cast<u32>(HW_PAGE_SIZE);
+      const auto result = TranslateAddress<XCheckTLBFlag::NoException>(page);
+      if (!result.Success() || result.address != physical_address + (page - address))
+        return std::nullopt;
+    }
+  }
+
+  return HostRAMRange{data, size, translate};
+}
+
 void DMA_LCToMemory(const u32 mem_address, const u32 cache_address, const u32 num_blocks)
 {
   // TODO: It's not completely clear this is the right spot for this code;
@@ -5,10 +5,12 @@
 
 #include <array>
 #include <cstddef>
+#include <cstring>
 #include <optional>
 #include <string>
 
 #include "Common/CommonTypes.h"
+#include "Common/Swap.h"
 
 namespace PowerPC
 {
@@ -124,6 +126,77 @@ bool HostIsRAMAddress(u32 address, RequestedAddressSpace space = RequestedAddres
 bool HostIsInstructionRAMAddress(u32 address,
                                  RequestedAddressSpace space = RequestedAddressSpace::Effective);
 
+// A direct view of a range of emulated RAM, for host code which reads or writes more than a few
+// values at once. The range is translated once, so accessing it costs no more than a memcpy.
+// Values are stored big-endian, as the emulated CPU sees them.
+//
+// Accesses through the view bypass memchecks, and the view is only valid as long as the game
+// doesn't change its address translation or the emulated memory is reinitialized. Get a new
+// view every time instead of holding on to one.
+struct HostRAMRange
+{
+  u8* data;
+  u32 size;
+
+  // whether the address had to be translated (given address was treated as virtual) or not (given
+  // address was treated as physical)
+  bool translated;
+
+  // offset is relative to the start of the range and must leave room for a T.
+  template <typename T>
+  T Read(u32 offset) const
+  {
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return Common::FromBigEndian(value);
+  }
+
+  template <typename T>
+  void Write(T value, u32 offset) const
+  {
+    value = Common::FromBigEndian(value);
+    std::memcpy(data + offset, &value, sizeof(T));
+  }
+};
+
+// Returns a view of [address, address + size) if all of it resolves to RAM in the given address
+// space and the pages it spans are physically contiguous, which is the case for everything a game
+// maps through BATs and for most page table mappings. MMIO is never part of a view.
+std::optional<HostRAMRange>
+HostGetRAMRange(u32 address, u32 size,
+                RequestedAddressSpace space = RequestedAddressSpace::Effective);
+
+// Reads count consecutive big-endian values starting at address and converts them to host byte
+// order. Returns false without touching values if the range isn't contiguous RAM.
+template <typename T>
+bool HostTryReadArray(u32 address, T* values, u32 count,
+                      RequestedAddressSpace space = RequestedAddressSpace::Effective)
+{
+  const std::optional<HostRAMRange> range = HostGetRAMRange(address, count * sizeof(T), space);
+  if (!range)
+    return false;
+
+  // A plain loop over memcpy and byte swaps, which compilers turn into vector shuffles.
+  for (u32 i = 0; i < count; ++i)
+    values[i] = range->Read<T>(i * sizeof(T));
+  return true;
+}
+
+// Converts count values to big-endian and writes them to consecutive addresses starting at
+// address. Returns false without writing anything if the range isn't contiguous RAM.
+template <typename T>
+bool HostTryWriteArray(const T* values, u32 address, u32 count,
+                       RequestedAddressSpace space = RequestedAddressSpace::Effective)
+{
+  const std::optional<HostRAMRange> range = HostGetRAMRange(address, count * sizeof(T), space);
+  if (!range)
+    return false;
+
+  for (u32 i = 0; i < count; ++i)
+    range->Write<T>(values[i], i * sizeof(T));
+  return true;
+}
+
 // Routines for the CPU core to access memory.
 
 // Used by interpreter to read instructions, uses iCache
@@ -0,0 +1,418 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/SamplingProfiler.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonFuncs.h"
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/Flag.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/Swap.h"
+#include "Common/Thread.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/MachineContext.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/PowerPC.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <signal.h>
+#endif
+
+// Where the host PC comes from. Windows suspends the CPU thread and reads its context from the
+// sampler thread; other POSIX systems signal the CPU thread and read the PC in the handler.
+#if defined(_M_GENERIC) || defined(__APPLE__) || defined(__OpenBSD__)
+#define SAMPLING_SUPPORTED 0
+#elif _M_X86_64
+#define SAMPLING_SUPPORTED 1
+#define SAMPLE_CTX_PC CTX_RIP
+#elif _M_ARM_64
+#define SAMPLING_SUPPORTED 1
+#define SAMPLE_CTX_PC CTX_PC
+#else
+#define SAMPLING_SUPPORTED 0
+#endif
+
+namespace SamplingProfiler
+{
+namespace
+{
+constexpr u32 MAX_STACK_DEPTH = 32;
+constexpr u32 RING_SIZE = 8192;
+
+struct RawSample
+{
+  uintptr_t host_pc;
+  u32 guest_pc;
+  u32 lr;
+  u32 stack_depth;
+  // Return addresses from the stack back chain, innermost first.
+  std::array<u32, MAX_STACK_DEPTH> stack;
+};
+
+struct FunctionStats
+{
+  u64 self = 0;
+  u64 total = 0;
+};
+}  // namespace
+
+// Written by the sampling side (a signal handler on the CPU thread, or the sampler thread with
+// the CPU thread suspended) and read by ResolveSamples, so only lock-free operations are allowed.
+static std::array<RawSample, RING_SIZE> s_ring;
+static std::atomic<u32> s_ring_write{0};
+static std::atomic<u32> s_ring_read{0};
+static std::atomic<u64> s_dropped_samples{0};
+static Common::Flag s_running;
+
+static std::mutex s_control_mutex;
+static std::thread s_sampler_thread;
+static u32 s_interval_us = DEFAULT_INTERVAL_US;
+#ifdef _WIN32
+static HANDLE s_cpu_thread = nullptr;
+#else
+static pthread_t s_cpu_thread;
+static bool s_signal_handler_installed = false;
+#endif
+
+// Collapsed stacks ("outer;inner;leaf") and how often they were sampled.
+static std::unordered_map<std::string, u64> s_stacks;
+static u64 s_total_samples = 0;
+static u64 s_host_samples = 0;
+
+static bool IsRAMAddress(u32 address)
+{
+  // Only MEM1 through the default BAT mappings, which is where game code and stacks live.
+  const u32 segment = address >> 28;
+  return (segment == 0x8 || segment == 0xC) && (address & 0x0FFFFFFF) < Memory::GetRamSizeReal();
+}
+
+// Safe to call from a signal handler: this is a plain load from guest RAM.
+static bool ReadGuestU32(u32 address, u32* value)
+{
+  if (!Memory::m_pRAM || (address & 3) != 0 || !IsRAMAddress(address))
+    return false;
+
+  std::memcpy(value, Memory::m_pRAM + (address & 0x0FFFFFFF), sizeof(u32));
+  *value = Common::swap32(*value);
+  return true;
+}
+
+static void RecordSample(uintptr_t host_pc)
+{
+  if (!s_running.IsSet())
+    return;
+
+  const u32 write = s_ring_write.load(std::memory_order_relaxed);
+  if (write - s_ring_read.load(std::memory_order_acquire) >= RING_SIZE)
+  {
+    s_dropped_samples.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  RawSample& sample = s_ring[write % RING_SIZE];
+  sample.host_pc = host_pc;
+  sample.guest_pc = PC;
+  sample.lr = LR;
+
+  // Walk the back chain like Dolphin_Debugger::GetCallstack does. The saved LR of each frame is
+  // stored one word above the back chain pointer.
+  u32 depth = 0;
+  u32 frame;
+  if (ReadGuestU32(PowerPC::ppcState.gpr[1], &frame))
+  {
+    while (depth < MAX_STACK_DEPTH && frame != 0 && frame != 0xFFFFFFFF)
+    {
+      u32 return_address;
+      if (!ReadGuestU32(frame + 4, &return_address))
+        break;
+      sample.stack[depth++] = return_address;
+      if (!ReadGuestU32(frame, &frame))
+        break;
+    }
+  }
+  sample.stack_depth = depth;
+
+  s_ring_write.store(write + 1, std::memory_order_release);
+}
+
+#if SAMPLING_SUPPORTED && !defined(_WIN32)
+static void SignalHandler(int, siginfo_t*, void* raw_context)
+{
+  ucontext_t* context = static_cast<ucontext_t*>(raw_context);
+  mcontext_t* ctx = &context->uc_mcontext;
+  RecordSample(static_cast<uintptr_t>(ctx->SAMPLE_CTX_PC));
+}
+#endif
+
+static void SamplerThread()
+{
+  Common::SetCurrentThreadName("Sampling profiler");
+
+  while (s_running.IsSet())
+  {
+    std::this_thread::sleep_for(std::chrono::microseconds(s_interval_us));
+    if (Core::GetState() != Core::State::Running)
+      continue;
+
+#if SAMPLING_SUPPORTED && defined(_WIN32)
+    if (SuspendThread(s_cpu_thread) == static_cast<DWORD>(-1))
+      continue;
+    CONTEXT context{};
+    context.ContextFlags = CONTEXT_CONTROL;
+    if (GetThreadContext(s_cpu_thread, &context))
+      RecordSample(static_cast<uintptr_t>(context.SAMPLE_CTX_PC));
+    ResumeThread(s_cpu_thread);
+#elif SAMPLING_SUPPORTED
+    pthread_kill(s_cpu_thread, SIGPROF);
+#endif
+  }
+}
+
+static void PushFrame(std::vector<std::string>* frames, u32 address)
+{
+  if (!IsRAMAddress(address))
+    return;
+
+  const Common::Symbol* symbol = g_symbolDB.GetSymbolFromAddr(address);
+  std::string name = symbol ? symbol->name : fmt::format("{:08x}", address);
+
+  // A return address usually resolves to the same function as the frame next to it, for example
+  // when LR still points into the current function after a call has returned.
+  if (frames->empty() || frames->back() != name)
+    frames->push_back(std::move(name));
+}
+
+static void ResolvePendingSamples()
+{
+  const u32 write = s_ring_write.load(std::memory_order_acquire);
+  u32 read = s_ring_read.load(std::memory_order_relaxed);
+  if (read == write)
+    return;
+
+  std::vector<std::string> frames;
+  for (; read != write; ++read)
+  {
+    const RawSample& sample = s_ring[read % RING_SIZE];
+    const std::optional<u32> block_address =
+        JitInterface::GetBlockAddressFromHostCode(reinterpret_cast<const u8*>(sample.host_pc));
+
+    frames.clear();
+    for (u32 i = sample.stack_depth; i-- > 0;)
+      PushFrame(&frames, sample.stack[i]);
+    PushFrame(&frames, sample.lr);
+    PushFrame(&frames, block_address.value_or(sample.guest_pc));
+    if (!block_address)
+    {
+      frames.emplace_back("[host]");
+      s_host_samples++;
+    }
+
+    s_stacks[fmt::format("{}", fmt::join(frames, ";"))]++;
+    s_total_samples++;
+  }
+
+  s_ring_read.store(read, std::memory_order_release);
+}
+
+void ResolveSamples()
+{
+  // Once the profiler is stopped, Stop() takes care of the remaining samples.
+  if (s_running.IsSet())
+    ResolvePendingSamples();
+}
+
+static std::optional<std::string> WriteReports()
+{
+  const std::string dir = File::GetUserPath(D_DUMP_IDX) + "Profiles" DIR_SEP;
+  if (!File::CreateFullPath(dir))
+    return std::nullopt;
+  const std::string prefix = dir + SConfig::GetInstance().GetGameID() + "_sampling";
+
+  std::unordered_map<std::string, FunctionStats> functions;
+  File::IOFile folded(prefix + ".folded", "w");
+  if (!folded)
+    return std::nullopt;
+
+  std::vector<std::string> names;
+  for (const auto& [stack, count] : s_stacks)
+  {
+    folded.WriteString(fmt::format("{} {}\n", stack, count));
+
+    names.clear();
+    size_t start = 0;
+    while (start <= stack.size())
+    {
+      const size_t end = std::min(stack.find(';', start), stack.size());
+      names.push_back(stack.substr(start, end - start));
+      start = end + 1;
+    }
+
+    functions[names.back()].self += count;
+    // Recursive functions appear more than once but must only be counted once.
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+    for (const std::string& name : names)
+      functions[name].total += count;
+  }
+
+  std::vector<std::pair<std::string, FunctionStats>> sorted(functions.begin(), functions.end());
+  std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+    return a.second.self != b.second.self ? a.second.self > b.second.self :
+                                            a.second.total > b.second.total;
+  });
+
+  File::IOFile flat(prefix + ".txt", "w");
+  if (!flat)
+    return std::nullopt;
+
+  const double total = static_cast<double>(std::max<u64>(s_total_samples, 1));
+  flat.WriteString(fmt::format("{} samples every {} us, {} ({:.2f}%) outside of JIT code, "
+                               "{} dropped\n\n",
+                               s_total_samples, s_interval_us, s_host_samples,
+                               100.0 * s_host_samples / total, s_dropped_samples.load()));
+  flat.WriteString(fmt::format("{:>8} {:>10} {:>8} {:>10}  {}\n", "Self%", "Self", "Total%",
+                               "Total", "Function"));
+  for (const auto& [name, stats] : sorted)
+  {
+    flat.WriteString(fmt::format("{:>8.2f} {:>10} {:>8.2f} {:>10}  {}\n",
+                                 100.0 * stats.self / total, stats.self,
+                                 100.0 * stats.total / total, stats.total, name));
+  }
+
+  return prefix;
+}
+
+bool Start(u32 interval_us)
+{
+#if !SAMPLING_SUPPORTED
+  ERROR_LOG_FMT(POWERPC, "The sampling profiler isn't supported on this platform");
+  return false;
+#else
+  if (!Core::IsRunning())
+  {
+    ERROR_LOG_FMT(POWERPC, "The sampling profiler can only be started while emulation is running");
+    return false;
+  }
+
+  // Find out which thread to sample. If emulation stops in the meantime, the function runs on this
+  // thread instead, which is caught by the IsCPUThread check.
+  bool found_cpu_thread = false;
+#ifdef _WIN32
+  HANDLE cpu_thread = nullptr;
+#else
+  pthread_t cpu_thread{};
+#endif
+  Core::RunOnCPUThread(
+      [&] {
+        if (!Core::IsCPUThread())
+          return;
+#ifdef _WIN32
+        cpu_thread = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT, FALSE,
+                                GetCurrentThreadId());
+        found_cpu_thread = cpu_thread != nullptr;
+#else
+        cpu_thread = pthread_self();
+        found_cpu_thread = true;
+#endif
+      },
+      true);
+  if (!found_cpu_thread)
+  {
+    ERROR_LOG_FMT(POWERPC, "Sampling profiler failed to get the CPU thread");
+    return false;
+  }
+
+  std::lock_guard lk(s_control_mutex);
+  if (s_running.IsSet())
+  {
+#ifdef _WIN32
+    CloseHandle(cpu_thread);
+#endif
+    ERROR_LOG_FMT(POWERPC, "The sampling profiler is already running");
+    return false;
+  }
+
+#ifndef _WIN32
+  // The handler stays installed once it has been, since a signal can still be pending when the
+  // profiler is stopped. It ignores samples while the profiler isn't running.
+  if (!s_signal_handler_installed)
+  {
+    struct sigaction sa;
+    sa.sa_sigaction = &SignalHandler;
+    sa.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIGPROF, &sa, nullptr) != 0)
+    {
+      ERROR_LOG_FMT(POWERPC, "Sampling profiler failed to install its signal handler: {}",
+                    LastStrerrorString());
+      return false;
+    }
+    s_signal_handler_installed = true;
+  }
+#endif
+
+  s_cpu_thread = cpu_thread;
+  s_interval_us = std::max<u32>(interval_us, 100);
+  s_stacks.clear();
+  s_total_samples = 0;
+  s_host_samples = 0;
+  s_dropped_samples = 0;
+  s_ring_read.store(s_ring_write.load());
+
+  s_running.Set();
+  s_sampler_thread = std::thread(SamplerThread);
+  NOTICE_LOG_FMT(POWERPC, "Sampling profiler started, sampling every {} us", s_interval_us);
+  return true;
+#endif
+}
+
+std::optional<std::string> Stop()
+{
+  std::lock_guard lk(s_control_mutex);
+  if (!s_running.TestAndClear())
+    return std::nullopt;
+
+  s_sampler_thread.join();
+#ifdef _WIN32
+  CloseHandle(s_cpu_thread);
+  s_cpu_thread = nullptr;
+#endif
+
+  Core::RunAsCPUThread(ResolvePendingSamples);
+
+  std::optional<std::string> prefix = WriteReports();
+  if (prefix)
+    NOTICE_LOG_FMT(POWERPC, "Sampling profile written to {}.txt and {}.folded", *prefix, *prefix);
+  else
+    ERROR_LOG_FMT(POWERPC, "Failed to write the sampling profile");
+
+  s_stacks.clear();
+  return prefix;
+}
+
+bool IsRunning()
+{
+  return s_running.IsSet();
+}
+}  // namespace SamplingProfiler
@@ -0,0 +1,38 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+// A low-overhead alternative to JIT block profiling.
+//
+// Instead of instrumenting every block, the CPU thread is interrupted at a fixed interval and the
+// host program counter is recorded together with the guest LR and stack back chain. Once per frame
+// the CPU thread maps the host PC back to the JIT block it belongs to and resolves every guest
+// address through g_symbolDB, so symbol maps loaded for the game (Maps/<game id>.map) give
+// function names.
+//
+// Samples taken outside of JIT code (dispatcher, MMIO handlers, HLE, interpreter fallbacks) are
+// attributed to the guest PC with an extra "[host]" frame on top.
+namespace SamplingProfiler
+{
+constexpr u32 DEFAULT_INTERVAL_US = 1000;
+
+// Must be called while emulation is running. Returns false and logs the reason if sampling isn't
+// supported on this platform, is already running or couldn't be started.
+bool Start(u32 interval_us = DEFAULT_INTERVAL_US);
+
+// Stops sampling and writes a flat profile (<prefix>.txt) and collapsed stacks for flamegraph
+// tools (<prefix>.folded) into the dump directory. Returns the prefix, or nothing if the
+// profiler wasn't running or the reports couldn't be written.
+std::optional<std::string> Stop();
+
+bool IsRunning();
+
+// CPU thread only. Attributes the samples taken since the last call.
+void ResolveSamples();
+}  // namespace SamplingProfiler
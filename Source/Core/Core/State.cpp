@@ -3,8 +3,13 @@
 
 #include "Core/State.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <lzo/lzo1x.h>
+#include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -12,18 +17,22 @@
 #include <vector>
 
 #include <fmt/format.h>
+#include <zstd.h>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/ScopeGuard.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
 #include "Common/Version.h"
+#include "Common/WorkQueueThread.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -35,6 +44,7 @@
 #include "Core/Movie.h"
 #include "Core/NetPlayClient.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/StateRing.h"
 
 #include "VideoCommon/FrameDump.h"
 #include "VideoCommon/OnScreenDisplay.h"
@@ -54,10 +64,9 @@ static const u32 OUT_LEN = IN_LEN + (IN_LEN / 16) + 64 + 3;
 
 static unsigned char __LZO_MMODEL out[OUT_LEN];
 
-#define HEAP_ALLOC(var, size)                                                                      \
-  lzo_align_t __LZO_MMODEL var[((size) + (sizeof(lzo_align_t) - 1)) / sizeof(lzo_align_t)]
-
-static HEAP_ALLOC(wrkmem, LZO1X_1_MEM_COMPRESS);
+// Savestates are dominated by RAM, which zstd's fastest levels compress about as well as LZO did
+// while being faster to decompress.
+constexpr int STATE_ZSTD_LEVEL = 1;
 
 static AfterLoadCallbackFunc s_on_after_load_callback;
 
@@ -73,8 +82,15 @@ static Common::Event g_compressAndDumpStateSyncEvent;
 static std::recursive_mutex g_save_thread_mutex;
 static std::thread g_save_thread;
 
+// In-memory rewind history, only allocated when MAIN_REWIND_SNAPSHOTS is non-zero
+static std::unique_ptr<StateRing> s_rewind_ring;
+static std::mutex s_rewind_mutex;
+static u32 s_rewind_interval = 1;
+static u32 s_frames_since_rewind_capture = 0;
+static std::atomic<bool> s_rewind_capture_pending{false};
+
 // Don't forget to increase this after doing changes on the savestate system
-constexpr u32 STATE_VERSION = 143;  // Last changed in PR 10784
+constexpr u32 STATE_VERSION = 144;  // Last changed for the chunked zstd compression
 
 // Maps savestate versions to Dolphin versions.
 // Versions after 42 don't need to be added to this list,
@@ -250,6 +266,51 @@ void SaveToBuffer(std::vector<u8>& buffer)
       true);
 }
 
+// Helper threads for ParallelFor. They are started the first time a state is compressed or
+// decompressed and kept until shutdown. The mutex also keeps ParallelFor calls from overlapping.
+static std::mutex s_parallel_for_mutex;
+static std::vector<std::unique_ptr<Common::WorkQueueThread<std::function<void()>>>>
+    s_parallel_for_workers;
+
+// Calls function for every index below count, spread over the calling thread and the helpers.
+static void ParallelFor(size_t count, const std::function<void(size_t)>& function)
+{
+  std::lock_guard parallel_for_lk(s_parallel_for_mutex);
+
+  const size_t num_workers = std::max(std::thread::hardware_concurrency(), 1u) - 1;
+  while (s_parallel_for_workers.size() < num_workers)
+  {
+    s_parallel_for_workers.push_back(
+        std::make_unique<Common::WorkQueueThread<std::function<void()>>>(
+            [](std::function<void()> task) { task(); }));
+  }
+
+  std::atomic<size_t> next_index{0};
+  const auto worker = [&] {
+    for (size_t i = next_index++; i < count; i = next_index++)
+      function(i);
+  };
+
+  const size_t num_helpers = count == 0 ? 0 : std::min(count - 1, num_workers);
+  std::mutex done_mutex;
+  std::condition_variable done;
+  size_t remaining = num_helpers;
+  for (size_t i = 0; i < num_helpers; i++)
+  {
+    s_parallel_for_workers[i]->EmplaceItem([&] {
+      worker();
+      std::lock_guard lk(done_mutex);
+      if (--remaining == 0)
+        done.notify_one();
+    });
+  }
+
+  worker();
+
+  std::unique_lock lk(done_mutex);
+  done.wait(lk, [&] { return remaining == 0; });
+}
+
 // return state number not in map
 static int GetEmptySlot(std::map<double, int> m)
 {
@@ -344,7 +405,7 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
   }
 
   if ((Movie::IsMovieActive()) && !Movie::IsJustStartingRecordingInputFromSaveState())
-    Movie::SaveRecording(filename + ".dtm");
+    Movie::SaveRecording(filename + ".dtm", false);
   else if (!Movie::IsMovieActive())
     File::Delete(filename + ".dtm");
 
@@ -358,6 +419,7 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
   // Setting up the header
   StateHeader header{};
   SConfig::GetInstance().GetGameID().copy(header.gameID, std::size(header.gameID));
+  header.compression = StateCompression::ChunkedZstd;
   header.size = s_use_compression ? (u32)buffer_size : 0;
   header.time = Common::Timer::GetDoubleTime();
 
@@ -365,33 +427,43 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
 
   if (header.size != 0)  // non-zero header size means the state is compressed
   {
-    lzo_uint i = 0;
-    while (true)
-    {
-      lzo_uint32 cur_len = 0;
-      lzo_uint out_len = 0;
-
-      if ((i + IN_LEN) >= buffer_size)
-      {
-        cur_len = (lzo_uint32)(buffer_size - i);
-      }
-      else
+    const u64 start_time = Common::Timer::GetTimeUs();
+
+    const u32 num_chunks =
+        static_cast<u32>((buffer_size + STATE_CHUNK_SIZE - 1) / STATE_CHUNK_SIZE);
+    std::vector<std::vector<u8>> chunks(num_chunks);
+    std::vector<u32> chunk_sizes(num_chunks);
+    std::atomic<bool> failed{false};
+
+    ParallelFor(num_chunks, [&](size_t i) {
+      const size_t offset = i * STATE_CHUNK_SIZE;
+      const size_t length = std::min<size_t>(STATE_CHUNK_SIZE, buffer_size - offset);
+
+      chunks[i].resize(ZSTD_compressBound(length));
+      const size_t result = ZSTD_compress(chunks[i].data(), chunks[i].size(), buffer_data + offset,
+                                          length, STATE_ZSTD_LEVEL);
+      if (ZSTD_isError(result))
       {
-        cur_len = IN_LEN;
+        failed = true;
+        return;
       }
+      chunks[i].resize(result);
+      chunk_sizes[i] = static_cast<u32>(result);
+    });
 
-      if (lzo1x_1_compress(buffer_data + i, cur_len, out, &out_len, wrkmem) != LZO_E_OK)
-        PanicAlertFmtT("Internal LZO Error - compression failed");
+    if (failed)
+    {
+      PanicAlertFmtT("Internal zstd error - compression failed");
+      return;
+    }
 
-      // The size of the data to write is 'out_len'
-      f.WriteArray((lzo_uint32*)&out_len, 1);
-      f.WriteBytes(out, out_len);
+    f.WriteArray(&num_chunks, 1);
+    f.WriteArray(chunk_sizes.data(), chunk_sizes.size());
+    for (const std::vector<u8>& chunk : chunks)
+      f.WriteBytes(chunk.data(), chunk.size());
 
-      if (cur_len != IN_LEN)
-        break;
-
-      i += cur_len;
-    }
+    INFO_LOG_FMT(CORE, "Compressed {} byte state into {} bytes in {} ms", buffer_size,
+                 f.Tell() - sizeof(StateHeader), (Common::Timer::GetTimeUs() - start_time) / 1000);
   }
   else  // uncompressed
   {
@@ -485,6 +557,52 @@ u64 GetUnixTimeOfSlot(int slot)
          (Common::Timer::DOUBLE_TIME_OFFSET * MS_PER_SEC);
 }
 
+static bool DecompressChunkedZstd(File::IOFile& f, std::vector<u8>& buffer)
+{
+  const u64 start_time = Common::Timer::GetTimeUs();
+
+  u32 num_chunks;
+  if (!f.ReadArray(&num_chunks, 1) ||
+      num_chunks != (buffer.size() + STATE_CHUNK_SIZE - 1) / STATE_CHUNK_SIZE)
+  {
+    return false;
+  }
+
+  std::vector<u32> chunk_sizes(num_chunks);
+  if (!f.ReadArray(chunk_sizes.data(), num_chunks))
+    return false;
+
+  std::vector<size_t> chunk_offsets(num_chunks);
+  u64 compressed_size = 0;
+  for (u32 i = 0; i < num_chunks; i++)
+  {
+    chunk_offsets[i] = static_cast<size_t>(compressed_size);
+    compressed_size += chunk_sizes[i];
+  }
+
+  // The chunk sizes come from the file, so don't trust them to be anywhere near the real size
+  if (compressed_size > f.GetSize() - f.Tell())
+    return false;
+
+  std::vector<u8> compressed(compressed_size);
+  if (!f.ReadBytes(compressed.data(), compressed.size()))
+    return false;
+
+  std::atomic<bool> failed{false};
+  ParallelFor(num_chunks, [&](size_t i) {
+    const size_t offset = i * STATE_CHUNK_SIZE;
+    const size_t length = std::min<size_t>(STATE_CHUNK_SIZE, buffer.size() - offset);
+    const size_t result = ZSTD_decompress(buffer.data() + offset, length,
+                                          compressed.data() + chunk_offsets[i], chunk_sizes[i]);
+    if (ZSTD_isError(result) || result != length)
+      failed = true;
+  });
+
+  INFO_LOG_FMT(CORE, "Decompressed {} byte state in {} ms", buffer.size(),
+               (Common::Timer::GetTimeUs() - start_time) / 1000);
+  return !failed;
+}
+
 static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data)
 {
   Flush();
@@ -513,27 +631,43 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
 
     buffer.resize(header.size);
 
-    lzo_uint i = 0;
-    while (true)
+    if (header.compression == StateCompression::ChunkedZstd)
     {
-      lzo_uint32 cur_len = 0;  // number of bytes to read
-      lzo_uint new_len = 0;    // number of bytes to write
-
-      if (!f.ReadArray(&cur_len, 1))
-        break;
-
-      f.ReadBytes(out, cur_len);
-      const int res = lzo1x_decompress(out, cur_len, &buffer[i], &new_len, nullptr);
-      if (res != LZO_E_OK)
+      if (!DecompressChunkedZstd(f, buffer))
       {
-        // This doesn't seem to happen anymore.
-        PanicAlertFmtT("Internal LZO Error - decompression failed ({0}) ({1}, {2}) \n"
-                       "Try loading the state again",
-                       res, i, new_len);
+        Core::DisplayMessage("The savestate is corrupted", 2000);
         return;
       }
+    }
+    else if (header.compression == StateCompression::LZO)
+    {
+      lzo_uint i = 0;
+      while (true)
+      {
+        lzo_uint32 cur_len = 0;  // number of bytes to read
+        lzo_uint new_len = 0;    // number of bytes to write
 
-      i += new_len;
+        if (!f.ReadArray(&cur_len, 1))
+          break;
+
+        f.ReadBytes(out, cur_len);
+        const int res = lzo1x_decompress(out, cur_len, &buffer[i], &new_len, nullptr);
+        if (res != LZO_E_OK)
+        {
+          // This doesn't seem to happen anymore.
+          PanicAlertFmtT("Internal LZO Error - decompression failed ({0}) ({1}, {2}) \n"
+                         "Try loading the state again",
+                         res, i, new_len);
+          return;
+        }
+
+        i += new_len;
+      }
+    }
+    else
+    {
+      Core::DisplayMessage("The savestate uses an unknown compression format", 2000);
+      return;
     }
   }
   else  // uncompressed
@@ -575,7 +709,7 @@ void LoadAs(const std::string& filename)
           std::lock_guard lk(g_cs_undo_load_buffer);
           SaveToBuffer(g_undo_load_buffer);
           if (Movie::IsMovieActive())
-            Movie::SaveRecording(File::GetUserPath(D_STATESAVES_IDX) + "undo.dtm");
+            Movie::SaveRecording(File::GetUserPath(D_STATESAVES_IDX) + "undo.dtm", false);
           else if (File::Exists(File::GetUserPath(D_STATESAVES_IDX) + "undo.dtm"))
             File::Delete(File::GetUserPath(D_STATESAVES_IDX) + "undo.dtm");
         }
@@ -624,6 +758,58 @@ void LoadAs(const std::string& filename)
       true);
 }
 
+static bool IsRewindAllowed()
+{
+  // Rewinding is a practice tool; keep it out of netplay and ranked games like regular loading.
+  return !NetPlay::IsNetPlayRunning() && !Core::isTagSetActive() && !Movie::IsMovieActive();
+}
+
+void OnFrameEnd()
+{
+  if (!s_rewind_ring || ++s_frames_since_rewind_capture < s_rewind_interval)
+    return;
+  s_frames_since_rewind_capture = 0;
+
+  // This runs inside the VI event, where the scheduler is in the middle of an update, so the
+  // capture is deferred to the host thread, which will pause the CPU thread to take it.
+  if (s_rewind_capture_pending.exchange(true))
+    return;
+
+  Core::QueueHostJob([] {
+    {
+      std::lock_guard lk(s_rewind_mutex);
+      if (s_rewind_ring && IsRewindAllowed())
+        s_rewind_ring->Capture();
+    }
+    s_rewind_capture_pending = false;
+  });
+}
+
+bool Rewind(size_t steps)
+{
+  std::lock_guard lk(s_rewind_mutex);
+  if (!s_rewind_ring || !IsRewindAllowed())
+    return false;
+
+  if (!s_rewind_ring->Restore(steps))
+  {
+    OSD::AddMessage("No rewind state available");
+    return false;
+  }
+
+  if (s_on_after_load_callback)
+    s_on_after_load_callback();
+  return true;
+}
+
+std::optional<StateRing::Stats> GetRewindStats()
+{
+  std::lock_guard lk(s_rewind_mutex);
+  if (!s_rewind_ring)
+    return std::nullopt;
+  return s_rewind_ring->GetStats();
+}
+
 void SetOnAfterLoadCallback(AfterLoadCallbackFunc callback)
 {
   s_on_after_load_callback = std::move(callback);
@@ -633,12 +819,29 @@ void Init()
 {
   if (lzo_init() != LZO_E_OK)
     PanicAlertFmtT("Internal LZO Error - lzo_init() failed");
+
+  const u32 rewind_snapshots = Config::Get(Config::MAIN_REWIND_SNAPSHOTS);
+  std::lock_guard lk(s_rewind_mutex);
+  if (rewind_snapshots != 0)
+    s_rewind_ring = std::make_unique<StateRing>(rewind_snapshots);
+  s_rewind_interval = std::max<u32>(Config::Get(Config::MAIN_REWIND_INTERVAL), 1);
+  s_frames_since_rewind_capture = 0;
 }
 
 void Shutdown()
 {
   Flush();
 
+  {
+    std::lock_guard lk(s_rewind_mutex);
+    s_rewind_ring.reset();
+  }
+
+  {
+    std::lock_guard lk(s_parallel_for_mutex);
+    s_parallel_for_workers.clear();
+  }
+
   // swapping with an empty vector, rather than clear()ing
   // this gives a better guarantee to free the allocated memory right NOW (as opposed to, actually,
   // never)
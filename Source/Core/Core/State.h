@@ -7,21 +7,34 @@
 
 #include <cstddef>
 #include <functional>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Core/StateRing.h"
 
 namespace State
 {
 // number of states
 static const u32 NUM_STATES = 10;
 
+enum class StateCompression : u16
+{
+  // Blocks of LZO1X data, each preceded by its compressed size. Only read, for older states.
+  LZO = 0,
+  // A chunk count, a table of compressed chunk sizes, then independent zstd frames that each
+  // decompress to STATE_CHUNK_SIZE bytes (the last one may be shorter).
+  ChunkedZstd = 1,
+};
+
+constexpr u32 STATE_CHUNK_SIZE = 1024 * 1024;
+
 struct StateHeader
 {
   char gameID[6];
-  u16 reserved1;
-  u32 size;
+  StateCompression compression;
+  u32 size;  // Uncompressed size, or 0 if the state is stored uncompressed
   u32 reserved2;
   double time;
 };
@@ -59,6 +72,14 @@ void LoadAs(const std::string& filename);
 void SaveToBuffer(std::vector<u8>& buffer);
 void LoadFromBuffer(std::vector<u8>& buffer);
 
+// Called by the CPU thread at the end of every frame to take rewind snapshots.
+void OnFrameEnd();
+// Goes back the given number of rewind snapshots. Returns false if rewinding is disabled or there
+// are not enough snapshots.
+bool Rewind(size_t steps = 1);
+// Returns nothing if rewinding is disabled.
+std::optional<StateRing::Stats> GetRewindStats();
+
 void LoadLastSaved(int i = 1);
 void SaveFirstSaved();
 void UndoSaveState();
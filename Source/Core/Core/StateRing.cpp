@@ -0,0 +1,198 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/StateRing.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "Common/Assert.h"
+#include "Common/ChunkFile.h"
+#include "Common/Timer.h"
+#include "Core/HW/Memmap.h"
+#include "Core/State.h"
+
+namespace State
+{
+StateRing::StateRing(size_t capacity) : m_capacity(std::max<size_t>(capacity, 1))
+{
+}
+
+static_assert(StateRing::PAGE_SIZE == Memory::DIRTY_PAGE_SIZE);
+
+void StateRing::MakeDelta(const std::vector<u8>& older, const std::vector<u8>& newer, Delta* delta)
+{
+  delta->state_size = older.size();
+
+  for (size_t offset = 0; offset < older.size(); offset += PAGE_SIZE)
+  {
+    const size_t length = std::min(PAGE_SIZE, older.size() - offset);
+    if (offset + length <= newer.size() &&
+        std::memcmp(&older[offset], &newer[offset], length) == 0)
+    {
+      continue;
+    }
+
+    delta->pages.push_back(static_cast<u32>(offset / PAGE_SIZE));
+    delta->data.insert(delta->data.end(), older.begin() + offset, older.begin() + offset + length);
+  }
+}
+
+void StateRing::ApplyDelta(const Delta& delta, std::vector<u8>* state)
+{
+  state->resize(delta.state_size);
+
+  const u8* src = delta.data.data();
+  for (const u32 page : delta.pages)
+  {
+    const size_t offset = static_cast<size_t>(page) * PAGE_SIZE;
+    const size_t length = std::min(PAGE_SIZE, delta.state_size - offset);
+    std::memcpy(state->data() + offset, src, length);
+    src += length;
+  }
+  DEBUG_ASSERT(src == delta.data.data() + delta.data.size());
+}
+
+void StateRing::CaptureMemory(Delta* delta)
+{
+  const u32 memory_size = Memory::GetTrackedMemorySize();
+  if (m_memory.size() != memory_size)
+  {
+    m_memory.resize(memory_size);
+    for (u32 offset = 0; offset < memory_size; offset += PAGE_SIZE)
+      std::memcpy(&m_memory[offset], Memory::GetTrackedMemoryPointer(offset), PAGE_SIZE);
+  }
+  else
+  {
+    const std::vector<u32> dirty_pages = Memory::GetDirtyPages();
+    m_stats.dirty_pages += dirty_pages.size();
+    for (const u32 page : dirty_pages)
+    {
+      u8* const copy = &m_memory[static_cast<size_t>(page) * PAGE_SIZE];
+      const u8* const current = Memory::GetTrackedMemoryPointer(page * u32(PAGE_SIZE));
+      if (std::memcmp(copy, current, PAGE_SIZE) == 0)
+        continue;
+
+      delta->memory_pages.push_back(page);
+      delta->memory_data.insert(delta->memory_data.end(), copy, copy + PAGE_SIZE);
+      std::memcpy(copy, current, PAGE_SIZE);
+    }
+    m_stats.changed_pages += delta->memory_pages.size();
+  }
+
+  m_stats.tracking_writes = Memory::ResetDirtyPages();
+}
+
+void StateRing::RestoreMemory(std::vector<u32> pages)
+{
+  // Whatever was written since the newest state was captured has to be undone as well
+  const std::vector<u32> dirty_pages = Memory::GetDirtyPages();
+  pages.insert(pages.end(), dirty_pages.begin(), dirty_pages.end());
+  std::sort(pages.begin(), pages.end());
+  pages.erase(std::unique(pages.begin(), pages.end()), pages.end());
+
+  // Unprotecting everything at once is cheaper than taking a fault for every page
+  Memory::StopDirtyPageTracking();
+  for (const u32 page : pages)
+  {
+    std::memcpy(Memory::GetTrackedMemoryPointer(page * u32(PAGE_SIZE)),
+                &m_memory[static_cast<size_t>(page) * PAGE_SIZE], PAGE_SIZE);
+  }
+  m_stats.tracking_writes = Memory::ResetDirtyPages();
+}
+
+void StateRing::Capture()
+{
+  const u64 start_time = Common::Timer::GetTimeUs();
+
+  Delta delta;
+  Memory::SetStateMemoryHandler([this, &delta](PointerWrap& p) {
+    if (p.IsWriteMode())
+      CaptureMemory(&delta);
+  });
+  SaveToBuffer(m_scratch);
+  Memory::SetStateMemoryHandler(nullptr);
+
+  if (!m_latest.empty())
+  {
+    MakeDelta(m_latest, m_scratch, &delta);
+    m_stats.captured_delta_bytes += delta.GetSize();
+    m_stats.stored_delta_bytes += delta.GetSize();
+    m_deltas.push_back(std::move(delta));
+
+    while (m_deltas.size() >= m_capacity)
+    {
+      m_stats.stored_delta_bytes -= m_deltas.front().GetSize();
+      m_deltas.pop_front();
+    }
+  }
+  std::swap(m_latest, m_scratch);
+
+  const u64 elapsed = Common::Timer::GetTimeUs() - start_time;
+  m_stats.state_size = m_latest.size() + m_memory.size();
+  m_stats.num_captures++;
+  m_stats.last_capture_us = elapsed;
+  m_stats.total_capture_us += elapsed;
+  m_stats.max_capture_us = std::max(m_stats.max_capture_us, elapsed);
+}
+
+bool StateRing::Restore(size_t steps)
+{
+  if (m_latest.empty() || steps > m_deltas.size())
+    return false;
+
+  const u64 start_time = Common::Timer::GetTimeUs();
+
+  m_scratch = m_latest;
+  std::vector<u32> restored_pages;
+  for (size_t i = 0; i < steps; i++)
+  {
+    const Delta& delta = m_deltas.back();
+    ApplyDelta(delta, &m_scratch);
+
+    const u8* src = delta.memory_data.data();
+    for (const u32 page : delta.memory_pages)
+    {
+      std::memcpy(&m_memory[static_cast<size_t>(page) * PAGE_SIZE], src, PAGE_SIZE);
+      src += PAGE_SIZE;
+    }
+    restored_pages.insert(restored_pages.end(), delta.memory_pages.begin(),
+                          delta.memory_pages.end());
+
+    m_stats.stored_delta_bytes -= delta.GetSize();
+    m_deltas.pop_back();
+  }
+
+  Memory::SetStateMemoryHandler([this, &restored_pages](PointerWrap& p) {
+    if (p.IsReadMode())
+      RestoreMemory(std::move(restored_pages));
+  });
+  LoadFromBuffer(m_scratch);
+  Memory::SetStateMemoryHandler(nullptr);
+  std::swap(m_latest, m_scratch);
+
+  const u64 elapsed = Common::Timer::GetTimeUs() - start_time;
+  m_stats.num_restores++;
+  m_stats.last_restore_us = elapsed;
+  m_stats.total_restore_us += elapsed;
+  m_stats.max_restore_us = std::max(m_stats.max_restore_us, elapsed);
+  return true;
+}
+
+void StateRing::Clear()
+{
+  m_deltas.clear();
+  m_latest.clear();
+  m_scratch.clear();
+  m_memory.clear();
+  Memory::StopDirtyPageTracking();
+  m_stats.stored_delta_bytes = 0;
+  m_stats.tracking_writes = false;
+}
+
+size_t StateRing::GetMemoryUsage() const
+{
+  return m_latest.size() + m_memory.size() + m_stats.stored_delta_bytes;
+}
+}  // namespace State
@@ -0,0 +1,96 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace State
+{
+// An in-memory history of savestates, used for rewinding.
+//
+// Only the newest state is kept in full. Every older state is stored as the pages in which it
+// differs from the state captured right after it, so each snapshot costs roughly as much memory as
+// the emulated machine changed in between. Rewinding patches those pages back into a copy of the
+// newest state, newest first.
+//
+// Emulated memory is kept apart from the rest of the savestate. Writes to it are tracked by
+// write-protecting it, so a capture only looks at the pages written to since the previous one
+// instead of serializing and comparing all of MEM1 and EXRAM. Where writes can't be tracked,
+// every page is compared.
+class StateRing
+{
+public:
+  static constexpr size_t PAGE_SIZE = 0x1000;
+
+  struct Stats
+  {
+    u64 num_captures = 0;
+    u64 total_capture_us = 0;
+    u64 max_capture_us = 0;
+    u64 num_restores = 0;
+    u64 total_restore_us = 0;
+    u64 max_restore_us = 0;
+    u64 last_capture_us = 0;
+    u64 last_restore_us = 0;
+    // Pages of emulated memory written to between captures, and how many of them had changed
+    u64 dirty_pages = 0;
+    u64 changed_pages = 0;
+    u64 captured_delta_bytes = 0;
+    u64 stored_delta_bytes = 0;
+    // The newest state, including emulated memory
+    u64 state_size = 0;
+    bool tracking_writes = false;
+  };
+
+  explicit StateRing(size_t capacity);
+
+  // Like SaveToBuffer and LoadFromBuffer, these must be called from the host or CPU thread.
+  void Capture();
+  // Loads the state that was captured the given number of captures before the newest one, and
+  // drops everything newer. 0 reloads the newest state. Returns false if there is no such state.
+  bool Restore(size_t steps);
+
+  void Clear();
+
+  size_t GetCapacity() const { return m_capacity; }
+  // Number of states that can be restored, including the newest one.
+  size_t GetSize() const { return m_latest.empty() ? 0 : m_deltas.size() + 1; }
+  size_t GetMemoryUsage() const;
+  const Stats& GetStats() const { return m_stats; }
+
+private:
+  struct Delta
+  {
+    // The savestate without emulated memory
+    size_t state_size = 0;
+    std::vector<u32> pages;
+    std::vector<u8> data;
+    // Emulated memory, in pages of Memory::DIRTY_PAGE_SIZE
+    std::vector<u32> memory_pages;
+    std::vector<u8> memory_data;
+
+    size_t GetSize() const { return data.size() + memory_data.size(); }
+  };
+
+  // Fills in what has to be applied to newer to get older back.
+  static void MakeDelta(const std::vector<u8>& older, const std::vector<u8>& newer, Delta* delta);
+  static void ApplyDelta(const Delta& delta, std::vector<u8>* state);
+
+  // Called from Memory::DoState instead of serializing emulated memory.
+  void CaptureMemory(Delta* delta);
+  void RestoreMemory(std::vector<u32> pages);
+
+  size_t m_capacity;
+  std::deque<Delta> m_deltas;
+  std::vector<u8> m_latest;
+  std::vector<u8> m_scratch;
+  // Emulated memory as of the newest state
+  std::vector<u8> m_memory;
+  Stats m_stats;
+};
+}  // namespace State
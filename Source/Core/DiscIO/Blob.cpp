@@ -13,6 +13,7 @@
 #include "Common/CDUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 #include "Common/MsgHandler.h"
 
 #include "DiscIO/CISOBlob.h"
@@ -210,7 +211,7 @@ u32 SectorReader::ReadChunk(u8* buffer, u64 chunk_num)
   return 0;
 }
 
-std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename)
+std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename, bool map_plain_images)
 {
   if (Common::IsCDROMDevice(filename))
     return DriveReader::Create(filename);
@@ -246,6 +247,9 @@ std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename)
     if (auto directory_blob = DirectoryBlobReader::Create(filename))
       return std::move(directory_blob);
 
+    if (map_plain_images && File::MappedFile::IsOnLocalFixedStorage(filename))
+      return PlainFileReader::Create(std::move(file), filename);
+
     return PlainFileReader::Create(std::move(file));
   }
 }
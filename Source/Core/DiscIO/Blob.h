@@ -26,6 +26,7 @@
 namespace DiscIO
 {
 enum class WIARVZCompressionType : u32;
+struct ConversionStats;
 
 // Increment CACHE_REVISION (GameFileCache.cpp) if the enum below is modified
 enum class BlobType
@@ -175,7 +176,10 @@ private:
 };
 
 // Factory function - examines the path to choose the right type of BlobReader, and returns one.
-std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename);
+// If map_plain_images is set, plain disc images on local fixed storage are read through a memory
+// mapping (see PlainFileReader::Create).
+std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename,
+                                             bool map_plain_images = false);
 
 using CompressCB = std::function<bool(const std::string& text, float percent)>;
 
@@ -187,6 +191,6 @@ bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
 bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                        const std::string& outfile_path, bool rvz,
                        WIARVZCompressionType compression_type, int compression_level,
-                       int chunk_size, CompressCB callback);
+                       int chunk_size, CompressCB callback, ConversionStats* stats = nullptr);
 
 }  // namespace DiscIO
@@ -4,6 +4,7 @@
 #include "DiscIO/FileBlob.h"
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -15,21 +16,29 @@
 
 namespace DiscIO
 {
-PlainFileReader::PlainFileReader(File::IOFile file) : m_file(std::move(file))
+PlainFileReader::PlainFileReader(File::IOFile file, const std::string& path)
+    : m_file(std::move(file))
 {
   m_size = m_file.GetSize();
+
+  if (!path.empty() && (!m_mapped_file.Open(path) || m_mapped_file.GetSize() != u64(m_size)))
+    m_mapped_file.Close();
 }
 
-std::unique_ptr<PlainFileReader> PlainFileReader::Create(File::IOFile file)
+std::unique_ptr<PlainFileReader> PlainFileReader::Create(File::IOFile file,
+                                                         const std::string& path)
 {
   if (file)
-    return std::unique_ptr<PlainFileReader>(new PlainFileReader(std::move(file)));
+    return std::unique_ptr<PlainFileReader>(new PlainFileReader(std::move(file), path));
 
   return nullptr;
 }
 
 bool PlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
 {
+  if (m_mapped_file.IsOpen())
+    return ReadMapped(offset, nbytes, out_ptr);
+
   if (m_file.Seek(offset, File::SeekOrigin::Begin) && m_file.ReadBytes(out_ptr, nbytes))
   {
     return true;
@@ -41,6 +50,33 @@ bool PlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   }
 }
 
+bool PlainFileReader::ReadMapped(u64 offset, u64 nbytes, u8* out_ptr)
+{
+  const u64 size = m_mapped_file.GetSize();
+  if (offset > size || nbytes > size - offset)
+    return false;
+
+  const u64 end = offset + nbytes;
+  if (offset != m_last_read_end)
+  {
+    m_read_ahead_end = end;
+  }
+  else if (end + READ_AHEAD_SIZE / 2 > m_read_ahead_end)
+  {
+    // Extend the read-ahead window once the reads have used up half of it, rather than on every
+    // read, to keep the number of system calls down
+    const u64 start = std::max(offset, m_read_ahead_end);
+    const u64 new_end = end + READ_AHEAD_SIZE;
+    m_mapped_file.Advise(start, new_end - start, File::MappedFile::AccessHint::Sequential);
+    m_mapped_file.Advise(start, new_end - start, File::MappedFile::AccessHint::WillNeed);
+    m_read_ahead_end = new_end;
+  }
+  m_last_read_end = end;
+
+  std::memcpy(out_ptr, m_mapped_file.GetData() + offset, nbytes);
+  return true;
+}
+
 bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
                     const std::string& outfile_path, CompressCB callback)
 {
@@ -9,6 +9,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 #include "DiscIO/Blob.h"
 
 namespace DiscIO
@@ -16,7 +17,11 @@ namespace DiscIO
 class PlainFileReader : public BlobReader
 {
 public:
-  static std::unique_ptr<PlainFileReader> Create(File::IOFile file);
+  // If a path is given, the file is also mapped into memory, and reads are served straight from
+  // the mapping instead of going through stdio. If mapping fails, stdio is used. Only map files
+  // for which File::MappedFile::IsOnLocalFixedStorage holds, since reading a mapping whose storage
+  // failed crashes the process instead of making the read fail.
+  static std::unique_ptr<PlainFileReader> Create(File::IOFile file, const std::string& path = {});
 
   BlobType GetBlobType() const override { return BlobType::PLAIN; }
 
@@ -31,11 +36,22 @@ public:
 
   bool Read(u64 offset, u64 nbytes, u8* out_ptr) override;
 
+  bool IsMapped() const { return m_mapped_file.IsOpen(); }
+
 private:
-  PlainFileReader(File::IOFile file);
+  PlainFileReader(File::IOFile file, const std::string& path);
+
+  bool ReadMapped(u64 offset, u64 nbytes, u8* out_ptr);
+
+  // When reads are sequential, the OS is asked to read this much ahead of the current position
+  static constexpr u64 READ_AHEAD_SIZE = 8 * 1024 * 1024;
 
   File::IOFile m_file;
   s64 m_size;
+
+  File::MappedFile m_mapped_file;
+  u64 m_last_read_end = 0;
+  u64 m_read_ahead_end = 0;
 };
 
 }  // namespace DiscIO
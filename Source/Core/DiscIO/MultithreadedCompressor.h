@@ -3,17 +3,22 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <functional>
-#include <memory>
+#include <map>
+#include <mutex>
+#include <optional>
 #include <thread>
 #include <utility>
-#include <variant>
 #include <vector>
 
 #include "Common/Assert.h"
-#include "Common/Event.h"
+#include "Common/CommonTypes.h"
 #include "Common/Result.h"
+#include "Common/Timer.h"
 
 namespace DiscIO
 {
@@ -29,12 +34,33 @@ enum class ConversionResultCode
 template <typename T>
 using ConversionResult = Common::Result<ConversionResultCode, T>;
 
+// Timing information about a conversion, for judging where the bottleneck is.
+// All times are in microseconds.
+struct ConversionStats
+{
+  u64 bytes_read = 0;
+  u64 bytes_written = 0;
+  u64 wall_time = 0;
+  // Time the reading thread spent reading, and waiting for room in the queue of the compression
+  // threads. The latter growing large means that reading is not the bottleneck.
+  u64 read_time = 0;
+  u64 read_stall_time = 0;
+  // Summed over all compression threads
+  u64 compress_time = 0;
+  // Time the output thread spent writing
+  u64 output_time = 0;
+  u32 compress_threads = 0;
+};
+
 // This class starts a number of compression threads and one output thread.
 // The set_up_compress_thread_state function is called at the start of each compression thread.
 // When CompressAndWrite is called, the compress function will be called on one of the
 // compression threads, and then the output function will be called on the output thread.
 // The output thread handles data in the order that data was submitted using CompressAndWrite,
 // but the compression threads are not guaranteed to handle data in a predictable order.
+// Whichever compression thread is free picks up the next piece of data, and results that finish
+// early wait in a reorder buffer until it is their turn to be output. CompressAndWrite only
+// blocks once MAX_IN_FLIGHT_PER_THREAD pieces per thread are waiting to be compressed or output.
 // Remember to check GetStatus regularly and cancel if it doesn't return Success,
 // and call Shutdown when you want to ensure that everything finishes.
 template <typename CompressThreadState, typename CompressParameters, typename OutputParameters>
@@ -50,13 +76,11 @@ public:
         m_compress(std::move(compress)), m_output(std::move(output)),
         m_threads(std::max<unsigned int>(1, std::thread::hardware_concurrency()))
   {
-    m_compress_threads = std::make_unique<CompressThread[]>(m_threads);
-
+    m_compress_threads.reserve(m_threads);
     for (size_t i = 0; i < m_threads; ++i)
     {
-      m_compress_threads[i].thread =
-          std::thread(std::mem_fn(&MultithreadedCompressor::CompressThreadFunction), this,
-                      &m_compress_threads[i]);
+      m_compress_threads.emplace_back(
+          std::mem_fn(&MultithreadedCompressor::CompressThreadFunction), this);
     }
 
     m_output_thread =
@@ -65,7 +89,7 @@ public:
 
   ~MultithreadedCompressor()
   {
-    if (!m_shutting_down.load())
+    if (!m_shut_down)
       Shutdown();
   }
 
@@ -74,15 +98,22 @@ public:
     if (GetStatus() != ConversionResultCode::Success)
       return;
 
-    CompressThread& compress_thread = m_compress_threads[m_current_index];
+    const u64 start_time = Common::Timer::GetTimeUs();
+
+    std::unique_lock lk(m_mutex);
+    m_space_available.wait(lk, [&] {
+      return m_next_submit - m_next_output < m_threads * MAX_IN_FLIGHT_PER_THREAD ||
+             GetStatus() != ConversionResultCode::Success;
+    });
 
-    compress_thread.compress_ready_event.Wait();
-    compress_thread.compress_parameters = std::move(parameters);
-    compress_thread.compress_event.Set();
+    m_read_stall_time += Common::Timer::GetTimeUs() - start_time;
 
-    ++m_current_index;
-    if (m_current_index >= m_threads)
-      m_current_index -= m_threads;
+    if (GetStatus() != ConversionResultCode::Success)
+      return;
+
+    m_compress_queue.emplace_back(m_next_submit++, std::move(parameters));
+    lk.unlock();
+    m_work_available.notify_one();
   }
 
   void SetError(ConversionResultCode result)
@@ -92,48 +123,45 @@ public:
     // If we already have an error, don't overwrite it
     ConversionResultCode expected = ConversionResultCode::Success;
     m_result.compare_exchange_strong(expected, result);
+
+    // Wake up CompressAndWrite in case it's waiting for room
+    std::lock_guard lk(m_mutex);
+    m_space_available.notify_all();
   }
 
   ConversionResultCode GetStatus() const { return m_result.load(); }
 
   void Shutdown()
   {
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].compress_ready_event.Wait();
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].compress_done_event.Wait();
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].output_ready_event.Wait();
-
-    m_shutting_down.store(true);
-
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].compress_event.Set();
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].output_event.Set();
-
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].thread.join();
+    {
+      std::lock_guard lk(m_mutex);
+      m_shutting_down = true;
+    }
+    m_work_available.notify_all();
+    m_output_available.notify_all();
 
+    for (std::thread& thread : m_compress_threads)
+      thread.join();
     m_output_thread.join();
+
+    m_shut_down = true;
   }
 
-private:
-  struct CompressThread
+  // Must not be called before Shutdown. The read and byte counts are left for the caller to fill.
+  ConversionStats GetStats() const
   {
-    std::thread thread;
-
-    Common::Event compress_ready_event;
-    Common::Event compress_event;
-    Common::Event compress_done_event;
-    Common::Event output_ready_event;
-    Common::Event output_event;
+    ConversionStats stats;
+    stats.read_stall_time = m_read_stall_time;
+    stats.compress_time = m_compress_time.load();
+    stats.output_time = m_output_time;
+    stats.compress_threads = static_cast<u32>(m_threads);
+    return stats;
+  }
 
-    CompressParameters compress_parameters;
-    OutputParameters output_parameters;
-  };
+private:
+  static constexpr size_t MAX_IN_FLIGHT_PER_THREAD = 2;
 
-  void CompressThreadFunction(CompressThread* state)
+  void CompressThreadFunction()
   {
     CompressThreadState compress_thread_state;
 
@@ -141,67 +169,72 @@ private:
     if (setup_result != ConversionResultCode::Success)
       SetError(setup_result);
 
-    state->compress_ready_event.Set();
-    state->compress_done_event.Set();
-
     while (true)
     {
-      state->compress_event.Wait();
-
-      if (m_shutting_down.load())
+      std::unique_lock lk(m_mutex);
+      m_work_available.wait(lk, [&] { return !m_compress_queue.empty() || m_shutting_down; });
+      if (m_compress_queue.empty())
         return;
 
-      CompressParameters parameters = std::move(state->compress_parameters);
-
-      state->compress_done_event.Reset();
-      state->compress_ready_event.Set();
-
-      ConversionResult<OutputParameters> result =
-          m_compress(&compress_thread_state, std::move(parameters));
+      auto [index, parameters] = std::move(m_compress_queue.front());
+      m_compress_queue.pop_front();
+      lk.unlock();
 
-      if (result)
-      {
-        state->output_ready_event.Wait();
-        state->output_parameters = std::move(*result);
-        state->output_event.Set();
-      }
-      else
+      // After an error, the remaining data is only passed through so that the output thread
+      // doesn't wait for it forever
+      std::optional<OutputParameters> output_parameters;
+      if (GetStatus() == ConversionResultCode::Success)
       {
-        SetError(result.Error());
+        const u64 start_time = Common::Timer::GetTimeUs();
+        ConversionResult<OutputParameters> result =
+            m_compress(&compress_thread_state, std::move(parameters));
+        m_compress_time += Common::Timer::GetTimeUs() - start_time;
+
+        if (result)
+          output_parameters = std::move(*result);
+        else
+          SetError(result.Error());
       }
 
-      state->compress_done_event.Set();
+      lk.lock();
+      m_output_queue.emplace(index, std::move(output_parameters));
+      lk.unlock();
+      m_output_available.notify_one();
     }
   }
 
   void OutputThreadFunction()
   {
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].output_ready_event.Set();
-
-    size_t index = 0;
-
     while (true)
     {
-      CompressThread& compress_thread = m_compress_threads[index];
-
-      compress_thread.output_event.Wait();
-
-      if (m_shutting_down.load())
+      std::unique_lock lk(m_mutex);
+      m_output_available.wait(lk, [&] {
+        return m_output_queue.count(m_next_output) != 0 ||
+               (m_shutting_down && m_next_output == m_next_submit);
+      });
+
+      const auto it = m_output_queue.find(m_next_output);
+      if (it == m_output_queue.end())
         return;
 
-      OutputParameters parameters = std::move(compress_thread.output_parameters);
+      std::optional<OutputParameters> parameters = std::move(it->second);
+      m_output_queue.erase(it);
+      lk.unlock();
 
-      compress_thread.output_ready_event.Set();
-
-      const ConversionResultCode result = m_output(std::move(parameters));
+      if (parameters && GetStatus() == ConversionResultCode::Success)
+      {
+        const u64 start_time = Common::Timer::GetTimeUs();
+        const ConversionResultCode result = m_output(std::move(*parameters));
+        m_output_time += Common::Timer::GetTimeUs() - start_time;
 
-      if (result != ConversionResultCode::Success)
-        SetError(result);
+        if (result != ConversionResultCode::Success)
+          SetError(result);
+      }
 
-      ++index;
-      if (index >= m_threads)
-        index -= m_threads;
+      lk.lock();
+      ++m_next_output;
+      lk.unlock();
+      m_space_available.notify_one();
     }
   }
 
@@ -210,15 +243,27 @@ private:
       m_compress;
   std::function<ConversionResultCode(OutputParameters)> m_output;
 
-  // We can't use std::vector for this, because Common::Event is not movable
-  std::unique_ptr<CompressThread[]> m_compress_threads;
+  std::vector<std::thread> m_compress_threads;
   std::thread m_output_thread;
 
   const size_t m_threads;
-  size_t m_current_index = 0;
+
+  std::mutex m_mutex;
+  std::condition_variable m_work_available;
+  std::condition_variable m_output_available;
+  std::condition_variable m_space_available;
+  std::deque<std::pair<u64, CompressParameters>> m_compress_queue;
+  std::map<u64, std::optional<OutputParameters>> m_output_queue;
+  u64 m_next_submit = 0;
+  u64 m_next_output = 0;
+  bool m_shutting_down = false;
+  bool m_shut_down = false;
 
   std::atomic<ConversionResultCode> m_result = ConversionResultCode::Success;
-  std::atomic<bool> m_shutting_down = false;
+
+  u64 m_read_stall_time = 0;
+  std::atomic<u64> m_compress_time = 0;
+  u64 m_output_time = 0;
 };
 
 }  // namespace DiscIO
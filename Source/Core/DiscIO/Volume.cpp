@@ -105,9 +105,9 @@ std::unique_ptr<VolumeDisc> CreateDisc(std::unique_ptr<BlobReader> reader)
   return TryCreateDisc(reader);
 }
 
-std::unique_ptr<VolumeDisc> CreateDisc(const std::string& path)
+std::unique_ptr<VolumeDisc> CreateDisc(const std::string& path, bool map_plain_images)
 {
-  return CreateDisc(CreateBlobReader(path));
+  return CreateDisc(CreateBlobReader(path, map_plain_images));
 }
 
 static std::unique_ptr<VolumeWAD> TryCreateWAD(std::unique_ptr<BlobReader>& reader)
@@ -4,6 +4,7 @@
 #include "DiscIO/VolumeVerifier.h"
 
 #include <algorithm>
+#include <functional>
 #include <future>
 #include <limits>
 #include <memory>
@@ -31,6 +32,7 @@
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Common/Thread.h"
 #include "Common/Version.h"
 #include "Core/IOS/Device.h"
 #include "Core/IOS/ES/ES.h"
@@ -355,7 +357,15 @@ RedumpVerifier::Result RedumpVerifier::Finish(const Hashes<std::vector<u8>>& has
   return {Status::Unknown, Common::GetStringT("Unknown disc")};
 }
 
-constexpr u64 DEFAULT_READ_SIZE = 0x20000;  // Arbitrary value
+// Large enough to keep the hashing threads busy, and the same as the size of a Wii group
+constexpr u64 DEFAULT_READ_SIZE = 0x200000;
+
+// How many chunks the read thread may get ahead of Process
+constexpr size_t READ_AHEAD_CHUNKS = 4;
+
+// Process waits once this many hashing and verification tasks are queued, so that a slow stage
+// holds back reading instead of letting read data pile up in memory
+constexpr size_t MAX_QUEUED_TASKS = 12;
 
 VolumeVerifier::VolumeVerifier(const Volume& volume, bool redump_verification,
                                Hashes<bool> hashes_to_calculate)
@@ -371,6 +381,7 @@ VolumeVerifier::VolumeVerifier(const Volume& volume, bool redump_verification,
 
 VolumeVerifier::~VolumeVerifier()
 {
+  StopReading();
   WaitForAsyncOperations();
 }
 
@@ -1054,148 +1065,271 @@ void VolumeVerifier::SetUpHashing()
     mbedtls_sha1_init(&m_sha1_context);
     mbedtls_sha1_starts_ret(&m_sha1_context);
   }
-}
 
-void VolumeVerifier::WaitForAsyncOperations() const
-{
-  if (m_crc32_future.valid())
-    m_crc32_future.wait();
-  if (m_md5_future.valid())
-    m_md5_future.wait();
-  if (m_sha1_future.valid())
-    m_sha1_future.wait();
-  if (m_content_future.valid())
-    m_content_future.wait();
-  if (m_group_future.valid())
-    m_group_future.wait();
-}
+  const auto run_task = [this](Task task) {
+    task();
 
-bool VolumeVerifier::ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read)
-{
-  std::vector<u8> data(bytes_to_read);
+    {
+      std::lock_guard lk(m_tasks_mutex);
+      --m_queued_tasks;
+    }
+    m_task_finished.notify_all();
+  };
 
-  const u64 bytes_to_copy = std::min(m_excess_bytes, bytes_to_read);
-  if (bytes_to_copy > 0)
-    std::memcpy(data.data(), m_data.data() + m_data.size() - m_excess_bytes, bytes_to_copy);
-  bytes_to_read -= bytes_to_copy;
+  if (m_hashes_to_calculate.crc32)
+    m_crc32_worker.Reset(run_task);
+  if (m_hashes_to_calculate.md5)
+    m_md5_worker.Reset(run_task);
+  if (m_hashes_to_calculate.sha1)
+    m_sha1_worker.Reset(run_task);
+  if (!m_content_offsets.empty())
+    m_content_worker.Reset(run_task);
 
-  if (bytes_to_read > 0)
+  // CheckPartition has already made the volume load each partition's key and H3 table, so
+  // CheckBlockIntegrity can safely be called from several threads at once
+  if (!m_groups.empty())
   {
-    if (!m_volume.Read(m_progress + bytes_to_copy, bytes_to_read, data.data() + bytes_to_copy,
-                       PARTITION_NONE))
-    {
-      return false;
-    }
+    m_group_worker_count = std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1,
+                                              m_group_workers.size());
+    for (size_t i = 0; i < m_group_worker_count; ++i)
+      m_group_workers[i].Reset(run_task);
   }
 
-  WaitForAsyncOperations();
-  m_data = std::move(data);
-  return true;
+  PlanReads();
+  m_read_thread = std::thread(&VolumeVerifier::ReadThreadFunction, this);
 }
 
-void VolumeVerifier::Process()
+void VolumeVerifier::PlanReads()
 {
-  ASSERT(m_started);
-  ASSERT(!m_done);
+  u64 progress = 0;
+  u16 content_index = 0;
+  size_t group_index = 0;
 
-  if (m_progress == m_max_progress)
-    return;
-
-  IOS::ES::Content content{};
-  bool content_read = false;
-  bool group_read = false;
-  u64 bytes_to_read = DEFAULT_READ_SIZE;
-  u64 excess_bytes = 0;
-  if (m_content_index < m_content_offsets.size() &&
-      m_content_offsets[m_content_index] == m_progress)
+  while (progress < m_max_progress)
   {
-    m_volume.GetTMD(PARTITION_NONE).GetContent(m_content_index, &content);
-    bytes_to_read = Common::AlignUp(content.size, 0x40);
-    content_read = true;
+    ChunkToRead chunk{progress, DEFAULT_READ_SIZE, 0, std::nullopt, std::nullopt};
 
-    const u16 next_content_index = m_content_index + 1;
-    if (next_content_index < m_content_offsets.size() &&
-        m_content_offsets[next_content_index] < m_progress + bytes_to_read)
+    if (content_index < m_content_offsets.size() && m_content_offsets[content_index] == progress)
     {
-      excess_bytes = m_progress + bytes_to_read - m_content_offsets[next_content_index];
+      IOS::ES::Content content{};
+      m_volume.GetTMD(PARTITION_NONE).GetContent(content_index, &content);
+      chunk.size = Common::AlignUp(content.size, 0x40);
+      chunk.content_index = content_index;
+
+      const u16 next_content_index = content_index + 1;
+      if (next_content_index < m_content_offsets.size() &&
+          m_content_offsets[next_content_index] < progress + chunk.size)
+      {
+        chunk.excess_bytes = progress + chunk.size - m_content_offsets[next_content_index];
+      }
+
+      ++content_index;
     }
+    else if (content_index < m_content_offsets.size() &&
+             m_content_offsets[content_index] > progress)
+    {
+      chunk.size = std::min(chunk.size, m_content_offsets[content_index] - progress);
+    }
+    else if (group_index < m_groups.size() && m_groups[group_index].offset == progress)
+    {
+      const size_t blocks =
+          m_groups[group_index].block_index_end - m_groups[group_index].block_index_start;
+      chunk.size = VolumeWii::BLOCK_TOTAL_SIZE * blocks;
+      chunk.group_index = group_index;
+
+      if (group_index + 1 < m_groups.size() &&
+          m_groups[group_index + 1].offset < progress + chunk.size)
+      {
+        chunk.excess_bytes = progress + chunk.size - m_groups[group_index + 1].offset;
+      }
+
+      ++group_index;
+    }
+    else if (group_index < m_groups.size() && m_groups[group_index].offset > progress)
+    {
+      chunk.size = std::min(chunk.size, m_groups[group_index].offset - progress);
+    }
+
+    if (progress + chunk.size > m_max_progress)
+    {
+      const u64 bytes_over_max = progress + chunk.size - m_max_progress;
+      chunk.size -= bytes_over_max;
+      if (chunk.excess_bytes < bytes_over_max)
+        chunk.excess_bytes = 0;
+      else
+        chunk.excess_bytes -= bytes_over_max;
+    }
+
+    progress += chunk.size - chunk.excess_bytes;
+    m_chunks.push_back(chunk);
   }
-  else if (m_content_index < m_content_offsets.size() &&
-           m_content_offsets[m_content_index] > m_progress)
-  {
-    bytes_to_read = std::min(bytes_to_read, m_content_offsets[m_content_index] - m_progress);
-  }
-  else if (m_group_index < m_groups.size() && m_groups[m_group_index].offset == m_progress)
+}
+
+void VolumeVerifier::ReadThreadFunction()
+{
+  Common::SetCurrentThreadName("Volume verifier reader");
+
+  for (const ChunkToRead& chunk : m_chunks)
   {
-    const size_t blocks =
-        m_groups[m_group_index].block_index_end - m_groups[m_group_index].block_index_start;
-    bytes_to_read = VolumeWii::BLOCK_TOTAL_SIZE * blocks;
-    group_read = true;
+    {
+      std::unique_lock lk(m_read_mutex);
+      m_read_space_available.wait(
+          lk, [&] { return m_stop_reading || m_read_chunks.size() < READ_AHEAD_CHUNKS; });
+      if (m_stop_reading)
+        return;
+    }
+
+    ReadChunk read_chunk{nullptr, false};
+
+    // Chunks that overlap with the next one are read in full rather than sharing the overlapping
+    // data with the next chunk. This is rare and the overlap is small.
+    if (m_calculating_any_hash || chunk.content_index || chunk.group_index)
+    {
+      auto data = std::make_shared<std::vector<u8>>(chunk.size);
+      read_chunk.read_succeeded =
+          chunk.size == 0 || m_volume.Read(chunk.offset, chunk.size, data->data(), PARTITION_NONE);
+      read_chunk.data = std::move(data);
+    }
 
-    if (m_group_index + 1 < m_groups.size() &&
-        m_groups[m_group_index + 1].offset < m_progress + bytes_to_read)
     {
-      excess_bytes = m_progress + bytes_to_read - m_groups[m_group_index + 1].offset;
+      std::lock_guard lk(m_read_mutex);
+      m_read_chunks.push_back(std::move(read_chunk));
     }
+    m_read_done.notify_one();
   }
-  else if (m_group_index < m_groups.size() && m_groups[m_group_index].offset > m_progress)
+}
+
+void VolumeVerifier::StopReading()
+{
+  if (!m_read_thread.joinable())
+    return;
+
+  {
+    std::lock_guard lk(m_read_mutex);
+    m_stop_reading = true;
+  }
+  m_read_space_available.notify_one();
+  m_read_thread.join();
+}
+
+VolumeVerifier::ReadChunk VolumeVerifier::GetNextReadChunk()
+{
+  std::unique_lock lk(m_read_mutex);
+  m_read_done.wait(lk, [&] { return !m_read_chunks.empty(); });
+
+  ReadChunk read_chunk = std::move(m_read_chunks.front());
+  m_read_chunks.pop_front();
+  lk.unlock();
+
+  m_read_space_available.notify_one();
+  return read_chunk;
+}
+
+void VolumeVerifier::QueueTask(Common::WorkQueueThread<Task>* worker, Task task)
+{
   {
-    bytes_to_read = std::min(bytes_to_read, m_groups[m_group_index].offset - m_progress);
+    std::unique_lock lk(m_tasks_mutex);
+    m_task_finished.wait(lk, [&] { return m_queued_tasks < MAX_QUEUED_TASKS; });
+    ++m_queued_tasks;
   }
 
-  if (m_progress + bytes_to_read > m_max_progress)
+  worker->EmplaceItem(std::move(task));
+}
+
+void VolumeVerifier::WaitForAsyncOperations()
+{
+  std::unique_lock lk(m_tasks_mutex);
+  m_task_finished.wait(lk, [&] { return m_queued_tasks == 0; });
+}
+
+void VolumeVerifier::VerifyGroup(const GroupToVerify& group, const u8* data)
+{
+  u64 offset_in_group = 0;
+  for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
+       ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
   {
-    const u64 bytes_over_max = m_progress + bytes_to_read - m_max_progress;
-    bytes_to_read -= bytes_over_max;
-    if (excess_bytes < bytes_over_max)
-      excess_bytes = 0;
+    const u64 block_offset = group.offset + offset_in_group;
+
+    if (data && m_volume.CheckBlockIntegrity(block_index, data + offset_in_group, group.partition))
+    {
+      std::lock_guard lk(m_block_errors_mutex);
+      m_biggest_verified_offset =
+          std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
+    }
+    else if (m_scrubber.CanBlockBeScrubbed(block_offset))
+    {
+      WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
+      std::lock_guard lk(m_block_errors_mutex);
+      m_unused_block_errors[group.partition]++;
+    }
     else
-      excess_bytes -= bytes_over_max;
+    {
+      WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
+      std::lock_guard lk(m_block_errors_mutex);
+      m_block_errors[group.partition]++;
+    }
   }
+}
 
-  const bool is_data_needed = m_calculating_any_hash || content_read || group_read;
-  const bool read_succeeded = is_data_needed && ReadChunkAndWaitForAsyncOperations(bytes_to_read);
+void VolumeVerifier::Process()
+{
+  ASSERT(m_started);
+  ASSERT(!m_done);
 
-  if (!read_succeeded)
+  if (m_progress == m_max_progress)
+    return;
+
+  const ChunkToRead& chunk = m_chunks[m_chunk_index++];
+  const ReadChunk read_chunk = GetNextReadChunk();
+
+  const bool is_data_needed =
+      m_calculating_any_hash || chunk.content_index.has_value() || chunk.group_index.has_value();
+  const bool read_failed = is_data_needed && (!read_chunk.data || !read_chunk.read_succeeded);
+
+  if (read_failed)
   {
-    ERROR_LOG_FMT(DISCIO, "Read failed at {:#x} to {:#x}", m_progress, m_progress + bytes_to_read);
+    ERROR_LOG_FMT(DISCIO, "Read failed at {:#x} to {:#x}", chunk.offset, chunk.offset + chunk.size);
 
     m_read_errors_occurred = true;
     m_calculating_any_hash = false;
   }
 
-  m_excess_bytes = excess_bytes;
-  const u64 byte_increment = bytes_to_read - excess_bytes;
+  // The tasks keep the data alive for as long as they need it
+  const std::shared_ptr<const std::vector<u8>> data = read_failed ? nullptr : read_chunk.data;
+  const u64 byte_increment = chunk.size - chunk.excess_bytes;
 
   if (m_calculating_any_hash)
   {
     if (m_hashes_to_calculate.crc32)
     {
-      m_crc32_future = std::async(std::launch::async, [this, byte_increment] {
+      QueueTask(&m_crc32_worker, [this, data, byte_increment] {
         m_crc32_context =
-            Common::UpdateCRC32(m_crc32_context, m_data.data(), static_cast<u32>(byte_increment));
+            Common::UpdateCRC32(m_crc32_context, data->data(), static_cast<u32>(byte_increment));
       });
     }
 
     if (m_hashes_to_calculate.md5)
     {
-      m_md5_future = std::async(std::launch::async, [this, byte_increment] {
-        mbedtls_md5_update_ret(&m_md5_context, m_data.data(), byte_increment);
+      QueueTask(&m_md5_worker, [this, data, byte_increment] {
+        mbedtls_md5_update_ret(&m_md5_context, data->data(), byte_increment);
       });
     }
 
     if (m_hashes_to_calculate.sha1)
     {
-      m_sha1_future = std::async(std::launch::async, [this, byte_increment] {
-        mbedtls_sha1_update_ret(&m_sha1_context, m_data.data(), byte_increment);
+      QueueTask(&m_sha1_worker, [this, data, byte_increment] {
+        mbedtls_sha1_update_ret(&m_sha1_context, data->data(), byte_increment);
       });
     }
   }
 
-  if (content_read)
+  if (chunk.content_index)
   {
-    m_content_future = std::async(std::launch::async, [this, read_succeeded, content] {
-      if (!read_succeeded || !m_volume.CheckContentIntegrity(content, m_data, m_ticket))
+    IOS::ES::Content content{};
+    m_volume.GetTMD(PARTITION_NONE).GetContent(*chunk.content_index, &content);
+
+    QueueTask(&m_content_worker, [this, data, content] {
+      if (!data || !m_volume.CheckContentIntegrity(content, *data, m_ticket))
       {
         AddProblem(Severity::High, Common::FmtFormatT("Content {0:08x} is corrupt.", content.id));
       }
@@ -1204,38 +1338,12 @@ void VolumeVerifier::Process()
     m_content_index++;
   }
 
-  if (group_read)
+  if (chunk.group_index)
   {
-    m_group_future = std::async(std::launch::async, [this, read_succeeded,
-                                                     group_index = m_group_index] {
-      const GroupToVerify& group = m_groups[group_index];
-      u64 offset_in_group = 0;
-      for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
-           ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
-      {
-        const u64 block_offset = group.offset + offset_in_group;
-
-        if (read_succeeded && m_volume.CheckBlockIntegrity(
-                                  block_index, m_data.data() + offset_in_group, group.partition))
-        {
-          m_biggest_verified_offset =
-              std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
-        }
-        else
-        {
-          if (m_scrubber.CanBlockBeScrubbed(block_offset))
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
-            m_unused_block_errors[group.partition]++;
-          }
-          else
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
-            m_block_errors[group.partition]++;
-          }
-        }
-      }
-    });
+    // Groups don't depend on each other, so they are spread over several workers
+    const GroupToVerify& group = m_groups[*chunk.group_index];
+    QueueTask(&m_group_workers[*chunk.group_index % m_group_worker_count],
+              [this, data, &group] { VerifyGroup(group, data ? data->data() : nullptr); });
 
     m_group_index++;
   }
@@ -1259,6 +1367,7 @@ void VolumeVerifier::Finish()
     return;
   m_done = true;
 
+  StopReading();
   WaitForAsyncOperations();
 
   if (m_calculating_any_hash)
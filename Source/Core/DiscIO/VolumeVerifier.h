@@ -3,16 +3,25 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <future>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <mbedtls/md5.h>
 #include <mbedtls/sha1.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/IOS/ES/Formats.h"
 #include "DiscIO/DiscScrubber.h"
 #include "DiscIO/Volume.h"
@@ -28,6 +37,9 @@
 //
 // Start, Process and Finish may take some time to run.
 //
+// Reading is done ahead of time on a separate thread, and each hash as well as the Wii block
+// checks run on their own worker threads, so Process mostly just hands data over to them.
+//
 // GetResult() can be called before the processing is finished, but the result will be incomplete.
 
 namespace DiscIO
@@ -142,6 +154,26 @@ private:
     size_t block_index_end;
   };
 
+  struct ChunkToRead
+  {
+    u64 offset;
+    u64 size;
+    // Bytes at the end which also belong to the next chunk. They are not hashed as part of this
+    // chunk and don't count towards the progress.
+    u64 excess_bytes;
+    std::optional<u16> content_index;
+    std::optional<size_t> group_index;
+  };
+
+  struct ReadChunk
+  {
+    // Null if the data wasn't needed
+    std::shared_ptr<const std::vector<u8>> data;
+    bool read_succeeded;
+  };
+
+  using Task = std::function<void()>;
+
   std::vector<Partition> CheckPartitions();
   bool CheckPartition(const Partition& partition);  // Returns false if partition should be ignored
   std::string GetPartitionName(std::optional<u32> type) const;
@@ -154,8 +186,13 @@ private:
   void CheckMisc();
   void CheckSuperPaperMario();
   void SetUpHashing();
-  void WaitForAsyncOperations() const;
-  bool ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read);
+  void PlanReads();
+  void ReadThreadFunction();
+  void StopReading();
+  ReadChunk GetNextReadChunk();
+  void QueueTask(Common::WorkQueueThread<Task>* worker, Task task);
+  void WaitForAsyncOperations();
+  void VerifyGroup(const GroupToVerify& group, const u8* data);
 
   void AddProblem(Severity severity, std::string text);
 
@@ -171,18 +208,25 @@ private:
   bool m_read_errors_occurred = false;
 
   Hashes<bool> m_hashes_to_calculate{};
-  bool m_calculating_any_hash = false;
+  // Also read by the read thread
+  std::atomic<bool> m_calculating_any_hash = false;
   u32 m_crc32_context = 0;
   mbedtls_md5_context m_md5_context{};
   mbedtls_sha1_context m_sha1_context{};
 
-  u64 m_excess_bytes = 0;
-  std::vector<u8> m_data;
-  std::future<void> m_crc32_future;
-  std::future<void> m_md5_future;
-  std::future<void> m_sha1_future;
-  std::future<void> m_content_future;
-  std::future<void> m_group_future;
+  std::vector<ChunkToRead> m_chunks;
+  size_t m_chunk_index = 0;
+
+  std::thread m_read_thread;
+  std::mutex m_read_mutex;
+  std::condition_variable m_read_done;
+  std::condition_variable m_read_space_available;
+  std::deque<ReadChunk> m_read_chunks;
+  bool m_stop_reading = false;
+
+  std::mutex m_tasks_mutex;
+  std::condition_variable m_task_finished;
+  size_t m_queued_tasks = 0;
 
   DiscScrubber m_scrubber;
   IOS::ES::TicketReader m_ticket;
@@ -190,6 +234,8 @@ private:
   u16 m_content_index = 0;
   std::vector<GroupToVerify> m_groups;
   size_t m_group_index = 0;  // Index in m_groups, not index in a specific partition
+  // Guards the block error counts and m_biggest_verified_offset while groups are being verified
+  std::mutex m_block_errors_mutex;
   std::map<Partition, size_t> m_block_errors;
   std::map<Partition, size_t> m_unused_block_errors;
 
@@ -200,6 +246,14 @@ private:
   bool m_done = false;
   u64 m_progress = 0;
   u64 m_max_progress = 0;
+
+  // Declared last so that they are shut down before anything they use is destroyed
+  Common::WorkQueueThread<Task> m_crc32_worker;
+  Common::WorkQueueThread<Task> m_md5_worker;
+  Common::WorkQueueThread<Task> m_sha1_worker;
+  Common::WorkQueueThread<Task> m_content_worker;
+  std::array<Common::WorkQueueThread<Task>, 4> m_group_workers;
+  size_t m_group_worker_count = 0;
 };
 
 }  // namespace DiscIO
@@ -11,6 +11,7 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <thread>
 #include <type_traits>
 #include <utility>
 
@@ -27,6 +28,7 @@
 #include "Common/MsgHandler.h"
 #include "Common/ScopeGuard.h"
 #include "Common/Swap.h"
+#include "Common/Timer.h"
 
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscUtils.h"
@@ -79,13 +81,24 @@ std::pair<int, int> GetAllowedCompressionLevels(WIARVZCompressionType compressio
 
 template <bool RVZ>
 WIARVZFileReader<RVZ>::WIARVZFileReader(File::IOFile file, const std::string& path)
-    : m_file(std::move(file)), m_encryption_cache(this)
+    : m_file(std::move(file)), m_path(path), m_encryption_cache(this)
 {
   m_valid = Initialize(path);
 }
 
 template <bool RVZ>
-WIARVZFileReader<RVZ>::~WIARVZFileReader() = default;
+WIARVZFileReader<RVZ>::~WIARVZFileReader()
+{
+  for (std::unique_ptr<PrefetchWorker>& worker : m_prefetch_workers)
+    worker->thread.Cancel();
+
+  const ChunkCacheStats stats = GetChunkCacheStats();
+  INFO_LOG_FMT(DISCIO,
+               "Chunk cache: {} hits, {} misses, {} chunks read ahead in {} ms, "
+               "{} ms spent reading",
+               stats.hits, stats.misses, stats.prefetched_chunks, stats.prefetch_decode_us / 1000,
+               stats.read_us / 1000);
+}
 
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
@@ -240,6 +253,28 @@ bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
   return true;
 }
 
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::StartPrefetchWorkers()
+{
+  const unsigned int worker_count =
+      std::clamp(std::thread::hardware_concurrency() / 2, 1u, MAX_PREFETCH_WORKERS);
+
+  for (unsigned int i = 0; i < worker_count; ++i)
+  {
+    // Each worker has its own file handle so that reading doesn't have to be serialized
+    auto worker = std::make_unique<PrefetchWorker>();
+    if (!worker->file.Open(m_path, "rb"))
+    {
+      WARN_LOG_FMT(DISCIO, "Failed to open {} for read-ahead", m_path);
+      break;
+    }
+
+    File::IOFile* file = &worker->file;
+    worker->thread.Reset([this, file](ChunkRequest request) { Prefetch(file, request); });
+    m_prefetch_workers.push_back(std::move(worker));
+  }
+}
+
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::HasDataOverlap() const
 {
@@ -290,6 +325,18 @@ BlobType WIARVZFileReader<RVZ>::GetBlobType() const
   return RVZ ? BlobType::RVZ : BlobType::WIA;
 }
 
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::ChunkCacheStats WIARVZFileReader<RVZ>::GetChunkCacheStats() const
+{
+  ChunkCacheStats stats;
+  stats.hits = m_stats_hits.load();
+  stats.misses = m_stats_misses.load();
+  stats.prefetched_chunks = m_stats_prefetched_chunks.load();
+  stats.prefetch_decode_us = m_stats_prefetch_decode_us.load();
+  stats.read_us = m_stats_read_us.load();
+  return stats;
+}
+
 template <bool RVZ>
 std::string WIARVZFileReader<RVZ>::GetCompressionMethod() const
 {
@@ -505,42 +552,29 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
     if (total_group_index >= m_group_entries.size())
       return false;
 
-    const GroupEntry group = m_group_entries[total_group_index];
     const u64 group_offset_in_data = i * chunk_size;
     const u64 offset_in_group = *offset - group_offset_in_data - data_offset;
 
     chunk_size = std::min(chunk_size, data_size - group_offset_in_data);
 
     const u64 bytes_to_read = std::min(chunk_size - offset_in_group, *size);
-    u32 group_data_size = Common::swap32(group.data_size);
-
-    WIARVZCompressionType compression_type = m_compression_type;
-    u32 rvz_packed_size = 0;
-    if constexpr (RVZ)
-    {
-      if ((group_data_size & 0x80000000) == 0)
-        compression_type = WIARVZCompressionType::None;
-
-      group_data_size &= 0x7FFFFFFF;
 
-      rvz_packed_size = Common::swap32(group.rvz_packed_size);
-    }
-
-    if (group_data_size == 0)
+    ChunkRequest request;
+    if (!GetGroupChunkRequest(total_group_index, group_offset_in_data, chunk_size, exception_lists,
+                              &request))
     {
       std::memset(*out_ptr, 0, bytes_to_read);
     }
     else
     {
-      const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
-
-      Chunk& chunk =
-          ReadCompressedData(group_offset_in_file, group_data_size, chunk_size, compression_type,
-                             exception_lists, rvz_packed_size, group_offset_in_data);
+      const u64 start_time = Common::Timer::GetTimeUs();
+      Chunk& chunk = ReadCompressedData(request);
+      const bool success = chunk.Read(offset_in_group, bytes_to_read, *out_ptr);
+      m_stats_read_us += Common::Timer::GetTimeUs() - start_time;
 
-      if (!chunk.Read(offset_in_group, bytes_to_read, *out_ptr))
+      if (!success)
       {
-        m_cached_chunk_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
+        InvalidateCachedChunk(request.offset_in_file);
         return false;
       }
 
@@ -555,6 +589,15 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
       }
     }
 
+    // Only start reading ahead once the current group has been read, so that the current group
+    // isn't competing with the read-ahead for the file and for the prefetch workers
+    if (total_group_index != m_last_group_index)
+    {
+      if (total_group_index == m_last_group_index + 1)
+        ReadAhead(i + 1, chunk_size, data_size, group_index, number_of_groups, exception_lists);
+      m_last_group_index = total_group_index;
+    }
+
     *offset += bytes_to_read;
     *size -= bytes_to_read;
     *out_ptr += bytes_to_read;
@@ -563,6 +606,137 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
   return true;
 }
 
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::GetGroupChunkRequest(u64 total_group_index, u64 group_offset_in_data,
+                                                 u64 chunk_size, u32 exception_lists,
+                                                 ChunkRequest* request) const
+{
+  const GroupEntry group = m_group_entries[total_group_index];
+  u32 group_data_size = Common::swap32(group.data_size);
+
+  WIARVZCompressionType compression_type = m_compression_type;
+  u32 rvz_packed_size = 0;
+  if constexpr (RVZ)
+  {
+    if ((group_data_size & 0x80000000) == 0)
+      compression_type = WIARVZCompressionType::None;
+
+    group_data_size &= 0x7FFFFFFF;
+
+    rvz_packed_size = Common::swap32(group.rvz_packed_size);
+  }
+
+  if (group_data_size == 0)
+    return false;
+
+  const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
+
+  *request = {group_offset_in_file, group_data_size,  chunk_size,         compression_type,
+              exception_lists,      rvz_packed_size, group_offset_in_data};
+  return true;
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::ReadAhead(u64 group_index, u64 chunk_size, u64 data_size,
+                                      u32 first_group_index, u32 number_of_groups,
+                                      u32 exception_lists)
+{
+  // Many readers are only used for a few scattered reads, so the workers are only started once
+  // something is read sequentially
+  if (!m_prefetch_workers_started)
+  {
+    StartPrefetchWorkers();
+    m_prefetch_workers_started = true;
+  }
+
+  if (m_prefetch_workers.empty())
+    return;
+
+  const u64 count =
+      std::clamp(READ_AHEAD_SIZE / chunk_size, MIN_READ_AHEAD_CHUNKS, MAX_READ_AHEAD_CHUNKS);
+  const u64 end = std::min<u64>(group_index + count, number_of_groups);
+
+  std::vector<ChunkRequest> requests;
+  for (u64 i = group_index; i < end; ++i)
+  {
+    const u64 total_group_index = first_group_index + i;
+    const u64 group_offset_in_data = i * chunk_size;
+    if (total_group_index >= m_group_entries.size() || group_offset_in_data >= data_size)
+      break;
+
+    ChunkRequest request;
+    if (!GetGroupChunkRequest(total_group_index, group_offset_in_data,
+                              std::min(chunk_size, data_size - group_offset_in_data),
+                              exception_lists, &request))
+    {
+      continue;
+    }
+
+    if (FindCachedChunk(request.offset_in_file) == m_cached_chunks.end())
+      requests.push_back(request);
+  }
+
+  std::lock_guard lk(m_prefetch_mutex);
+
+  // Drop read-ahead that the reader has moved past or away from
+  for (auto it = m_prefetched_chunks.begin(); it != m_prefetched_chunks.end();)
+  {
+    const bool wanted = std::any_of(requests.begin(), requests.end(), [&](const ChunkRequest& r) {
+      return r.offset_in_file == it->first;
+    });
+    if (!wanted && it->second.state != PrefetchState::Decoding)
+      it = m_prefetched_chunks.erase(it);
+    else
+      ++it;
+  }
+
+  for (const ChunkRequest& request : requests)
+  {
+    if (!m_prefetched_chunks.try_emplace(request.offset_in_file).second)
+      continue;
+
+    m_prefetch_workers[m_next_prefetch_worker]->thread.EmplaceItem(request);
+    m_next_prefetch_worker = (m_next_prefetch_worker + 1) % m_prefetch_workers.size();
+  }
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::Prefetch(File::IOFile* file, const ChunkRequest& request)
+{
+  {
+    std::lock_guard lk(m_prefetch_mutex);
+    const auto it = m_prefetched_chunks.find(request.offset_in_file);
+    if (it == m_prefetched_chunks.end() || it->second.state != PrefetchState::Queued)
+      return;  // No longer wanted, or already being handled by someone else
+    it->second.state = PrefetchState::Decoding;
+  }
+
+  const u64 start_time = Common::Timer::GetTimeUs();
+  Chunk chunk = CreateChunk(file, request);
+  const bool success = chunk.DecompressAll();
+  m_stats_prefetch_decode_us += Common::Timer::GetTimeUs() - start_time;
+
+  {
+    std::lock_guard lk(m_prefetch_mutex);
+
+    // Entries that are being decoded are never removed by anyone else
+    const auto it = m_prefetched_chunks.find(request.offset_in_file);
+    if (success)
+    {
+      it->second.chunk = std::move(chunk);
+      it->second.state = PrefetchState::Done;
+      ++m_stats_prefetched_chunks;
+    }
+    else
+    {
+      // Let the reader run into the error on its own, so that it gets reported the usual way
+      m_prefetched_chunks.erase(it);
+    }
+  }
+
+  m_prefetch_done.notify_all();
+}
+
 template <bool RVZ>
 typename WIARVZFileReader<RVZ>::Chunk&
 WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_size,
@@ -570,11 +744,93 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
                                           WIARVZCompressionType compression_type,
                                           u32 exception_lists, u32 rvz_packed_size, u64 data_offset)
 {
-  if (offset_in_file == m_cached_chunk_offset)
-    return m_cached_chunk;
+  return ReadCompressedData({offset_in_file, compressed_size, decompressed_size, compression_type,
+                             exception_lists, rvz_packed_size, data_offset});
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk&
+WIARVZFileReader<RVZ>::ReadCompressedData(const ChunkRequest& request)
+{
+  const auto cached = FindCachedChunk(request.offset_in_file);
+  if (cached != m_cached_chunks.end())
+  {
+    m_cached_chunks.splice(m_cached_chunks.begin(), m_cached_chunks, cached);
+    ++m_stats_hits;
+    return m_cached_chunks.front().second;
+  }
+
+  Chunk chunk;
+  bool prefetched = false;
+  if (!m_prefetch_workers.empty())
+  {
+    std::unique_lock lk(m_prefetch_mutex);
+    auto it = m_prefetched_chunks.find(request.offset_in_file);
+    m_prefetch_done.wait(lk, [&] {
+      it = m_prefetched_chunks.find(request.offset_in_file);
+      return it == m_prefetched_chunks.end() || it->second.state != PrefetchState::Decoding;
+    });
+
+    if (it != m_prefetched_chunks.end())
+    {
+      // If a worker hasn't gotten to the chunk yet, we take it over instead of waiting
+      prefetched = it->second.state == PrefetchState::Done;
+      if (prefetched)
+        chunk = std::move(it->second.chunk);
+      m_prefetched_chunks.erase(it);
+    }
+  }
+
+  if (prefetched)
+  {
+    ++m_stats_hits;
+  }
+  else
+  {
+    ++m_stats_misses;
+    chunk = CreateChunk(&m_file, request);
+  }
+
+  m_cached_chunks_memory_usage += chunk.GetMemoryUsage();
+  m_cached_chunks.emplace_front(request.offset_in_file, std::move(chunk));
+
+  while (m_cached_chunks_memory_usage > CHUNK_CACHE_SIZE && m_cached_chunks.size() > 1)
+  {
+    m_cached_chunks_memory_usage -= m_cached_chunks.back().second.GetMemoryUsage();
+    m_cached_chunks.pop_back();
+  }
+
+  return m_cached_chunks.front().second;
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::CachedChunks::iterator
+WIARVZFileReader<RVZ>::FindCachedChunk(u64 offset_in_file)
+{
+  return std::find_if(m_cached_chunks.begin(), m_cached_chunks.end(),
+                      [&](const auto& c) { return c.first == offset_in_file; });
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::InvalidateCachedChunk(u64 offset_in_file)
+{
+  const auto it = FindCachedChunk(offset_in_file);
+  if (it == m_cached_chunks.end())
+    return;
+
+  m_cached_chunks_memory_usage -= it->second.GetMemoryUsage();
+  m_cached_chunks.erase(it);
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk
+WIARVZFileReader<RVZ>::CreateChunk(File::IOFile* file, const ChunkRequest& request) const
+{
+  const u64 decompressed_size = request.decompressed_size;
+  const u32 rvz_packed_size = request.rvz_packed_size;
 
   std::unique_ptr<Decompressor> decompressor;
-  switch (compression_type)
+  switch (request.compression_type)
   {
   case WIARVZCompressionType::None:
     decompressor = std::make_unique<NoneDecompressor>();
@@ -599,13 +855,12 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
     break;
   }
 
-  const bool compressed_exception_lists = compression_type > WIARVZCompressionType::Purge;
+  const bool compressed_exception_lists =
+      request.compression_type > WIARVZCompressionType::Purge;
 
-  m_cached_chunk =
-      Chunk(&m_file, offset_in_file, compressed_size, decompressed_size, exception_lists,
-            compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
-  m_cached_chunk_offset = offset_in_file;
-  return m_cached_chunk;
+  return Chunk(file, request.offset_in_file, request.compressed_size, decompressed_size,
+               request.exception_lists, compressed_exception_lists, rvz_packed_size,
+               request.data_offset, std::move(decompressor));
 }
 
 template <bool RVZ>
@@ -648,17 +903,33 @@ WIARVZFileReader<RVZ>::Chunk::Chunk(File::IOFile* file, u64 offset_in_file, u64
 
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
+{
+  if (!DecompressUntil(offset + size))
+    return false;
+
+  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
+  return true;
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressAll()
+{
+  return DecompressUntil(m_out.data.size() - m_out_bytes_allocated_for_exceptions);
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressUntil(u64 end_offset)
 {
   if (!m_decompressor || !m_file ||
-      offset + size > m_out.data.size() - m_out_bytes_allocated_for_exceptions)
+      end_offset > m_out.data.size() - m_out_bytes_allocated_for_exceptions)
   {
     return false;
   }
 
-  while (offset + size > GetOutBytesWrittenExcludingExceptions())
+  while (end_offset > GetOutBytesWrittenExcludingExceptions())
   {
     u64 bytes_to_read;
-    if (offset + size == m_out.data.size())
+    if (end_offset == m_out.data.size())
     {
       // Read all the remaining data.
       bytes_to_read = m_in.data.size() - m_in.bytes_written;
@@ -671,7 +942,7 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
 
       // The compressed data is probably not much bigger than the decompressed data.
       // Add a few bytes for possible compression overhead and for any hash exceptions.
-      bytes_to_read = offset + size - GetOutBytesWrittenExcludingExceptions() + 0x100;
+      bytes_to_read = end_offset - GetOutBytesWrittenExcludingExceptions() + 0x100;
 
       // Align the access in an attempt to gain speed. But we don't actually know the
       // block size of the underlying storage device, so we just use the Wii block size.
@@ -751,7 +1022,6 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
     }
   }
 
-  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
   return true;
 }
 
@@ -1734,7 +2004,8 @@ template <bool RVZ>
 ConversionResultCode
 WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volume,
                                File::IOFile* outfile, WIARVZCompressionType compression_type,
-                               int compression_level, int chunk_size, CompressCB callback)
+                               int compression_level, int chunk_size, CompressCB callback,
+                               ConversionStats* stats)
 {
   ASSERT(infile->IsDataSizeAccurate());
   ASSERT(chunk_size > 0);
@@ -1744,9 +2015,12 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   const u64 exception_lists_per_chunk = std::max<u64>(1, chunk_size / VolumeWii::GROUP_TOTAL_SIZE);
   const bool compressed_exception_lists = compression_type > WIARVZCompressionType::Purge;
 
+  const u64 start_time = Common::Timer::GetTimeUs();
+
   u64 bytes_read = 0;
   u64 bytes_written = 0;
   size_t groups_processed = 0;
+  u64 read_time = 0;
 
   WIAHeader1 header_1{};
   WIAHeader2 header_2{};
@@ -1901,13 +2175,17 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
         bytes_to_read = std::max<u64>(bytes_to_read, VolumeWii::GROUP_TOTAL_SIZE);
       bytes_to_read = std::min<u64>(bytes_to_read, data_offset + data_size - bytes_read);
 
+      const u64 read_start_time = Common::Timer::GetTimeUs();
       buffer.resize(bytes_to_read);
       if (!infile->Read(bytes_read, bytes_to_read, buffer.data()))
         return ConversionResultCode::ReadFailed;
       bytes_read += bytes_to_read;
+      read_time += Common::Timer::GetTimeUs() - read_start_time;
 
-      mt_compressor.CompressAndWrite(CompressParameters{
-          buffer, &data_entry, data_offset_in_partition, bytes_read, groups_processed});
+      // Hand the buffer over instead of copying it. It gets resized again on the next iteration.
+      mt_compressor.CompressAndWrite(CompressParameters{std::move(buffer), &data_entry,
+                                                        data_offset_in_partition, bytes_read,
+                                                        groups_processed});
 
       data_offset += bytes_to_read;
       data_size -= bytes_to_read;
@@ -1937,6 +2215,23 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   if (status != ConversionResultCode::Success)
     return status;
 
+  ConversionStats conversion_stats = mt_compressor.GetStats();
+  conversion_stats.bytes_read = bytes_read;
+  conversion_stats.bytes_written = bytes_written;
+  conversion_stats.wall_time = Common::Timer::GetTimeUs() - start_time;
+  conversion_stats.read_time = read_time;
+
+  INFO_LOG_FMT(DISCIO,
+               "Converted {} bytes to {} bytes in {} ms using {} threads. Reading: {} ms, "
+               "waiting for compression: {} ms, compression (all threads): {} ms, output: {} ms",
+               conversion_stats.bytes_read, conversion_stats.bytes_written,
+               conversion_stats.wall_time / 1000, conversion_stats.compress_threads,
+               conversion_stats.read_time / 1000, conversion_stats.read_stall_time / 1000,
+               conversion_stats.compress_time / 1000, conversion_stats.output_time / 1000);
+
+  if (stats)
+    *stats = conversion_stats;
+
   std::unique_ptr<Compressor> compressor;
   SetUpCompressor(&compressor, compression_type, compression_level, &header_2);
 
@@ -2035,7 +2330,7 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                        const std::string& outfile_path, bool rvz,
                        WIARVZCompressionType compression_type, int compression_level,
-                       int chunk_size, CompressCB callback)
+                       int chunk_size, CompressCB callback, ConversionStats* stats)
 {
   File::IOFile outfile(outfile_path, "wb");
   if (!outfile)
@@ -2053,7 +2348,7 @@ bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
   const auto convert = rvz ? RVZFileReader::Convert : WIAFileReader::Convert;
   const ConversionResultCode result =
       convert(infile, infile_volume.get(), &outfile, compression_type, compression_level,
-              chunk_size, callback);
+              chunk_size, callback, stats);
 
   if (result == ConversionResultCode::ReadFailed)
     PanicAlertFmtT("Failed to read from the input file \"{0}\".", infile_path);
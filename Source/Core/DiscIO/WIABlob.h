@@ -4,16 +4,22 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
 #include "Common/Swap.h"
+#include "Common/WorkQueueThread.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/MultithreadedCompressor.h"
 #include "DiscIO/WIACompression.h"
@@ -43,6 +49,20 @@ template <bool RVZ>
 class WIARVZFileReader : public BlobReader
 {
 public:
+  struct ChunkCacheStats
+  {
+    // Chunk lookups that were served by the chunk cache or by a finished read-ahead
+    u64 hits = 0;
+    // Chunk lookups that had to be decompressed on the reading thread
+    u64 misses = 0;
+    // Chunks decompressed by the read-ahead threads, and the time they spent doing it
+    u64 prefetched_chunks = 0;
+    u64 prefetch_decode_us = 0;
+    // Time the reading thread spent getting data out of chunks, including decompressing on demand
+    // and waiting for read-ahead that was already in progress
+    u64 read_us = 0;
+  };
+
   ~WIARVZFileReader();
 
   static std::unique_ptr<WIARVZFileReader> Create(File::IOFile file, const std::string& path);
@@ -65,9 +85,13 @@ public:
   bool SupportsReadWiiDecrypted(u64 offset, u64 size, u64 partition_data_offset) const override;
   bool ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset) override;
 
+  // Safe to call from any thread.
+  ChunkCacheStats GetChunkCacheStats() const;
+
   static ConversionResultCode Convert(BlobReader* infile, const VolumeDisc* infile_volume,
                                       File::IOFile* outfile, WIARVZCompressionType compression_type,
-                                      int compression_level, int chunk_size, CompressCB callback);
+                                      int compression_level, int chunk_size, CompressCB callback,
+                                      ConversionStats* stats = nullptr);
 
 private:
   using SHA1 = std::array<u8, 20>;
@@ -192,6 +216,9 @@ private:
           u64 data_offset, std::unique_ptr<Decompressor> decompressor);
 
     bool Read(u64 offset, u64 size, u8* out_ptr);
+    bool DecompressAll();
+
+    size_t GetMemoryUsage() const { return m_in.data.size() + m_out.data.size(); }
 
     // This can only be called once at least one byte of data has been read
     void GetHashExceptions(std::vector<HashExceptionEntry>* exception_list,
@@ -204,6 +231,7 @@ private:
     }
 
   private:
+    bool DecompressUntil(u64 end_offset);
     bool Decompress();
     bool HandleExceptions(const u8* data, size_t bytes_allocated, size_t bytes_written,
                           size_t* bytes_used, bool align);
@@ -227,8 +255,42 @@ private:
     u64 m_data_offset = 0;
   };
 
+  // Everything needed to construct a Chunk, so that it can be handed to a read-ahead thread
+  struct ChunkRequest
+  {
+    u64 offset_in_file;
+    u64 compressed_size;
+    u64 decompressed_size;
+    WIARVZCompressionType compression_type;
+    u32 exception_lists;
+    u32 rvz_packed_size;
+    u64 data_offset;
+  };
+
+  enum class PrefetchState
+  {
+    Queued,
+    Decoding,
+    Done,
+  };
+
+  struct PrefetchedChunk
+  {
+    PrefetchState state = PrefetchState::Queued;
+    Chunk chunk;
+  };
+
+  using CachedChunks = std::list<std::pair<u64, Chunk>>;
+
+  struct PrefetchWorker
+  {
+    File::IOFile file;
+    Common::WorkQueueThread<ChunkRequest> thread;
+  };
+
   explicit WIARVZFileReader(File::IOFile file, const std::string& path);
   bool Initialize(const std::string& path);
+  void StartPrefetchWorkers();
   bool HasDataOverlap() const;
 
   const PartitionEntry* GetPartition(u64 partition_data_offset, u32* partition_first_sector) const;
@@ -239,6 +301,17 @@ private:
   Chunk& ReadCompressedData(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
                             WIARVZCompressionType compression_type, u32 exception_lists = 0,
                             u32 rvz_packed_size = 0, u64 data_offset = 0);
+  Chunk& ReadCompressedData(const ChunkRequest& request);
+  Chunk CreateChunk(File::IOFile* file, const ChunkRequest& request) const;
+  typename CachedChunks::iterator FindCachedChunk(u64 offset_in_file);
+  void InvalidateCachedChunk(u64 offset_in_file);
+
+  // Returns false if the group has no data stored in the file
+  bool GetGroupChunkRequest(u64 total_group_index, u64 group_offset_in_data, u64 chunk_size,
+                            u32 exception_lists, ChunkRequest* request) const;
+  void ReadAhead(u64 group_index, u64 chunk_size, u64 data_size, u32 first_group_index,
+                 u32 number_of_groups, u32 exception_lists);
+  void Prefetch(File::IOFile* file, const ChunkRequest& request);
 
   static bool ApplyHashExceptions(const std::vector<HashExceptionEntry>& exception_list,
                                   VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]);
@@ -365,8 +438,29 @@ private:
   WIARVZCompressionType m_compression_type;
 
   File::IOFile m_file;
-  Chunk m_cached_chunk;
-  u64 m_cached_chunk_offset = std::numeric_limits<u64>::max();
+  std::string m_path;
+
+  // Decompressed chunks keyed by offset in file, most recently used first. Only accessed by the
+  // thread that calls Read.
+  CachedChunks m_cached_chunks;
+  size_t m_cached_chunks_memory_usage = 0;
+
+  // When consecutive groups are read, the following groups are decompressed ahead of time by the
+  // prefetch workers. Finished chunks wait in m_prefetched_chunks until they are read, at which
+  // point they are moved to m_cached_chunks.
+  u64 m_last_group_index = std::numeric_limits<u64>::max();
+  std::map<u64, PrefetchedChunk> m_prefetched_chunks;
+  mutable std::mutex m_prefetch_mutex;
+  std::condition_variable m_prefetch_done;
+  size_t m_next_prefetch_worker = 0;
+  bool m_prefetch_workers_started = false;
+
+  std::atomic<u64> m_stats_hits{0};
+  std::atomic<u64> m_stats_misses{0};
+  std::atomic<u64> m_stats_prefetched_chunks{0};
+  std::atomic<u64> m_stats_prefetch_decode_us{0};
+  std::atomic<u64> m_stats_read_us{0};
+
   WiiEncryptionCache m_encryption_cache;
 
   std::vector<HashExceptionEntry> m_exception_list;
@@ -381,6 +475,16 @@ private:
 
   std::map<u64, DataEntry> m_data_entries;
 
+  // Declared last so that the threads are stopped before anything they use is destroyed
+  std::vector<std::unique_ptr<PrefetchWorker>> m_prefetch_workers;
+
+  // How much decompressed data to keep around, both for read-ahead and for recently read chunks
+  static constexpr u64 READ_AHEAD_SIZE = 8 * 1024 * 1024;
+  static constexpr u64 MIN_READ_AHEAD_CHUNKS = 2;
+  static constexpr u64 MAX_READ_AHEAD_CHUNKS = 64;
+  static constexpr size_t CHUNK_CACHE_SIZE = 32 * 1024 * 1024;
+  static constexpr unsigned int MAX_PREFETCH_WORKERS = 4;
+
   // Perhaps we could set WIA_VERSION_WRITE_COMPATIBLE to 0.9, but WIA version 0.9 was never in
   // any official release of wit, and interim versions (either source or binaries) are hard to find.
   // Since we've been unable to check if we're write compatible with 0.9, we set it 1.0 to be safe.
@@ -231,6 +231,10 @@ void HotkeyScheduler::Run()
       if (IsHotkey(HK_SCREENSHOT))
         emit ScreenShotHotkey();
 
+      // Trace markers
+      if (IsHotkey(HK_CAPTURE_TRACE))
+        emit CaptureTraceHotkey();
+
       // Unlock Cursor
       if (IsHotkey(HK_UNLOCK_CURSOR))
         emit UnlockCursor();
@@ -595,6 +599,9 @@ void HotkeyScheduler::Run()
 
     if (IsHotkey(HK_SAVE_STATE_FILE))
       emit StateSaveFile();
+
+    if (IsHotkey(HK_REWIND, true))
+      emit RewindState();
   }
 }
 
@@ -34,6 +34,7 @@ signals:
   void ResetHotkey();
   void TogglePauseHotkey();
   void ScreenShotHotkey();
+  void CaptureTraceHotkey();
   void RefreshGameListHotkey();
   void SetStateSlotHotkey(int slot);
   void StateLoadSlotHotkey();
@@ -46,6 +47,7 @@ signals:
   void StateSaveFile();
   void StateLoadUndo();
   void StateSaveUndo();
+  void RewindState();
   void StartRecording();
   void PlayRecording();
   void ExportRecording();
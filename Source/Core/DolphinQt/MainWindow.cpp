@@ -604,6 +604,8 @@ void MainWindow::ConnectHotkeys()
   connect(m_hotkey_scheduler, &HotkeyScheduler::StopHotkey, this, &MainWindow::RequestStop);
   connect(m_hotkey_scheduler, &HotkeyScheduler::ResetHotkey, this, &MainWindow::Reset);
   connect(m_hotkey_scheduler, &HotkeyScheduler::ScreenShotHotkey, this, &MainWindow::ScreenShot);
+  connect(m_hotkey_scheduler, &HotkeyScheduler::CaptureTraceHotkey, this,
+          &MainWindow::CaptureTrace);
   connect(m_hotkey_scheduler, &HotkeyScheduler::FullScreenHotkey, this, &MainWindow::FullScreen);
 
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateLoadSlot, this, &MainWindow::StateLoadSlotAt);
@@ -616,6 +618,7 @@ void MainWindow::ConnectHotkeys()
           &MainWindow::StateSaveOldest);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateSaveFile, this, &MainWindow::StateSave);
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateLoadFile, this, &MainWindow::StateLoad);
+  connect(m_hotkey_scheduler, &HotkeyScheduler::RewindState, this, &MainWindow::StateRewind);
 
   connect(m_hotkey_scheduler, &HotkeyScheduler::StateLoadSlotHotkey, this,
           &MainWindow::StateLoadSlot);
@@ -1019,6 +1022,11 @@ void MainWindow::ScreenShot()
   Core::SaveScreenShot();
 }
 
+void MainWindow::CaptureTrace()
+{
+  Core::CaptureTrace();
+}
+
 void MainWindow::ScanForSecondDiscAndStartGame(const UICommon::GameFile& game,
                                                std::unique_ptr<BootSessionData> boot_session_data)
 {
@@ -1431,6 +1439,11 @@ void MainWindow::StateSaveOldest()
   State::SaveFirstSaved();
 }
 
+void MainWindow::StateRewind()
+{
+  State::Rewind();
+}
+
 void MainWindow::SetStateSlot(int slot)
 {
   Settings::Instance().SetStateSlot(slot);
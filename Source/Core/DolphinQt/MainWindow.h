@@ -108,6 +108,7 @@ private:
   void StateLoadUndo();
   void StateSaveUndo();
   void StateSaveOldest();
+  void StateRewind();
   void SetStateSlot(int slot);
   void BootWiiSystemMenu();
 
@@ -118,6 +119,7 @@ private:
   void FullScreen();
   void UnlockCursor();
   void ScreenShot();
+  void CaptureTrace();
 
   void CreateComponents();
 
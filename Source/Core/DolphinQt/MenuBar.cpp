@@ -5,6 +5,7 @@
 
 #include <cinttypes>
 #include <future>
+#include <limits>
 
 #include <QAction>
 #include <QActionGroup>
@@ -13,6 +14,7 @@
 #include <QFontDialog>
 #include <QInputDialog>
 #include <QMap>
+#include <QSignalBlocker>
 #include <QUrl>
 
 #include "Common/CommonPaths.h"
@@ -41,6 +43,7 @@
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/SamplingProfiler.h"
 #include "Core/PowerPC/SignatureDB/SignatureDB.h"
 #include "Core/State.h"
 #include "Core/TitleDatabase.h"
@@ -126,6 +129,7 @@ void MenuBar::OnEmulationStateChanged(Core::State state)
   {
     m_recording_stop->setEnabled(false);
     m_recording_export->setEnabled(false);
+    m_recording_seek->setEnabled(false);
   }
   m_recording_play->setEnabled(m_game_selected && !running);
   m_recording_start->setEnabled((m_game_selected || running) && !Movie::IsPlayingInput());
@@ -141,6 +145,11 @@ void MenuBar::OnEmulationStateChanged(Core::State state)
   m_jit_clear_cache->setEnabled(running);
   m_jit_log_coverage->setEnabled(!running);
   m_jit_search_instruction->setEnabled(running);
+  m_jit_sampling_profiler->setEnabled(running);
+  {
+    const QSignalBlocker blocker(m_jit_sampling_profiler);
+    m_jit_sampling_profiler->setChecked(SamplingProfiler::IsRunning());
+  }
 
   for (QAction* action :
        {m_jit_off, m_jit_loadstore_off, m_jit_loadstore_lbzx_off, m_jit_loadstore_lxz_off,
@@ -751,11 +760,14 @@ void MenuBar::AddMovieMenu()
                                            [this] { emit StopRecording(); });
   m_recording_export =
       movie_menu->addAction(tr("Export Recording..."), this, [this] { emit ExportRecording(); });
+  m_recording_seek =
+      movie_menu->addAction(tr("Seek to Frame..."), this, &MenuBar::SeekRecording);
 
   m_recording_start->setEnabled(false);
   m_recording_play->setEnabled(false);
   m_recording_stop->setEnabled(false);
   m_recording_export->setEnabled(false);
+  m_recording_seek->setEnabled(false);
 
   m_recording_read_only = movie_menu->addAction(tr("&Read-Only Mode"));
   m_recording_read_only->setCheckable(true);
@@ -865,6 +877,9 @@ void MenuBar::AddJITMenu()
       m_jit->addAction(tr("Log JIT Instruction Coverage"), this, &MenuBar::LogInstructions);
   m_jit_search_instruction =
       m_jit->addAction(tr("Search for an Instruction"), this, &MenuBar::SearchInstruction);
+  m_jit_sampling_profiler = m_jit->addAction(tr("Sampling Profiler"));
+  m_jit_sampling_profiler->setCheckable(true);
+  connect(m_jit_sampling_profiler, &QAction::toggled, this, &MenuBar::ToggleSamplingProfiler);
 
   m_jit->addSeparator();
 
@@ -1218,6 +1233,33 @@ void MenuBar::OnRecordingStatusChanged(bool recording)
   m_recording_start->setEnabled(!recording && (m_game_selected || Core::IsRunning()));
   m_recording_stop->setEnabled(recording);
   m_recording_export->setEnabled(recording);
+  m_recording_seek->setEnabled(recording);
+}
+
+void MenuBar::SeekRecording()
+{
+  if (!Movie::IsPlayingInput())
+  {
+    ModalMessageBox::information(this, tr("Seek to Frame"),
+                                 tr("Seeking is only possible while playing back a movie."));
+    return;
+  }
+
+  bool good;
+  const int frame = QInputDialog::getInt(
+      this, tr("Seek to Frame"), tr("Frame:"), static_cast<int>(Movie::GetCurrentFrame()), 0,
+      std::numeric_limits<int>::max(), 1, &good, Qt::WindowCloseButtonHint);
+  if (!good)
+    return;
+
+  if (!Movie::SeekToFrame(static_cast<u64>(frame)))
+  {
+    ModalMessageBox::information(
+        this, tr("Seek to Frame"),
+        tr("This movie has no keyframe at or before frame %1. Keyframes are only stored while "
+           "recording if a keyframe interval is set.")
+            .arg(frame));
+  }
 }
 
 void MenuBar::OnReadOnlyModeChanged(bool read_only)
@@ -1703,6 +1745,32 @@ void MenuBar::LogInstructions()
   PPCTables::LogCompiledInstructions();
 }
 
+void MenuBar::ToggleSamplingProfiler(bool enabled)
+{
+  if (enabled)
+  {
+    if (!SamplingProfiler::Start())
+    {
+      const QSignalBlocker blocker(m_jit_sampling_profiler);
+      m_jit_sampling_profiler->setChecked(false);
+      ModalMessageBox::critical(this, tr("Error"), tr("Failed to start the sampling profiler."));
+    }
+    return;
+  }
+
+  const std::optional<std::string> prefix = SamplingProfiler::Stop();
+  if (!prefix)
+  {
+    ModalMessageBox::critical(this, tr("Error"), tr("Failed to write the sampling profile."));
+    return;
+  }
+
+  ModalMessageBox::information(
+      this, tr("Sampling Profiler"),
+      tr("Wrote the flat profile to %1.txt and the collapsed stacks to %1.folded.")
+          .arg(QString::fromStdString(*prefix)));
+}
+
 void MenuBar::SearchInstruction()
 {
   bool good;
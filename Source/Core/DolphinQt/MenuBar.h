@@ -154,6 +154,7 @@ private:
   void CheckNAND();
   void NANDExtractCertificates();
   void ChangeDebugFont();
+  void SeekRecording();
 
   // Debugging UI
   void ClearSymbols();
@@ -178,6 +179,7 @@ private:
   void ClearCache();
   void LogInstructions();
   void SearchInstruction();
+  void ToggleSamplingProfiler(bool enabled);
 
   void OnSelectionChanged(std::shared_ptr<const UICommon::GameFile> game_file);
   void OnRecordingStatusChanged(bool recording);
@@ -229,6 +231,7 @@ private:
   QAction* m_recording_play;
   QAction* m_recording_start;
   QAction* m_recording_stop;
+  QAction* m_recording_seek;
   QAction* m_recording_read_only;
 
   // Options
@@ -261,6 +264,7 @@ private:
   QAction* m_jit_clear_cache;
   QAction* m_jit_log_coverage;
   QAction* m_jit_search_instruction;
+  QAction* m_jit_sampling_profiler;
   QAction* m_jit_off;
   QAction* m_jit_loadstore_off;
   QAction* m_jit_loadstore_lbzx_off;
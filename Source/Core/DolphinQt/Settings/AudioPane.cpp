@@ -141,6 +141,7 @@ void AudioPane::CreateWidgets()
   m_stretching_buffer_slider = new QSlider(Qt::Horizontal);
   m_stretching_buffer_indicator = new QLabel();
   m_stretching_buffer_label = new QLabel(tr("Buffer Size:"));
+  m_drift_compensation_enable = new QCheckBox(tr("Compensate for Clock Drift"));
   stretching_box->setLayout(stretching_layout);
 
   m_stretching_buffer_slider->setMinimum(5);
@@ -149,11 +150,16 @@ void AudioPane::CreateWidgets()
   m_stretching_enable->setToolTip(tr("Enables stretching of the audio to match emulation speed."));
   m_stretching_buffer_slider->setToolTip(tr("Size of stretch buffer in milliseconds. "
                                             "Values too low may cause audio crackling."));
+  m_drift_compensation_enable->setToolTip(
+      tr("Continuously matches the rate audio is produced at to the rate it is played at, and "
+         "uses higher quality resampling. Reduces crackling and latency creep when emulation "
+         "speed fluctuates. Has no effect while audio stretching is enabled."));
 
   stretching_layout->addWidget(m_stretching_enable, 0, 0, 1, -1);
   stretching_layout->addWidget(m_stretching_buffer_label, 1, 0);
   stretching_layout->addWidget(m_stretching_buffer_slider, 1, 1);
   stretching_layout->addWidget(m_stretching_buffer_indicator, 1, 2);
+  stretching_layout->addWidget(m_drift_compensation_enable, 2, 0, 1, -1);
 
   dsp_box->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
 
@@ -184,6 +190,7 @@ void AudioPane::ConnectWidgets()
   connect(m_dolby_pro_logic, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_dolby_quality_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
   connect(m_stretching_enable, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
+  connect(m_drift_compensation_enable, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_dsp_hle, &QRadioButton::toggled, this, &AudioPane::SaveSettings);
   connect(m_dsp_lle, &QRadioButton::toggled, this, &AudioPane::SaveSettings);
   connect(m_dsp_interpreter, &QRadioButton::toggled, this, &AudioPane::SaveSettings);
@@ -248,6 +255,8 @@ void AudioPane::LoadSettings()
   m_stretching_buffer_slider->setValue(Config::Get(Config::MAIN_AUDIO_STRETCH_LATENCY));
   m_stretching_buffer_slider->setEnabled(m_stretching_enable->isChecked());
   m_stretching_buffer_indicator->setText(tr("%1 ms").arg(m_stretching_buffer_slider->value()));
+  m_drift_compensation_enable->setChecked(Config::Get(Config::MAIN_AUDIO_DRIFT_COMPENSATION));
+  m_drift_compensation_enable->setEnabled(!m_stretching_enable->isChecked());
 
 #ifdef _WIN32
   if (Config::Get(Config::MAIN_WASAPI_DEVICE) == "default")
@@ -317,6 +326,9 @@ void AudioPane::SaveSettings()
   m_stretching_buffer_indicator->setEnabled(m_stretching_enable->isChecked());
   m_stretching_buffer_indicator->setText(
       tr("%1 ms").arg(Config::Get(Config::MAIN_AUDIO_STRETCH_LATENCY)));
+  Config::SetBaseOrCurrent(Config::MAIN_AUDIO_DRIFT_COMPENSATION,
+                           m_drift_compensation_enable->isChecked());
+  m_drift_compensation_enable->setEnabled(!m_stretching_enable->isChecked());
 
 #ifdef _WIN32
   std::string device = "default";
@@ -76,4 +76,5 @@ private:
   QLabel* m_stretching_buffer_label;
   QSlider* m_stretching_buffer_slider;
   QLabel* m_stretching_buffer_indicator;
+  QCheckBox* m_drift_compensation_enable;
 };
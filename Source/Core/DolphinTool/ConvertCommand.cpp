@@ -3,6 +3,7 @@
 
 #include "DolphinTool/ConvertCommand.h"
 
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <optional>
@@ -10,6 +11,7 @@
 #include <vector>
 
 #include <OptionParser.h>
+#include <fmt/format.h>
 
 #include "Common/CommonTypes.h"
 #include "DiscIO/Blob.h"
@@ -75,6 +77,10 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
       .help("Level of compression for the selected method. Ignored if 'none'. Suggested value for "
             "zstd: 5");
 
+  parser.add_option("-t", "--stats")
+      .action("store_true")
+      .help("Print throughput statistics after converting to WIA/RVZ.");
+
   const optparse::Values& options = parser.parse_args(args);
 
   // Initialize the dolphin user directory, required for temporary processing files
@@ -125,6 +131,9 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
   // --scrub
   const bool scrub = static_cast<bool>(options.get("scrub"));
 
+  // --stats
+  const bool print_stats = static_cast<bool>(options.get("stats"));
+
   // Open the volume
   std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateDisc(input_file_path);
   if (!volume)
@@ -302,10 +311,13 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
   case DiscIO::BlobType::WIA:
   case DiscIO::BlobType::RVZ:
   {
+    DiscIO::ConversionStats stats;
     success = DiscIO::ConvertToWIAOrRVZ(blob_reader.get(), input_file_path, output_file_path,
                                         format == DiscIO::BlobType::RVZ, compression_o.value(),
                                         compression_level_o.value(), block_size_o.value(),
-                                        NOOP_STATUS_CALLBACK);
+                                        NOOP_STATUS_CALLBACK, &stats);
+    if (success && print_stats)
+      PrintConversionStats(stats);
     break;
   }
 
@@ -325,6 +337,26 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
   return 0;
 }
 
+void ConvertCommand::PrintConversionStats(const DiscIO::ConversionStats& stats)
+{
+  constexpr double MIB = 1024.0 * 1024.0;
+  const u64 wall_time = std::max<u64>(stats.wall_time, 1);
+  const double seconds = wall_time / 1000000.0;
+  const auto ms = [](u64 us) { return us / 1000; };
+
+  std::cout << fmt::format("Read {:.1f} MiB at {:.1f} MiB/s, wrote {:.1f} MiB at {:.1f} MiB/s\n",
+                           stats.bytes_read / MIB, stats.bytes_read / MIB / seconds,
+                           stats.bytes_written / MIB, stats.bytes_written / MIB / seconds);
+  std::cout << fmt::format("Time: {} ms, {} compression threads kept {:.1f} busy on average\n",
+                           ms(stats.wall_time), stats.compress_threads,
+                           static_cast<double>(stats.compress_time) / wall_time);
+  std::cout << fmt::format("Reading: {} ms, waiting for compression: {} ms, compression: {} ms, "
+                           "output: {} ms",
+                           ms(stats.read_time), ms(stats.read_stall_time), ms(stats.compress_time),
+                           ms(stats.output_time))
+            << std::endl;
+}
+
 std::optional<DiscIO::WIARVZCompressionType>
 ConvertCommand::ParseCompressionTypeString(const std::string& compression_str)
 {
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "DiscIO/Blob.h"
+#include "DiscIO/MultithreadedCompressor.h"
 #include "DiscIO/WIABlob.h"
 #include "DolphinTool/Command.h"
 
@@ -19,6 +20,7 @@ public:
   int Main(const std::vector<std::string>& args) override;
 
 private:
+  static void PrintConversionStats(const DiscIO::ConversionStats& stats);
   std::optional<DiscIO::WIARVZCompressionType>
   ParseCompressionTypeString(const std::string& compression_str);
   std::optional<DiscIO::BlobType> ParseFormatString(const std::string& format_str);
@@ -0,0 +1,414 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/FifoCommand.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string_view>
+#include <thread>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+
+#include "Common/Config/Config.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/Flag.h"
+#include "Common/StringUtil.h"
+#include "Common/Timer.h"
+#include "Common/WindowSystemInfo.h"
+#include "Core/Boot/Boot.h"
+#include "Core/BootManager.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
+#include "UICommon/UICommon.h"
+#include "VideoCommon/Statistics.h"
+
+namespace DolphinTool
+{
+int FifoCommand::Main(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: fifo [options]...");
+
+  parser.add_option("-u", "--user")
+      .action("store")
+      .help("User folder path, required for temporary processing files. "
+            "Will be automatically created if this option is not set.");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to a FIFO log FILE, or to a directory containing FIFO logs.")
+      .metavar("PATH");
+
+  parser.add_option("-b", "--backend")
+      .type("string")
+      .action("store")
+      .help("Video backend to play the logs with. Default is software. 'analysis' is the null "
+            "backend with approximate EFB and XFB emulation. [%choices]")
+      .choices({"software", "null", "analysis"});
+
+  parser.add_option("-f", "--frames")
+      .type("int")
+      .action("store")
+      .help("Optional. Number of frames to play per log. Defaults to the frame count of each log.");
+
+  parser.add_option("-g", "--golden")
+      .type("string")
+      .action("store")
+      .help("Optional. Compare the XFB hashes against the golden hashes in FILE.")
+      .metavar("FILE");
+
+  parser.add_option("-w", "--write_golden")
+      .type("string")
+      .action("store")
+      .help("Optional. Write the XFB hashes of this run to FILE.")
+      .metavar("FILE");
+
+  parser.add_option("-p", "--profile")
+      .type("int")
+      .action("store")
+      .help("Optional. Count GX command sequences and print the N most frequent ones per log.")
+      .metavar("N");
+
+  parser.add_option("-t", "--timeout")
+      .type("int")
+      .action("store")
+      .set_default(120)
+      .help("Optional. Maximum number of seconds to spend on a single log. Default is 120.");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  std::string user_directory;
+  if (options.is_set("user"))
+    user_directory = static_cast<const char*>(options.get("user"));
+
+  UICommon::SetUserDirectory(user_directory);
+  UICommon::Init();
+
+  // --input
+  const std::string input_path = static_cast<const char*>(options.get("input"));
+  if (input_path.empty())
+  {
+    std::cerr << "Error: No input set" << std::endl;
+    return 1;
+  }
+
+  std::vector<std::string> log_paths;
+  if (File::IsDirectory(input_path))
+    log_paths = Common::DoFileSearch({input_path}, {".dff"}, false);
+  else
+    log_paths.push_back(input_path);
+  std::sort(log_paths.begin(), log_paths.end());
+
+  if (log_paths.empty())
+  {
+    std::cerr << "Error: No FIFO logs found" << std::endl;
+    return 1;
+  }
+
+  // --backend
+  std::string backend = "software";
+  if (options.is_set("backend"))
+    backend = static_cast<const char*>(options.get("backend"));
+
+  // --frames
+  std::optional<u32> frame_count;
+  if (options.is_set("frames"))
+  {
+    const int frames = static_cast<int>(options.get("frames"));
+    if (frames <= 0)
+    {
+      std::cerr << "Error: Frame count must be positive" << std::endl;
+      return 1;
+    }
+    frame_count = static_cast<u32>(frames);
+  }
+
+  // --profile
+  u32 num_sequences = 0;
+  if (options.is_set("profile"))
+    num_sequences = static_cast<u32>(std::max(static_cast<int>(options.get("profile")), 0));
+
+  // --timeout
+  const u32 timeout_seconds = std::max(static_cast<int>(options.get("timeout")), 1);
+
+  // --golden
+  std::optional<HashMap> golden;
+  if (options.is_set("golden"))
+  {
+    golden = LoadHashes(static_cast<const char*>(options.get("golden")));
+    if (!golden)
+    {
+      std::cerr << "Error: Unable to read golden hashes" << std::endl;
+      return 1;
+    }
+  }
+
+  // Run every log under the same, reproducible conditions: the GPU runs on the CPU thread, the
+  // frame limiter and audio are off, and XFB copies always reach guest memory so they can be
+  // hashed.
+  const std::string video_backend = backend == "software" ? "Software Renderer" : "Null";
+  Config::SetCurrent(Config::MAIN_GFX_BACKEND, video_backend);
+  Config::SetCurrent(Config::GFX_NULL_ANALYSIS_MODE, backend == "analysis");
+  Config::SetCurrent(Config::MAIN_CPU_THREAD, false);
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  Config::SetCurrent(Config::MAIN_AUDIO_BACKEND, std::string(BACKEND_NULLSOUND));
+  Config::SetCurrent(Config::GFX_HACK_SKIP_XFB_COPY_TO_RAM, false);
+
+  HashMap hashes;
+  u32 failed_logs = 0;
+  u32 mismatched_frames = 0;
+  u32 missing_frames = 0;
+
+  for (const std::string& path : log_paths)
+  {
+    std::optional<LogResult> result =
+        PlayLog(path, frame_count, timeout_seconds, options.is_set("profile"));
+    if (!result)
+    {
+      std::cerr << "Error: Unable to play " << path << std::endl;
+      ++failed_logs;
+      continue;
+    }
+
+    PrintResult(*result, num_sequences);
+    if (!result->completed)
+    {
+      std::cerr << "Error: " << result->name << " timed out or stopped early" << std::endl;
+      ++failed_logs;
+    }
+
+    for (const FrameReport::Frame& frame : result->frames)
+    {
+      const auto key = std::make_pair(result->name, frame.frame_number);
+      hashes.emplace(key, frame.xfb_hash);
+
+      if (!golden)
+        continue;
+
+      const auto it = golden->find(key);
+      if (it == golden->end())
+      {
+        ++missing_frames;
+      }
+      else if (it->second != frame.xfb_hash)
+      {
+        std::cerr << fmt::format("Mismatch: {} frame {}: expected {:016x}, got {:016x}",
+                                 result->name, frame.frame_number, it->second, frame.xfb_hash)
+                  << std::endl;
+        ++mismatched_frames;
+      }
+    }
+  }
+
+  FrameReport::SetCallback({});
+
+  if (options.is_set("write_golden") &&
+      !SaveHashes(static_cast<const char*>(options.get("write_golden")), hashes))
+  {
+    std::cerr << "Error: Unable to write golden hashes" << std::endl;
+    return 1;
+  }
+
+  if (golden)
+  {
+    std::cout << fmt::format("{} frames compared, {} mismatched, {} without a golden hash",
+                             hashes.size() - missing_frames, mismatched_frames, missing_frames)
+              << std::endl;
+  }
+
+  UICommon::Shutdown();
+
+  return (failed_logs != 0 || mismatched_frames != 0) ? 1 : 0;
+}
+
+std::optional<FifoCommand::LogResult>
+FifoCommand::PlayLog(const std::string& path, std::optional<u32> frame_count,
+                     u32 timeout_seconds, bool profile_commands)
+{
+  LogResult result;
+  SplitPath(path, nullptr, &result.name, nullptr);
+
+  std::mutex frames_lock;
+  Common::Flag done;
+  u32 target_frames = frame_count.value_or(0);
+
+  // Invoked on the GPU thread, which is the CPU thread since dual core is disabled.
+  FrameReport::SetCallback([&](const FrameReport::Frame& frame) {
+    std::lock_guard<std::mutex> guard(frames_lock);
+    if (target_frames == 0)
+    {
+      const FifoDataFile* file = FifoPlayer::GetInstance().GetFile();
+      target_frames = file ? std::max(file->GetFrameCount(), 1u) : 1u;
+    }
+
+    if (result.frames.size() < target_frames)
+      result.frames.push_back(frame);
+    if (result.frames.size() >= target_frames)
+      done.Set();
+  });
+
+  // These counters are cumulative and otherwise only reset by their owners on backend init.
+  g_stats.num_textures_created = 0;
+  g_stats.num_textures_uploaded = 0;
+
+  OpcodeDecoder::ResetCommandProfile();
+  OpcodeDecoder::g_profile_commands = profile_commands;
+
+  const u64 start_time = Common::Timer::GetTimeUs();
+
+  WindowSystemInfo wsi(WindowSystemType::Headless, nullptr, nullptr, nullptr);
+  if (!BootManager::BootCore(BootParameters::GenerateFromFile(path), wsi))
+  {
+    FrameReport::SetCallback({});
+    return std::nullopt;
+  }
+
+  const u64 timeout_us = static_cast<u64>(timeout_seconds) * 1000000;
+  while (!done.IsSet())
+  {
+    Core::HostDispatchJobs();
+    if (Core::GetState() == Core::State::Uninitialized)
+      break;
+    if (Common::Timer::GetTimeUs() - start_time > timeout_us)
+      break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+
+  result.wall_time_ms = (Common::Timer::GetTimeUs() - start_time) / 1000.0;
+
+  Core::Stop();
+  Core::Shutdown();
+  FrameReport::SetCallback({});
+  OpcodeDecoder::g_profile_commands = false;
+
+  // The GPU thread has exited, so the counters are stable now.
+  result.completed = done.IsSet();
+  result.textures_created = g_stats.num_textures_created;
+  result.textures_uploaded = g_stats.num_textures_uploaded;
+  result.pixel_shaders_created = g_stats.num_pixel_shaders_created;
+  result.vertex_shaders_created = g_stats.num_vertex_shaders_created;
+  result.vertex_loaders = g_stats.num_vertex_loaders;
+  if (profile_commands)
+    result.command_profile = OpcodeDecoder::GetCommandProfile();
+
+  return result;
+}
+
+std::optional<FifoCommand::HashMap> FifoCommand::LoadHashes(const std::string& path)
+{
+  std::string contents;
+  if (!File::ReadFileToString(path, contents))
+    return std::nullopt;
+
+  // One "<log name> <frame number> <hash>" entry per line.
+  HashMap hashes;
+  std::istringstream stream(contents);
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    const std::string_view entry = StripSpaces(line);
+    if (entry.empty() || entry[0] == '#')
+      continue;
+
+    std::istringstream line_stream{std::string(entry)};
+    std::string name, hash_str;
+    u64 frame_number;
+    if (!(line_stream >> name >> frame_number >> hash_str))
+      return std::nullopt;
+
+    u64 hash;
+    if (!TryParse(hash_str, &hash, 16))
+      return std::nullopt;
+
+    hashes.emplace(std::make_pair(std::move(name), frame_number), hash);
+  }
+
+  return hashes;
+}
+
+bool FifoCommand::SaveHashes(const std::string& path, const HashMap& hashes)
+{
+  std::string contents = "# <log name> <frame number> <XFB hash>\n";
+  for (const auto& [key, hash] : hashes)
+    contents += fmt::format("{} {} {:016x}\n", key.first, key.second, hash);
+
+  return File::WriteStringToFile(path, contents);
+}
+
+void FifoCommand::PrintResult(const LogResult& result, u32 num_sequences)
+{
+  u64 total_frame_time_us = 0;
+  u64 max_frame_time_us = 0;
+  u64 draw_calls = 0;
+  u64 prims = 0;
+  u64 vertices_loaded = 0;
+  u64 bytes_streamed = 0;
+  u64 efb_peeks = 0;
+  for (const FrameReport::Frame& frame : result.frames)
+  {
+    total_frame_time_us += frame.frame_time_us;
+    max_frame_time_us = std::max(max_frame_time_us, frame.frame_time_us);
+    draw_calls += frame.stats.num_draw_calls;
+    prims += frame.stats.num_prims + frame.stats.num_dl_prims;
+    vertices_loaded += frame.stats.num_vertices_loaded;
+    bytes_streamed += frame.stats.bytes_vertex_streamed + frame.stats.bytes_index_streamed +
+                      frame.stats.bytes_uniform_streamed;
+    efb_peeks += frame.stats.num_efb_peeks;
+  }
+
+  // The first frame has no predecessor to measure its frame time against.
+  const size_t timed_frames = result.frames.size() > 1 ? result.frames.size() - 1 : 1;
+  const size_t frames = std::max<size_t>(result.frames.size(), 1);
+
+  std::cout << result.name << ":" << std::endl;
+  std::cout << fmt::format("  Frames:          {} in {:.1f} ms", result.frames.size(),
+                           result.wall_time_ms)
+            << std::endl;
+  std::cout << fmt::format("  Frame time:      avg {:.3f} ms, max {:.3f} ms",
+                           total_frame_time_us / 1000.0 / timed_frames, max_frame_time_us / 1000.0)
+            << std::endl;
+  std::cout << fmt::format("  Per frame:       {} draw calls, {} prims, {} vertices, {} EFB peeks",
+                           draw_calls / frames, prims / frames, vertices_loaded / frames,
+                           efb_peeks / frames)
+            << std::endl;
+  std::cout << fmt::format("  Streamed:        {} bytes/frame", bytes_streamed / frames)
+            << std::endl;
+  std::cout << fmt::format("  Textures:        {} created, {} uploaded", result.textures_created,
+                           result.textures_uploaded)
+            << std::endl;
+  std::cout << fmt::format("  Shaders:         {} pixel, {} vertex created; {} vertex loaders",
+                           result.pixel_shaders_created, result.vertex_shaders_created,
+                           result.vertex_loaders)
+            << std::endl;
+
+  if (!result.command_profile)
+    return;
+
+  const OpcodeDecoder::CommandProfile& profile = *result.command_profile;
+  std::cout << fmt::format("  Commands:        {}, {} draws merged into the preceding draw",
+                           profile.num_commands, profile.num_batched_draws)
+            << std::endl;
+
+  const size_t count = std::min<size_t>(num_sequences, profile.sequences.size());
+  for (size_t i = 0; i < count; ++i)
+  {
+    const OpcodeDecoder::CommandSequence& sequence = profile.sequences[i];
+    std::cout << fmt::format("    {:>10} ({:5.2f}%)  {} -> {}", sequence.count,
+                             100.0 * sequence.count / std::max<u64>(profile.num_commands, 1),
+                             OpcodeDecoder::GetCommandKeyName(sequence.first),
+                             OpcodeDecoder::GetCommandKeyName(sequence.second))
+              << std::endl;
+  }
+}
+
+}  // namespace DolphinTool
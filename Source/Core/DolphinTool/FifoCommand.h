@@ -0,0 +1,56 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "DolphinTool/Command.h"
+#include "VideoCommon/FrameReport.h"
+#include "VideoCommon/OpcodeDecoding.h"
+
+namespace DolphinTool
+{
+// Plays back FIFO logs (.dff) headlessly, hashing every presented XFB and collecting per-log
+// performance counters. Hashes can be written out as a golden file and later compared against, so
+// that a directory of logs can serve as a GPU-free regression and performance suite.
+class FifoCommand final : public Command
+{
+public:
+  int Main(const std::vector<std::string>& args) override;
+
+private:
+  // (log name, frame number) -> XFB hash
+  using HashMap = std::map<std::pair<std::string, u64>, u64>;
+
+  struct LogResult
+  {
+    std::string name;
+    bool completed = false;
+    std::vector<FrameReport::Frame> frames;
+    double wall_time_ms = 0.0;
+
+    int textures_created = 0;
+    int textures_uploaded = 0;
+    int pixel_shaders_created = 0;
+    int vertex_shaders_created = 0;
+    int vertex_loaders = 0;
+
+    std::optional<OpcodeDecoder::CommandProfile> command_profile;
+  };
+
+  std::optional<LogResult> PlayLog(const std::string& path, std::optional<u32> frame_count,
+                                   u32 timeout_seconds, bool profile_commands);
+
+  static std::optional<HashMap> LoadHashes(const std::string& path);
+  static bool SaveHashes(const std::string& path, const HashMap& hashes);
+
+  static void PrintResult(const LogResult& result, u32 num_sequences);
+};
+
+}  // namespace DolphinTool
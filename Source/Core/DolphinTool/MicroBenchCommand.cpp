@@ -0,0 +1,214 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/MicroBenchCommand.h"
+
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Timer.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "UICommon/UICommon.h"
+
+namespace DolphinTool
+{
+static u64 s_callbacks = 0;
+
+static void CountCallback(u64 userdata, s64 lateness)
+{
+  ++s_callbacks;
+}
+
+// Schedules events of many types at scattered times, removes half of the types, then advances
+// through the remaining events one slice at a time.
+static void RunCoreTimingBenchmark(int rounds)
+{
+  Core::DeclareAsCPUThread();
+  PowerPC::Init(PowerPC::CPUCore::Interpreter);
+  CoreTiming::Init();
+
+  constexpr int NUM_TYPES = 64;
+  constexpr int NUM_EVENTS = 1 << 16;
+  std::vector<CoreTiming::EventType*> types;
+  for (int i = 0; i < NUM_TYPES; ++i)
+    types.push_back(CoreTiming::RegisterEvent(fmt::format("callback{}", i), CountCallback));
+
+  // Enter slice 0
+  CoreTiming::Advance();
+
+  u64 schedule_us = 0;
+  u64 remove_us = 0;
+  u64 advance_us = 0;
+  for (int round = 0; round < rounds; ++round)
+  {
+    u64 start_time = Common::Timer::GetTimeUs();
+    for (int i = 0; i < NUM_EVENTS; ++i)
+      CoreTiming::ScheduleEvent((i * 7919) % 100000 + 1, types[i % NUM_TYPES], i);
+    schedule_us += Common::Timer::GetTimeUs() - start_time;
+
+    start_time = Common::Timer::GetTimeUs();
+    for (int i = 0; i < NUM_TYPES; i += 2)
+      CoreTiming::RemoveEvent(types[i]);
+    remove_us += Common::Timer::GetTimeUs() - start_time;
+
+    // Every slice ends at the next pending event, so this runs at least one event per Advance.
+    s_callbacks = 0;
+    start_time = Common::Timer::GetTimeUs();
+    while (s_callbacks < NUM_EVENTS / 2)
+    {
+      PowerPC::ppcState.downcount = 0;
+      CoreTiming::Advance();
+    }
+    advance_us += Common::Timer::GetTimeUs() - start_time;
+  }
+
+  CoreTiming::Shutdown();
+  PowerPC::Shutdown();
+  Core::UndeclareAsCPUThread();
+
+  std::cout << fmt::format("Schedule:  {} events, avg {:.3f} ms", NUM_EVENTS,
+                           schedule_us / 1000.0 / rounds)
+            << std::endl;
+  std::cout << fmt::format("Remove:    {} event types, avg {:.3f} ms", NUM_TYPES / 2,
+                           remove_us / 1000.0 / rounds)
+            << std::endl;
+  std::cout << fmt::format("Advance:   {} events, avg {:.3f} ms", NUM_EVENTS / 2,
+                           advance_us / 1000.0 / rounds)
+            << std::endl;
+}
+
+// Mimics the JIT block cache during heavy code writes: lookups of block entry points mixed with
+// invalidations which drop and recompile the blocks of whole 0x100 byte ranges. The cached
+// interpreter is used since its block cache adds nothing to the base one.
+static void RunJitCacheBenchmark(int rounds)
+{
+  Core::DeclareAsCPUThread();
+  PowerPC::Init(PowerPC::CPUCore::Interpreter);
+
+  CachedInterpreter jit;
+  jit.Init();
+  JitBaseBlockCache& cache = *jit.GetBlockCache();
+
+  constexpr u32 NUM_RANGES = 1 << 14;
+  constexpr u32 RANGE_SIZE = 0x100;
+  constexpr u32 BLOCKS_PER_RANGE = 8;
+  constexpr u32 BLOCK_SIZE = RANGE_SIZE / BLOCKS_PER_RANGE;
+
+  // With address translation off, effective and physical addresses are the same.
+  const auto add_range = [&cache](u32 range) {
+    for (u32 i = 0; i < BLOCKS_PER_RANGE; ++i)
+    {
+      const u32 address = range * RANGE_SIZE + i * BLOCK_SIZE;
+      std::set<u32> physical_addresses;
+      for (u32 offset = 0; offset < BLOCK_SIZE; offset += 4)
+        physical_addresses.insert(address + offset);
+      cache.FinalizeBlock(*cache.AllocateBlock(address), false, physical_addresses);
+    }
+  };
+
+  for (u32 range = 0; range < NUM_RANGES; ++range)
+    add_range(range);
+
+  u64 erase_us = 0;
+  u64 add_us = 0;
+  u64 lookup_us = 0;
+  u64 found = 0;
+  for (int round = 0; round < rounds; ++round)
+  {
+    u64 start_time = Common::Timer::GetTimeUs();
+    for (u32 range = round % 2; range < NUM_RANGES; range += 2)
+      cache.ErasePhysicalRange(range * RANGE_SIZE, RANGE_SIZE);
+    erase_us += Common::Timer::GetTimeUs() - start_time;
+
+    start_time = Common::Timer::GetTimeUs();
+    for (u32 range = round % 2; range < NUM_RANGES; range += 2)
+      add_range(range);
+    add_us += Common::Timer::GetTimeUs() - start_time;
+
+    // Half of these addresses are in the middle of a block rather than at its start.
+    start_time = Common::Timer::GetTimeUs();
+    for (u32 address = 0; address < NUM_RANGES * RANGE_SIZE; address += BLOCK_SIZE / 2)
+      found += cache.GetBlockFromStartAddress(address, 0) != nullptr;
+    lookup_us += Common::Timer::GetTimeUs() - start_time;
+  }
+
+  jit.Shutdown();
+  PowerPC::Shutdown();
+  Core::UndeclareAsCPUThread();
+
+  if (found != u64(NUM_RANGES) * BLOCKS_PER_RANGE * rounds)
+    std::cerr << "Warning: Found " << found << " blocks, some were lost" << std::endl;
+
+  std::cout << fmt::format("Erase:     {} ranges, avg {:.3f} ms", NUM_RANGES / 2,
+                           erase_us / 1000.0 / rounds)
+            << std::endl;
+  std::cout << fmt::format("Add:       {} blocks, avg {:.3f} ms", NUM_RANGES / 2 * BLOCKS_PER_RANGE,
+                           add_us / 1000.0 / rounds)
+            << std::endl;
+  std::cout << fmt::format("Lookup:    {} addresses, avg {:.3f} ms",
+                           NUM_RANGES * BLOCKS_PER_RANGE * 2, lookup_us / 1000.0 / rounds)
+            << std::endl;
+}
+
+int MicroBenchCommand::Main(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: micro-bench [options]...");
+
+  parser.add_option("-u", "--user")
+      .action("store")
+      .help("User folder path, required for temporary processing files. "
+            "Will be automatically created if this option is not set.");
+
+  parser.add_option("-b", "--benchmark")
+      .type("string")
+      .action("store")
+      .help("Subsystem to benchmark. [%choices]")
+      .choices({"core-timing", "jit-cache"});
+
+  parser.add_option("-r", "--rounds")
+      .type("int")
+      .action("store")
+      .set_default(16)
+      .help("Optional. Number of times to repeat the benchmark. Default is 16.");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  // --benchmark
+  if (!options.is_set("benchmark"))
+  {
+    std::cerr << "Error: No benchmark set" << std::endl;
+    return 1;
+  }
+  const std::string benchmark = static_cast<const char*>(options.get("benchmark"));
+  const int rounds = std::max(static_cast<int>(options.get("rounds")), 1);
+
+  std::string user_directory;
+  if (options.is_set("user"))
+    user_directory = static_cast<const char*>(options.get("user"));
+
+  UICommon::SetUserDirectory(user_directory);
+  UICommon::Init();
+
+  if (benchmark == "core-timing")
+    RunCoreTimingBenchmark(rounds);
+  else if (benchmark == "jit-cache")
+    RunJitCacheBenchmark(rounds);
+
+  UICommon::Shutdown();
+
+  return 0;
+}
+
+}  // namespace DolphinTool
@@ -0,0 +1,21 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "DolphinTool/Command.h"
+
+namespace DolphinTool
+{
+// Times a single emulator subsystem in isolation, without booting a game, so that changes to its
+// data structures can be compared between builds.
+class MicroBenchCommand final : public Command
+{
+public:
+  int Main(const std::vector<std::string>& args) override;
+};
+
+}  // namespace DolphinTool
@@ -0,0 +1,456 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/MovieCommand.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <csignal>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "Common/Timer.h"
+#include "Common/WindowSystemInfo.h"
+#include "Core/Boot/Boot.h"
+#include "Core/BootManager.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/Movie.h"
+#include "UICommon/UICommon.h"
+
+#ifndef _WIN32
+extern char** environ;
+#endif
+
+namespace DolphinTool
+{
+namespace
+{
+// Exit codes of a process that verifies a single movie
+enum VerifyResult : int
+{
+  VERIFY_PASSED = 0,
+  VERIFY_FAILED = 1,
+  VERIFY_DESYNCED = 2,
+  VERIFY_NO_HASHES = 3,
+};
+
+#ifdef _WIN32
+using ProcessHandle = HANDLE;
+
+// Quotes an argument so that CommandLineToArgvW gives it back unchanged
+std::string QuoteArgument(const std::string& argument)
+{
+  std::string result = "\"";
+  size_t backslashes = 0;
+  for (const char c : argument)
+  {
+    if (c == '\\')
+    {
+      ++backslashes;
+      continue;
+    }
+
+    // Backslashes only need escaping when they come before a quote
+    result.append(c == '"' ? backslashes * 2 + 1 : backslashes, '\\');
+    backslashes = 0;
+    result += c;
+  }
+  result.append(backslashes * 2, '\\');
+  return result + '"';
+}
+
+std::optional<ProcessHandle> StartProcess(const std::vector<std::string>& args)
+{
+  std::string command_line;
+  for (const std::string& arg : args)
+    command_line += (command_line.empty() ? "" : " ") + QuoteArgument(arg);
+
+  std::wstring command_line_w = UTF8ToWString(command_line);
+  STARTUPINFOW startup_info{sizeof(startup_info)};
+  PROCESS_INFORMATION process_info;
+  if (!CreateProcessW(UTF8ToWString(args[0]).c_str(), command_line_w.data(), nullptr, nullptr,
+                      FALSE, 0, nullptr, nullptr, &startup_info, &process_info))
+  {
+    return std::nullopt;
+  }
+
+  CloseHandle(process_info.hThread);
+  return process_info.hProcess;
+}
+
+// Waits up to timeout_ms for one of the processes to exit, and returns its index and exit code
+std::optional<std::pair<size_t, int>> WaitForAnyProcess(const std::vector<ProcessHandle>& processes,
+                                                        u32 timeout_ms)
+{
+  const DWORD result = WaitForMultipleObjects(static_cast<DWORD>(processes.size()),
+                                              processes.data(), FALSE, timeout_ms);
+  if (result < WAIT_OBJECT_0 || result >= WAIT_OBJECT_0 + processes.size())
+    return std::nullopt;
+  const size_t index = result - WAIT_OBJECT_0;
+
+  DWORD exit_code = VERIFY_FAILED;
+  GetExitCodeProcess(processes[index], &exit_code);
+  CloseHandle(processes[index]);
+  return std::make_pair(index, static_cast<int>(exit_code));
+}
+
+void KillProcess(ProcessHandle process)
+{
+  TerminateProcess(process, VERIFY_FAILED);
+  WaitForSingleObject(process, INFINITE);
+  CloseHandle(process);
+}
+#else
+using ProcessHandle = pid_t;
+
+std::optional<ProcessHandle> StartProcess(const std::vector<std::string>& args)
+{
+  std::vector<char*> argv;
+  for (const std::string& arg : args)
+    argv.push_back(const_cast<char*>(arg.c_str()));
+  argv.push_back(nullptr);
+
+  pid_t pid;
+  if (posix_spawn(&pid, args[0].c_str(), nullptr, nullptr, argv.data(), environ) != 0)
+    return std::nullopt;
+  return pid;
+}
+
+// Waits up to timeout_ms for one of the processes to exit, and returns its index and exit code
+std::optional<std::pair<size_t, int>> WaitForAnyProcess(const std::vector<ProcessHandle>& processes,
+                                                        u32 timeout_ms)
+{
+  // Only our own processes are waited for, so that other children of this process aren't reaped
+  const u64 start_time = Common::Timer::GetTimeUs();
+  while (true)
+  {
+    for (size_t i = 0; i < processes.size(); ++i)
+    {
+      int status;
+      const pid_t pid = waitpid(processes[i], &status, WNOHANG);
+      if (pid == processes[i])
+        return std::make_pair(i, WIFEXITED(status) ? WEXITSTATUS(status) : VERIFY_FAILED);
+
+      // The process is gone without us seeing its exit status
+      if (pid == -1 && errno == ECHILD)
+        return std::make_pair(i, static_cast<int>(VERIFY_FAILED));
+    }
+
+    if (Common::Timer::GetTimeUs() - start_time >= u64{timeout_ms} * 1000)
+      return std::nullopt;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
+void KillProcess(ProcessHandle process)
+{
+  kill(process, SIGKILL);
+  while (waitpid(process, nullptr, 0) == -1 && errno == EINTR)
+  {
+  }
+}
+#endif
+
+// Movies write temporary files to the user folder, so every verification gets its own
+void CreateUserDirectory(const std::string& path, const std::string& source_user_directory)
+{
+  File::CreateFullPath(path);
+  if (source_user_directory.empty())
+    return;
+
+  for (const char* directory : {CONFIG_DIR, GAMESETTINGS_DIR})
+    File::CopyDir(fmt::format("{}/{}", source_user_directory, directory), path + directory);
+}
+
+int VerifyMovie(const std::string& movie_path, const std::string& game_path, u64 timeout_seconds)
+{
+  Config::SetCurrent(Config::MAIN_GFX_BACKEND, std::string("Null"));
+  Config::SetCurrent(Config::MAIN_AUDIO_BACKEND, std::string(BACKEND_NULLSOUND));
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  Config::SetCurrent(Config::MAIN_MOVIE_PAUSE_MOVIE, false);
+
+  Movie::SetReadOnly(true);
+  std::optional<std::string> savestate_path;
+  if (!Movie::PlayInput(movie_path, &savestate_path))
+  {
+    std::cerr << movie_path << ": Error: Unable to play movie" << std::endl;
+    return VERIFY_FAILED;
+  }
+
+  if (Movie::GetRAMHashResults().total == 0)
+  {
+    Movie::EndPlayInput(false);
+    std::cout << movie_path << ": No RAM hashes were stored while recording" << std::endl;
+    return VERIFY_NO_HASHES;
+  }
+
+  WindowSystemInfo wsi(WindowSystemType::Headless, nullptr, nullptr, nullptr);
+  BootSessionData boot_session_data(std::move(savestate_path), DeleteSavestateAfterBoot::No);
+  if (!BootManager::BootCore(
+          BootParameters::GenerateFromFile(game_path, std::move(boot_session_data)), wsi))
+  {
+    std::cerr << movie_path << ": Error: Unable to boot " << game_path << std::endl;
+    return VERIFY_FAILED;
+  }
+
+  const u64 start_time = Common::Timer::GetTimeUs();
+  bool timed_out = false;
+  while (Movie::IsPlayingInput() && Core::GetState() != Core::State::Uninitialized)
+  {
+    Core::HostDispatchJobs();
+
+    const u64 elapsed = Common::Timer::GetTimeUs() - start_time;
+    if (timeout_seconds != 0 && elapsed > timeout_seconds * 1000000)
+    {
+      timed_out = true;
+      break;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  const u64 frames = Movie::GetCurrentFrame();
+  const bool reached_end = !Movie::IsPlayingInput() && !timed_out;
+  const double wall_time = (Common::Timer::GetTimeUs() - start_time) / 1000000.0;
+
+  Core::Stop();
+  Core::Shutdown();
+
+  const Movie::RAMHashResults results = Movie::GetRAMHashResults();
+  if (results.first_mismatch_frame)
+  {
+    std::cout << fmt::format("{}: DESYNC on frame {} ({} of {} RAM hashes differ)", movie_path,
+                             *results.first_mismatch_frame, results.mismatched, results.checked)
+              << std::endl;
+    return VERIFY_DESYNCED;
+  }
+
+  // Playback also ends early if the movie doesn't belong to the game
+  if (!reached_end || results.checked == 0)
+  {
+    std::cout << fmt::format("{}: FAILED, {} on frame {} after checking {} of {} RAM hashes",
+                             movie_path, timed_out ? "timed out" : "stopped", frames,
+                             results.checked, results.total)
+              << std::endl;
+    return VERIFY_FAILED;
+  }
+
+  std::cout << fmt::format("{}: OK, {} of {} RAM hashes match ({} frames in {:.1f} s)", movie_path,
+                           results.checked, results.total, frames, wall_time)
+            << std::endl;
+  return VERIFY_PASSED;
+}
+}  // namespace
+
+int MovieCommand::Main(const std::vector<std::string>& args)
+{
+  if (args.size() >= 2 && args[1] == "verify")
+    return Verify(std::vector<std::string>(args.begin() + 2, args.end()));
+
+  std::cerr << "usage: movie verify [options]... MOVIE..." << std::endl;
+  return 1;
+}
+
+int MovieCommand::Verify(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: movie verify [options]... MOVIE...");
+
+  parser.add_option("-u", "--user")
+      .action("store")
+      .help("User folder path. Each movie is played back with a copy of its configuration. "
+            "A temporary folder with the default configuration is used if this is not set.");
+
+  parser.add_option("-g", "--game")
+      .type("string")
+      .action("store")
+      .help("Path to the game the movies were recorded with.")
+      .metavar("FILE");
+
+  parser.add_option("-j", "--jobs")
+      .type("int")
+      .action("store")
+      .set_default(std::max(std::thread::hardware_concurrency() / 2, 1u))
+      .help("Optional. Number of movies to play back at once. Default is half the number of "
+            "CPU threads.");
+
+  parser.add_option("-t", "--timeout")
+      .type("int")
+      .action("store")
+      .set_default(0)
+      .help("Optional. Give up on a movie after this many seconds. Default is no limit.")
+      .metavar("SECONDS");
+
+  const optparse::Values& options = parser.parse_args(args);
+  const std::vector<std::string> movie_paths = parser.args();
+
+  std::string user_directory;
+  if (options.is_set("user"))
+    user_directory = static_cast<const char*>(options.get("user"));
+
+  const std::string game_path = static_cast<const char*>(options.get("game"));
+  if (game_path.empty())
+  {
+    std::cerr << "Error: No game set" << std::endl;
+    return 1;
+  }
+  if (movie_paths.empty())
+  {
+    std::cerr << "Error: No movies set" << std::endl;
+    return 1;
+  }
+
+  const u64 timeout_seconds = std::max(static_cast<int>(options.get("timeout")), 0);
+
+  const std::string temp_directory = File::CreateTempDir();
+  if (temp_directory.empty())
+  {
+    std::cerr << "Error: Unable to create a temporary folder" << std::endl;
+    return 1;
+  }
+
+  // A single movie is verified in this process. Otherwise, every movie gets its own process, so
+  // that nothing carries over between them and they can run in parallel.
+  if (movie_paths.size() == 1)
+  {
+    const std::string process_user_directory = temp_directory + "/";
+    CreateUserDirectory(process_user_directory, user_directory);
+
+    UICommon::SetUserDirectory(process_user_directory);
+    UICommon::Init();
+    const int result = VerifyMovie(movie_paths[0], game_path, timeout_seconds);
+    UICommon::Shutdown();
+
+    File::DeleteDirRecursively(temp_directory);
+    return result;
+  }
+
+#ifdef _WIN32
+  // The limit of WaitForMultipleObjects
+  constexpr int MAX_JOBS = MAXIMUM_WAIT_OBJECTS;
+#else
+  constexpr int MAX_JOBS = 256;
+#endif
+  const size_t jobs = std::clamp(static_cast<int>(options.get("jobs")), 1, MAX_JOBS);
+
+  // Processes stop playback themselves when they run out of time, but booting isn't part of that
+  // time and a process can also hang, so the processes are killed some time later
+  constexpr u64 KILL_GRACE_SECONDS = 60;
+  const u64 kill_timeout_us =
+      timeout_seconds == 0 ? 0 : (timeout_seconds + KILL_GRACE_SECONDS) * 1000000;
+
+  std::vector<ProcessHandle> processes;
+  std::vector<size_t> process_movies;
+  std::vector<u64> process_start_times;
+  size_t next_movie = 0;
+  std::vector<size_t> result_counts(VERIFY_NO_HASHES + 1);
+
+  while (next_movie < movie_paths.size() || !processes.empty())
+  {
+    while (processes.size() < jobs && next_movie < movie_paths.size())
+    {
+      const std::string process_user_directory =
+          fmt::format("{}/{}/", temp_directory, next_movie);
+      CreateUserDirectory(process_user_directory, user_directory);
+
+      const std::vector<std::string> process_args = {
+          File::GetExePath(),
+          "movie",
+          "verify",
+          "-u",
+          process_user_directory,
+          "-g",
+          game_path,
+          "-t",
+          std::to_string(timeout_seconds),
+          movie_paths[next_movie],
+      };
+
+      const std::optional<ProcessHandle> process = StartProcess(process_args);
+      if (process)
+      {
+        processes.push_back(*process);
+        process_movies.push_back(next_movie);
+        process_start_times.push_back(Common::Timer::GetTimeUs());
+      }
+      else
+      {
+        std::cerr << movie_paths[next_movie] << ": Error: Unable to start process" << std::endl;
+        ++result_counts[VERIFY_FAILED];
+      }
+      ++next_movie;
+    }
+
+    if (processes.empty())
+      continue;
+
+    size_t index = 0;
+    if (const auto result = WaitForAnyProcess(processes, 1000))
+    {
+      const int exit_code = result->second;
+      index = result->first;
+      ++result_counts[exit_code >= VERIFY_PASSED && exit_code <= VERIFY_NO_HASHES ?
+                          exit_code :
+                          VERIFY_FAILED];
+    }
+    else
+    {
+      if (kill_timeout_us == 0)
+        continue;
+
+      const u64 now = Common::Timer::GetTimeUs();
+      const auto timed_out = [&](u64 start_time) { return now - start_time > kill_timeout_us; };
+      const auto it =
+          std::find_if(process_start_times.begin(), process_start_times.end(), timed_out);
+      if (it == process_start_times.end())
+        continue;
+
+      index = it - process_start_times.begin();
+      KillProcess(processes[index]);
+      std::cout << movie_paths[process_movies[index]] << ": FAILED, process didn't exit in time"
+                << std::endl;
+      ++result_counts[VERIFY_FAILED];
+    }
+
+    File::DeleteDirRecursively(fmt::format("{}/{}", temp_directory, process_movies[index]));
+    processes.erase(processes.begin() + index);
+    process_movies.erase(process_movies.begin() + index);
+    process_start_times.erase(process_start_times.begin() + index);
+  }
+
+  File::DeleteDirRecursively(temp_directory);
+
+  std::cout << fmt::format("{} movies: {} passed, {} desynced, {} failed, {} without RAM hashes",
+                           movie_paths.size(), result_counts[VERIFY_PASSED],
+                           result_counts[VERIFY_DESYNCED], result_counts[VERIFY_FAILED],
+                           result_counts[VERIFY_NO_HASHES])
+            << std::endl;
+
+  return result_counts[VERIFY_PASSED] == movie_paths.size() ? 0 : 1;
+}
+
+}  // namespace DolphinTool
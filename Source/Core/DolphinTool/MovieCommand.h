@@ -0,0 +1,25 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "DolphinTool/Command.h"
+
+namespace DolphinTool
+{
+// "movie verify" plays movies back headlessly at unlimited speed and checks guest RAM against the
+// hashes that were stored in each movie's seek index while it was recorded. Several movies are
+// verified at once by running one dolphin-tool process per movie.
+class MovieCommand final : public Command
+{
+public:
+  int Main(const std::vector<std::string>& args) override;
+
+private:
+  int Verify(const std::vector<std::string>& args);
+};
+
+}  // namespace DolphinTool
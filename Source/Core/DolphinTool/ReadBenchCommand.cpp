@@ -0,0 +1,191 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/ReadBenchCommand.h"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/Timer.h"
+#include "DiscIO/FileBlob.h"
+
+namespace DolphinTool
+{
+struct BenchResult
+{
+  u64 bytes = 0;
+  u64 wall_us = 0;
+  u64 cpu_us = 0;
+};
+
+static u64 GetProcessCPUTimeUs()
+{
+#ifdef _WIN32
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (!GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time, &kernel_time, &user_time))
+    return 0;
+
+  // FILETIMEs are in units of 100 nanoseconds
+  const auto to_us = [](const FILETIME& time) {
+    return ((static_cast<u64>(time.dwHighDateTime) << 32) | time.dwLowDateTime) / 10;
+  };
+  return to_us(kernel_time) + to_us(user_time);
+#else
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+
+  const auto to_us = [](const timeval& time) {
+    return static_cast<u64>(time.tv_sec) * 1000000 + static_cast<u64>(time.tv_usec);
+  };
+  return to_us(usage.ru_utime) + to_us(usage.ru_stime);
+#endif
+}
+
+static BenchResult ReadSequential(DiscIO::BlobReader* reader, u64 size, u64 block_size)
+{
+  std::vector<u8> buffer(block_size);
+  BenchResult result;
+
+  const u64 start_wall_time = Common::Timer::GetTimeUs();
+  const u64 start_cpu_time = GetProcessCPUTimeUs();
+
+  for (u64 offset = 0; offset < size; offset += block_size)
+  {
+    const u64 bytes_to_read = std::min(block_size, size - offset);
+    if (!reader->Read(offset, bytes_to_read, buffer.data()))
+      break;
+    result.bytes += bytes_to_read;
+  }
+
+  result.wall_us = Common::Timer::GetTimeUs() - start_wall_time;
+  result.cpu_us = GetProcessCPUTimeUs() - start_cpu_time;
+  return result;
+}
+
+static BenchResult ReadRandom(DiscIO::BlobReader* reader, u64 size, u64 block_size, u64 count)
+{
+  std::vector<u8> buffer(block_size);
+  BenchResult result;
+
+  // The same seed is used for every reader so that they all read the same offsets
+  std::mt19937_64 rng(0);
+  const u64 max_offset = size > block_size ? size - block_size : 0;
+
+  const u64 start_wall_time = Common::Timer::GetTimeUs();
+  const u64 start_cpu_time = GetProcessCPUTimeUs();
+
+  for (u64 i = 0; i < count; ++i)
+  {
+    // Like the DVD drive, read from the start of a sector
+    const u64 offset = rng() % (max_offset + 1) / 0x800 * 0x800;
+    const u64 bytes_to_read = std::min(block_size, size - offset);
+    if (!reader->Read(offset, bytes_to_read, buffer.data()))
+      break;
+    result.bytes += bytes_to_read;
+  }
+
+  result.wall_us = Common::Timer::GetTimeUs() - start_wall_time;
+  result.cpu_us = GetProcessCPUTimeUs() - start_cpu_time;
+  return result;
+}
+
+static void PrintResult(const std::string& name, const BenchResult& result)
+{
+  const double mib = result.bytes / (1024.0 * 1024.0);
+  const double wall_seconds = std::max<u64>(result.wall_us, 1) / 1000000.0;
+  std::cout << fmt::format("{:<18} {:>10.1f} MiB/s, {:>8.3f} ms CPU per MiB", name,
+                           mib / wall_seconds, mib > 0 ? result.cpu_us / 1000.0 / mib : 0.0)
+            << std::endl;
+}
+
+int ReadBenchCommand::Main(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: read-bench [options]...");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to a plain disc image (ISO/GCM) to read.")
+      .metavar("FILE");
+
+  parser.add_option("-b", "--block_size")
+      .type("int")
+      .action("store")
+      .set_default(0x8000)
+      .help("Optional. Size of each read in bytes. Default is 32768.");
+
+  parser.add_option("-s", "--size")
+      .type("int")
+      .action("store")
+      .set_default(0)
+      .help("Optional. Only read this many MiB sequentially. Default is the whole file.")
+      .metavar("MIB");
+
+  parser.add_option("-r", "--random_reads")
+      .type("int")
+      .action("store")
+      .set_default(100000)
+      .help("Optional. Number of random reads. Default is 100000.");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  const std::string input_path = static_cast<const char*>(options.get("input"));
+  if (input_path.empty())
+  {
+    std::cerr << "Error: No input set" << std::endl;
+    return 1;
+  }
+
+  const u64 block_size = std::max(static_cast<int>(options.get("block_size")), 1);
+  const u64 size_limit = std::max(static_cast<int>(options.get("size")), 0) * u64(1024 * 1024);
+  const u64 random_reads = std::max(static_cast<int>(options.get("random_reads")), 0);
+
+  std::unique_ptr<DiscIO::PlainFileReader> stdio_reader =
+      DiscIO::PlainFileReader::Create(File::IOFile(input_path, "rb"));
+  std::unique_ptr<DiscIO::PlainFileReader> mapped_reader =
+      DiscIO::PlainFileReader::Create(File::IOFile(input_path, "rb"), input_path);
+  if (!stdio_reader || !mapped_reader)
+  {
+    std::cerr << "Error: Unable to open " << input_path << std::endl;
+    return 1;
+  }
+  if (!mapped_reader->IsMapped())
+  {
+    std::cerr << "Error: Unable to map " << input_path << " into memory" << std::endl;
+    return 1;
+  }
+
+  const u64 file_size = stdio_reader->GetDataSize();
+  const u64 size = size_limit != 0 ? std::min(size_limit, file_size) : file_size;
+
+  // Read everything once up front, so that the readers are compared with each other rather than
+  // with whatever the storage device happened to have cached
+  ReadSequential(stdio_reader.get(), size, 0x100000);
+
+  PrintResult("Sequential stdio", ReadSequential(stdio_reader.get(), size, block_size));
+  PrintResult("Sequential mmap", ReadSequential(mapped_reader.get(), size, block_size));
+  PrintResult("Random stdio", ReadRandom(stdio_reader.get(), size, block_size, random_reads));
+  PrintResult("Random mmap", ReadRandom(mapped_reader.get(), size, block_size, random_reads));
+
+  return 0;
+}
+
+}  // namespace DolphinTool
@@ -0,0 +1,21 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "DolphinTool/Command.h"
+
+namespace DolphinTool
+{
+// Reads a plain disc image through PlainFileReader, once with stdio and once memory-mapped, and
+// reports the throughput and CPU time of each for sequential and random reads.
+class ReadBenchCommand final : public Command
+{
+public:
+  int Main(const std::vector<std::string>& args) override;
+};
+
+}  // namespace DolphinTool
@@ -0,0 +1,203 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/StateBenchCommand.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <thread>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Timer.h"
+#include "Common/WindowSystemInfo.h"
+#include "Core/Boot/Boot.h"
+#include "Core/BootManager.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/Movie.h"
+#include "Core/State.h"
+#include "UICommon/UICommon.h"
+
+namespace DolphinTool
+{
+int StateBenchCommand::Main(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: state-bench [options]...");
+
+  parser.add_option("-u", "--user")
+      .action("store")
+      .help("User folder path, required for temporary processing files. "
+            "Will be automatically created if this option is not set.");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to the game to boot.")
+      .metavar("FILE");
+
+  parser.add_option("-f", "--frames")
+      .type("int")
+      .action("store")
+      .set_default(3600)
+      .help("Optional. Number of frames to run for. Default is 3600.");
+
+  parser.add_option("-s", "--snapshots")
+      .type("int")
+      .action("store")
+      .set_default(600)
+      .help("Optional. Number of snapshots to keep. Default is 600.");
+
+  parser.add_option("-r", "--rewind_every")
+      .type("int")
+      .action("store")
+      .set_default(300)
+      .help("Optional. Rewind this many frames after every N frames. Default is 300.");
+
+  parser.add_option("-l", "--file_states")
+      .type("int")
+      .action("store")
+      .set_default(0)
+      .help("Optional. Afterwards, save the state to a file and load it back N times.")
+      .metavar("N");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  std::string user_directory;
+  if (options.is_set("user"))
+    user_directory = static_cast<const char*>(options.get("user"));
+
+  UICommon::SetUserDirectory(user_directory);
+  UICommon::Init();
+
+  // --input
+  const std::string input_path = static_cast<const char*>(options.get("input"));
+  if (input_path.empty())
+  {
+    std::cerr << "Error: No input set" << std::endl;
+    return 1;
+  }
+
+  const u64 target_frames = std::max(static_cast<int>(options.get("frames")), 1);
+  const u32 snapshots = std::max(static_cast<int>(options.get("snapshots")), 1);
+  const u64 rewind_every = std::max(static_cast<int>(options.get("rewind_every")), 1);
+  const int file_states = std::max(static_cast<int>(options.get("file_states")), 0);
+
+  // The game runs at full speed rather than unthrottled so that the host thread, which takes the
+  // snapshots, keeps up with every frame, as it would while playing.
+  Config::SetCurrent(Config::MAIN_GFX_BACKEND, std::string("Null"));
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 1.0f);
+  Config::SetCurrent(Config::MAIN_AUDIO_BACKEND, std::string(BACKEND_NULLSOUND));
+  Config::SetCurrent(Config::MAIN_REWIND_SNAPSHOTS, snapshots);
+  Config::SetCurrent(Config::MAIN_REWIND_INTERVAL, 1u);
+
+  const u64 start_time = Common::Timer::GetTimeUs();
+
+  WindowSystemInfo wsi(WindowSystemType::Headless, nullptr, nullptr, nullptr);
+  if (!BootManager::BootCore(BootParameters::GenerateFromFile(input_path), wsi))
+  {
+    std::cerr << "Error: Unable to boot " << input_path << std::endl;
+    return 1;
+  }
+
+  // Movie::GetCurrentFrame is part of the savestate and goes back on rewind, so frames are counted
+  // separately.
+  u64 frames_run = 0;
+  u64 last_frame = Movie::GetCurrentFrame();
+  u64 frames_since_rewind = 0;
+  while (frames_run < target_frames && Core::GetState() != Core::State::Uninitialized)
+  {
+    Core::HostDispatchJobs();
+
+    const u64 frame = Movie::GetCurrentFrame();
+    if (frame != last_frame)
+    {
+      const u64 elapsed = frame > last_frame ? frame - last_frame : 1;
+      frames_run += elapsed;
+      frames_since_rewind += elapsed;
+      last_frame = frame;
+    }
+
+    if (frames_since_rewind >= rewind_every)
+    {
+      frames_since_rewind = 0;
+      State::Rewind(std::min<u64>(rewind_every, snapshots) / 2);
+      last_frame = Movie::GetCurrentFrame();
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  const double wall_time_ms = (Common::Timer::GetTimeUs() - start_time) / 1000.0;
+  const std::optional<State::StateRing::Stats> stats = State::GetRewindStats();
+
+  const std::string state_path = File::GetUserPath(D_STATESAVES_IDX) + "state-bench.sav";
+  u64 total_save_us = 0;
+  u64 total_load_us = 0;
+  for (int i = 0; i < file_states && Core::IsRunning(); ++i)
+  {
+    const u64 save_start_time = Common::Timer::GetTimeUs();
+    State::SaveAs(state_path, true);
+    const u64 load_start_time = Common::Timer::GetTimeUs();
+    State::LoadAs(state_path);
+    total_save_us += load_start_time - save_start_time;
+    total_load_us += Common::Timer::GetTimeUs() - load_start_time;
+  }
+  const u64 state_file_size = File::GetSize(state_path);
+  File::Delete(state_path);
+
+  Core::Stop();
+  Core::Shutdown();
+  UICommon::Shutdown();
+
+  if (!stats || stats->num_captures == 0)
+  {
+    std::cerr << "Error: No snapshots were taken" << std::endl;
+    return 1;
+  }
+
+  const u64 num_deltas = std::max<u64>(stats->num_captures, 2) - 1;
+  std::cout << fmt::format("Frames:    {} in {:.1f} ms", frames_run, wall_time_ms) << std::endl;
+  std::cout << fmt::format("Capture:   {} snapshots, avg {:.3f} ms, max {:.3f} ms",
+                           stats->num_captures,
+                           stats->total_capture_us / 1000.0 / stats->num_captures,
+                           stats->max_capture_us / 1000.0)
+            << std::endl;
+  std::cout << fmt::format("Restore:   {} rewinds, avg {:.3f} ms, max {:.3f} ms",
+                           stats->num_restores,
+                           stats->total_restore_us / 1000.0 / std::max<u64>(stats->num_restores, 1),
+                           stats->max_restore_us / 1000.0)
+            << std::endl;
+  std::cout << fmt::format("Per frame: {:.3f} ms capturing and restoring",
+                           (stats->total_capture_us + stats->total_restore_us) / 1000.0 /
+                               std::max<u64>(frames_run, 1))
+            << std::endl;
+  std::cout << fmt::format("Pages:     avg {} written and {} changed per snapshot, {}",
+                           stats->dirty_pages / num_deltas, stats->changed_pages / num_deltas,
+                           stats->tracking_writes ? "writes tracked" :
+                                                    "writes not tracked, all pages compared")
+            << std::endl;
+  std::cout << fmt::format("Memory:    {} KiB full state, {} KiB in deltas, avg {} KiB per delta",
+                           stats->state_size / 1024, stats->stored_delta_bytes / 1024,
+                           stats->captured_delta_bytes / 1024 / num_deltas)
+            << std::endl;
+
+  if (file_states != 0)
+  {
+    std::cout << fmt::format("File:      {} KiB, save avg {:.3f} ms, load avg {:.3f} ms",
+                             state_file_size / 1024, total_save_us / 1000.0 / file_states,
+                             total_load_us / 1000.0 / file_states)
+              << std::endl;
+  }
+
+  return 0;
+}
+
+}  // namespace DolphinTool
@@ -0,0 +1,22 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "DolphinTool/Command.h"
+
+namespace DolphinTool
+{
+// Boots a game headlessly with rewinding enabled, takes a rewind snapshot every frame and rewinds
+// periodically, then reports what capturing and restoring cost per frame. Optionally also times
+// saving the state to a file and loading it back.
+class StateBenchCommand final : public Command
+{
+public:
+  int Main(const std::vector<std::string>& args) override;
+};
+
+}  // namespace DolphinTool
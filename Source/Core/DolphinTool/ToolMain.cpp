@@ -10,13 +10,20 @@
 #include "Common/Version.h"
 #include "DolphinTool/Command.h"
 #include "DolphinTool/ConvertCommand.h"
+#include "DolphinTool/FifoCommand.h"
 #include "DolphinTool/HeaderCommand.h"
+#include "DolphinTool/MicroBenchCommand.h"
+#include "DolphinTool/MovieCommand.h"
+#include "DolphinTool/ReadBenchCommand.h"
+#include "DolphinTool/StateBenchCommand.h"
 #include "DolphinTool/VerifyCommand.h"
 
 static int PrintUsage(int code)
 {
   std::cerr << "usage: dolphin-tool COMMAND -h" << std::endl << std::endl;
-  std::cerr << "commands supported: [convert, verify, header]" << std::endl;
+  std::cerr << "commands supported: [convert, verify, header, fifo, movie, state-bench, "
+               "read-bench, micro-bench]"
+            << std::endl;
 
   return code;
 }
@@ -45,6 +52,16 @@ int main(int argc, char* argv[])
     command = std::make_unique<DolphinTool::VerifyCommand>();
   else if (command_str == "header")
     command = std::make_unique<DolphinTool::HeaderCommand>();
+  else if (command_str == "fifo")
+    command = std::make_unique<DolphinTool::FifoCommand>();
+  else if (command_str == "movie")
+    command = std::make_unique<DolphinTool::MovieCommand>();
+  else if (command_str == "state-bench")
+    command = std::make_unique<DolphinTool::StateBenchCommand>();
+  else if (command_str == "read-bench")
+    command = std::make_unique<DolphinTool::ReadBenchCommand>();
+  else if (command_str == "micro-bench")
+    command = std::make_unique<DolphinTool::MicroBenchCommand>();
   else
     return PrintUsage(1);
 
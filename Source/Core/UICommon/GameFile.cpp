@@ -115,6 +115,12 @@ GameFile::GameFile(std::string path) : m_file_path(std::move(path))
 {
   m_file_name = PathToFileName(m_file_path);
 
+  // Taken before reading anything, so that changes made while reading are noticed next time.
+  const File::FileInfo file_info(m_file_path);
+  m_disk_size = file_info.GetSize();
+  m_disk_modification_time = file_info.GetModificationTime();
+  m_disk_inode = file_info.GetInode();
+
   {
     std::unique_ptr<DiscIO::Volume> volume(DiscIO::CreateVolume(m_file_path));
     if (volume != nullptr)
@@ -352,6 +358,9 @@ void GameFile::DoState(PointerWrap& p)
   p.Do(m_volume_size_is_accurate);
   p.Do(m_is_datel_disc);
   p.Do(m_is_nkit);
+  p.Do(m_disk_size);
+  p.Do(m_disk_modification_time);
+  p.Do(m_disk_inode);
 
   p.Do(m_short_names);
   p.Do(m_long_names);
@@ -383,6 +392,14 @@ void GameFile::DoState(PointerWrap& p)
   m_custom_cover.DoState(p);
 }
 
+bool GameFile::ChangedOnDisk() const
+{
+  const File::FileInfo file_info(m_file_path);
+  return file_info.GetSize() != m_disk_size ||
+         file_info.GetModificationTime() != m_disk_modification_time ||
+         file_info.GetInode() != m_disk_inode;
+}
+
 std::string GameFile::GetExtension() const
 {
   std::string extension;
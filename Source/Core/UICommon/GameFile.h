@@ -111,6 +111,9 @@ public:
   const GameBanner& GetBannerImage() const;
   const GameCover& GetCoverImage() const;
   void DoState(PointerWrap& p);
+  // Returns whether the size, modification time or inode of the file differ from when this
+  // GameFile was created. This function is slow on network storage.
+  bool ChangedOnDisk() const;
   bool XMLMetadataChanged();
   void XMLMetadataCommit();
   bool WiiBannerChanged();
@@ -149,6 +152,11 @@ private:
   bool m_is_datel_disc{};
   bool m_is_nkit{};
 
+  // The state of the file on disk when it was read, see ChangedOnDisk
+  u64 m_disk_size{};
+  s64 m_disk_modification_time{};
+  u64 m_disk_inode{};
+
   std::map<DiscIO::Language, std::string> m_short_names;
   std::map<DiscIO::Language, std::string> m_long_names;
   std::map<DiscIO::Language, std::string> m_short_makers;
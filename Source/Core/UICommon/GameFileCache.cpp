@@ -5,12 +5,16 @@
 
 #include <algorithm>
 #include <atomic>
+#include <condition_variable>
 #include <cstddef>
+#include <cstring>
 #include <functional>
+#include <future>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -20,6 +24,7 @@
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 
 #include "DiscIO/DirectoryBlob.h"
 
@@ -27,7 +32,40 @@
 
 namespace UICommon
 {
-static constexpr u32 CACHE_REVISION = 21;  // Last changed in PR 10187
+static constexpr u32 CACHE_REVISION = 22;  // Last changed to add entry offsets and file stamps
+
+// Scanning mostly waits for the disk (or network storage), so use more threads than cores.
+static constexpr unsigned int SCAN_THREADS_PER_CORE = 2;
+
+// The cache file starts with this header, followed by entry_count + 1 offsets (from the start of
+// the file) which delimit the serialized GameFiles. Each entry can be read on its own.
+struct CacheHeader
+{
+  u32 revision;
+  u32 entry_count;
+  u64 file_size;
+};
+
+// Calls function(i) for every i below count on a pool of worker threads. The returned futures
+// finish when all work is done.
+template <typename Function>
+static std::vector<std::future<void>> StartWorkers(size_t count, Function function)
+{
+  const size_t thread_count = std::min<size_t>(
+      count, std::max(1u, std::thread::hardware_concurrency()) * SCAN_THREADS_PER_CORE);
+
+  auto next_index = std::make_shared<std::atomic<size_t>>(0);
+  std::vector<std::future<void>> workers;
+  workers.reserve(thread_count);
+  for (size_t i = 0; i < thread_count; ++i)
+  {
+    workers.emplace_back(std::async(std::launch::async, [count, next_index, function] {
+      for (size_t index = (*next_index)++; index < count; index = (*next_index)++)
+        function(index);
+    }));
+  }
+  return workers;
+}
 
 std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& directories_to_scan,
                                           bool recursive_scan)
@@ -131,24 +169,81 @@ bool GameFileCache::Update(
     m_cached_files.erase(it, m_cached_files.end());
   }
 
-  // Now that the previous loop has run, game_paths only contains paths that
-  // aren't in m_cached_files, so we simply add all of them to m_cached_files.
-  for (const std::string& path : game_paths)
+  // game_paths now only contains paths that aren't in m_cached_files. Files that have been
+  // modified since they were cached get scanned again along with them.
+  std::vector<std::string> paths_to_scan(game_paths.begin(), game_paths.end());
+  if (!processing_halted)
   {
-    if (processing_halted)
-      break;
+    std::vector<u8> changed(m_cached_files.size());
+    std::vector<std::future<void>> workers = StartWorkers(m_cached_files.size(), [&](size_t i) {
+      changed[i] = !processing_halted && m_cached_files[i]->ChangedOnDisk();
+    });
+    for (std::future<void>& worker : workers)
+      worker.get();
+
+    size_t kept = 0;
+    for (size_t i = 0; i < m_cached_files.size(); ++i)
+    {
+      if (!changed[i])
+      {
+        m_cached_files[kept++] = std::move(m_cached_files[i]);
+        continue;
+      }
+
+      const std::string& path = m_cached_files[i]->GetFilePath();
+      if (game_removed_from_cache)
+        game_removed_from_cache(path);
+
+      cache_changed = true;
+      paths_to_scan.push_back(path);
+    }
+    m_cached_files.resize(kept);
+  }
+
+  // Scan the files on worker threads, but hand them to game_added_to_cache on this thread as they
+  // become ready.
+  std::mutex mutex;
+  std::condition_variable scanned_cv;
+  std::vector<std::shared_ptr<GameFile>> scanned;
+  std::vector<std::future<void>> workers = StartWorkers(paths_to_scan.size(), [&](size_t i) {
+    std::shared_ptr<GameFile> file;
+    if (!processing_halted)
+      file = std::make_shared<GameFile>(paths_to_scan[i]);
 
-    auto file = std::make_shared<GameFile>(path);
-    if (file->IsValid())
     {
+      std::lock_guard lock(mutex);
+      scanned.push_back(std::move(file));
+    }
+    scanned_cv.notify_one();
+  });
+
+  std::vector<std::shared_ptr<GameFile>> ready;
+  for (size_t received = 0; received < paths_to_scan.size();)
+  {
+    {
+      std::unique_lock lock(mutex);
+      scanned_cv.wait(lock, [&] { return !scanned.empty(); });
+      std::swap(ready, scanned);
+    }
+    received += ready.size();
+
+    for (std::shared_ptr<GameFile>& file : ready)
+    {
+      if (!file || !file->IsValid())
+        continue;
+
       if (game_added_to_cache)
         game_added_to_cache(file);
 
       cache_changed = true;
       m_cached_files.push_back(std::move(file));
     }
+    ready.clear();
   }
 
+  for (std::future<void>& worker : workers)
+    worker.get();
+
   return cache_changed;
 }
 
@@ -211,79 +306,108 @@ bool GameFileCache::UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_fil
 
 bool GameFileCache::Load()
 {
-  return SyncCacheFile(false);
-}
-
-bool GameFileCache::Save()
-{
-  return SyncCacheFile(true);
-}
-
-bool GameFileCache::SyncCacheFile(bool save)
-{
-  const char* open_mode = save ? "wb" : "rb";
-  File::IOFile f(m_path, open_mode);
-  if (!f)
+  if (!File::Exists(m_path))
     return false;
-  bool success = false;
-  if (save)
-  {
-    // Measure the size of the buffer.
-    u8* ptr = nullptr;
-    PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-    DoState(&p_measure);
-    const size_t buffer_size = reinterpret_cast<size_t>(ptr);
 
-    // Then actually do the write.
-    std::vector<u8> buffer(buffer_size);
-    ptr = buffer.data();
-    PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-    DoState(&p, buffer_size);
-    if (f.WriteBytes(buffer.data(), buffer.size()))
-      success = true;
-  }
-  else
+  // Entries are read straight out of the mapping, in parallel. Only the pages that hold the
+  // header are touched before the entries are handed out to the workers.
+  std::vector<std::shared_ptr<GameFile>> files;
+  std::atomic_bool success{false};
   {
-    std::vector<u8> buffer(f.GetSize());
-    if (!buffer.empty() && f.ReadBytes(buffer.data(), buffer.size()))
+    const File::MappedFile file(m_path);
+    const u8* const data = file.GetData();
+    const u64 size = file.GetSize();
+
+    CacheHeader header{};
+    if (size >= sizeof(header))
+      std::memcpy(&header, data, sizeof(header));
+
+    const u64 offsets_end = sizeof(header) + (u64(header.entry_count) + 1) * sizeof(u64);
+    std::vector<u64> offsets;
+    if (header.revision == CACHE_REVISION && header.file_size == size && offsets_end <= size)
+    {
+      offsets.resize(header.entry_count + 1);
+      std::memcpy(offsets.data(), data + sizeof(header), offsets.size() * sizeof(u64));
+    }
+
+    const bool offsets_valid =
+        !offsets.empty() && offsets.front() == offsets_end && offsets.back() == size &&
+        std::is_sorted(offsets.begin(), offsets.end());
+
+    success = offsets_valid;
+    if (offsets_valid)
     {
-      u8* ptr = buffer.data();
-      PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
-      DoState(&p, buffer.size());
-      if (p.IsReadMode())
-        success = true;
+      files.resize(header.entry_count);
+      std::vector<std::future<void>> workers = StartWorkers(files.size(), [&](size_t i) {
+        // PointerWrap never writes in read mode.
+        u8* ptr = const_cast<u8*>(data + offsets[i]);
+        u8* const entry_end = const_cast<u8*>(data + offsets[i + 1]);
+        PointerWrap p(&ptr, entry_end - ptr, PointerWrap::Mode::Read);
+        files[i] = std::make_shared<GameFile>();
+        files[i]->DoState(p);
+        if (!p.IsReadMode() || ptr != entry_end)
+          success = false;
+      });
+      for (std::future<void>& worker : workers)
+        worker.get();
     }
   }
+
   if (!success)
   {
-    // If some file operation failed, try to delete the probably-corrupted cache
-    f.Close();
+    // The cache is probably corrupted or outdated
     File::Delete(m_path);
+    return false;
   }
-  return success;
+
+  m_cached_files = std::move(files);
+  return true;
 }
 
-void GameFileCache::DoState(PointerWrap* p, u64 size)
+bool GameFileCache::Save()
 {
-  struct
+  std::vector<std::vector<u8>> entries(m_cached_files.size());
+  for (size_t i = 0; i < entries.size(); ++i)
   {
-    u32 revision;
-    u64 expected_size;
-  } header = {CACHE_REVISION, size};
-  p->Do(header);
-  if (p->IsReadMode())
+    // Measure the size of the buffer.
+    u8* ptr = nullptr;
+    PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+    m_cached_files[i]->DoState(p_measure);
+    const size_t buffer_size = reinterpret_cast<size_t>(ptr);
+
+    // Then actually do the write.
+    entries[i].resize(buffer_size);
+    ptr = entries[i].data();
+    PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
+    m_cached_files[i]->DoState(p);
+  }
+
+  std::vector<u64> offsets(entries.size() + 1);
+  offsets[0] = sizeof(CacheHeader) + offsets.size() * sizeof(u64);
+  for (size_t i = 0; i < entries.size(); ++i)
+    offsets[i + 1] = offsets[i] + entries[i].size();
+
+  const CacheHeader header{CACHE_REVISION, static_cast<u32>(entries.size()), offsets.back()};
+
+  // The cache is written next to the old one and then renamed over it, because Load reads the
+  // old one through a mapping
+  const std::string temp_path = m_path + ".tmp";
+  File::IOFile f(temp_path, "wb");
+  if (!f)
+    return false;
+
+  bool success = f.WriteArray(&header, 1) && f.WriteArray(offsets.data(), offsets.size());
+  for (const std::vector<u8>& entry : entries)
+    success = success && f.WriteBytes(entry.data(), entry.size());
+  success = f.Close() && success;
+
+  if (!success || !File::Rename(temp_path, m_path))
   {
-    if (header.revision != CACHE_REVISION || header.expected_size != size)
-    {
-      p->SetMeasureMode();
-      return;
-    }
+    // If some file operation failed, try to delete the probably-corrupted cache
+    File::Delete(temp_path);
+    return false;
   }
-  p->DoEachElement(m_cached_files, [](PointerWrap& state, std::shared_ptr<GameFile>& elem) {
-    if (state.IsReadMode())
-      elem = std::make_shared<GameFile>();
-    elem->DoState(state);
-  });
+  return true;
 }
 
 }  // namespace UICommon
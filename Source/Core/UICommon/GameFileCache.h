@@ -12,8 +12,6 @@
 
 #include "Common/CommonTypes.h"
 
-class PointerWrap;
-
 namespace UICommon
 {
 class GameFile;
@@ -55,9 +53,6 @@ public:
 private:
   bool UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_file);
 
-  bool SyncCacheFile(bool save);
-  void DoState(PointerWrap* p, u64 size = 0);
-
   std::string m_path;
   std::vector<std::shared_ptr<GameFile>> m_cached_files;
 };
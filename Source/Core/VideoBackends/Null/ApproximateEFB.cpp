@@ -0,0 +1,131 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoBackends/Null/ApproximateEFB.h"
+
+#include <algorithm>
+
+#include "VideoCommon/RenderBase.h"
+#include "VideoCommon/VideoBackendBase.h"
+
+namespace Null
+{
+ApproximateEFB::ApproximateEFB() : m_color(WIDTH * HEIGHT, 0), m_depth(WIDTH * HEIGHT, 0xFFFFFF)
+{
+}
+
+size_t ApproximateEFB::GetIndex(u32 x, u32 y)
+{
+  const u32 scaled_x = std::min(x >> SCALE_SHIFT, WIDTH - 1);
+  const u32 scaled_y = std::min(y >> SCALE_SHIFT, HEIGHT - 1);
+  return scaled_y * WIDTH + scaled_x;
+}
+
+void ApproximateEFB::Clear(const MathUtil::Rectangle<int>& rc, bool color_enable,
+                           bool alpha_enable, bool z_enable, u32 color, u32 z)
+{
+  const int left = std::clamp(rc.left, 0, static_cast<int>(EFB_WIDTH)) >> SCALE_SHIFT;
+  const int right = std::clamp(rc.right, 0, static_cast<int>(EFB_WIDTH)) >> SCALE_SHIFT;
+  const int top = std::clamp(rc.top, 0, static_cast<int>(EFB_HEIGHT)) >> SCALE_SHIFT;
+  const int bottom = std::clamp(rc.bottom, 0, static_cast<int>(EFB_HEIGHT)) >> SCALE_SHIFT;
+
+  u32 color_mask = 0;
+  if (color_enable)
+    color_mask |= 0x00FFFFFF;
+  if (alpha_enable)
+    color_mask |= 0xFF000000;
+
+  for (int y = top; y < bottom; y++)
+  {
+    for (int x = left; x < right; x++)
+    {
+      const size_t index = y * WIDTH + x;
+      m_color[index] = (m_color[index] & ~color_mask) | (color & color_mask);
+      if (z_enable)
+        m_depth[index] = z & 0xFFFFFF;
+    }
+  }
+}
+
+void ApproximateEFB::Poke(EFBAccessType type, const EfbPokeData* points, size_t num_points)
+{
+  std::vector<u32>& buffer = type == EFBAccessType::PokeColor ? m_color : m_depth;
+  const u32 mask = type == EFBAccessType::PokeColor ? 0xFFFFFFFF : 0xFFFFFF;
+  for (size_t i = 0; i < num_points; i++)
+    buffer[GetIndex(points[i].x, points[i].y)] = points[i].data & mask;
+}
+
+u32 ApproximateEFB::PeekColor(u32 x, u32 y) const
+{
+  return m_color[GetIndex(x, y)];
+}
+
+u32 ApproximateEFB::PeekDepth(u32 x, u32 y) const
+{
+  return m_depth[GetIndex(x, y)];
+}
+
+void ApproximateEFB::EncodeXFB(u8* dst, size_t dst_stride, u32 native_width, u32 num_lines,
+                               const MathUtil::Rectangle<int>& src_rect) const
+{
+  if (native_width == 0 || num_lines == 0)
+    return;
+
+  const auto to_yuv = [](u32 color, int* y, int* u, int* v) {
+    const float red = static_cast<float>((color >> 16) & 0xFF);
+    const float green = static_cast<float>((color >> 8) & 0xFF);
+    const float blue = static_cast<float>(color & 0xFF);
+
+    // BT.601, as used by the hardware and the software renderer.
+    *y = static_cast<int>(0.257f * red + 0.504f * green + 0.098f * blue) + 16;
+    *u = static_cast<int>(-0.148f * red + -0.291f * green + 0.439f * blue) + 128;
+    *v = static_cast<int>(0.439f * red + -0.368f * green + -0.071f * blue) + 128;
+  };
+
+  const int src_width = std::max(src_rect.GetWidth(), 1);
+  const int src_height = std::max(src_rect.GetHeight(), 1);
+  for (u32 line = 0; line < num_lines; line++)
+  {
+    const u32 src_y = static_cast<u32>(src_rect.top + line * src_height / num_lines);
+    u8* out = dst + line * dst_stride;
+    for (u32 x = 0; x + 1 < native_width; x += 2)
+    {
+      const u32 src_x0 = static_cast<u32>(src_rect.left + x * src_width / native_width);
+      const u32 src_x1 = static_cast<u32>(src_rect.left + (x + 1) * src_width / native_width);
+
+      int y0, u0, v0, y1, u1, v1;
+      to_yuv(PeekColor(src_x0, src_y), &y0, &u0, &v0);
+      to_yuv(PeekColor(src_x1, src_y), &y1, &u1, &v1);
+
+      // YUYV: both pixels share the averaged chroma.
+      *out++ = static_cast<u8>(std::clamp(y0, 0, 255));
+      *out++ = static_cast<u8>(std::clamp((u0 + u1) / 2, 0, 255));
+      *out++ = static_cast<u8>(std::clamp(y1, 0, 255));
+      *out++ = static_cast<u8>(std::clamp((v0 + v1) / 2, 0, 255));
+    }
+  }
+}
+
+void ApproximateEFB::IncludeInBoundingBox(const MathUtil::Rectangle<int>& rect)
+{
+  if (rect.GetWidth() <= 0 || rect.GetHeight() <= 0)
+    return;
+
+  // Left, right, top and bottom; right and bottom are inclusive.
+  m_bounding_box[0] = std::min(m_bounding_box[0], rect.left);
+  m_bounding_box[1] = std::max(m_bounding_box[1], rect.right - 1);
+  m_bounding_box[2] = std::min(m_bounding_box[2], rect.top);
+  m_bounding_box[3] = std::max(m_bounding_box[3], rect.bottom - 1);
+}
+
+std::vector<BBoxType> ApproximateEFB::ReadBoundingBox(u32 index, u32 length) const
+{
+  return std::vector<BBoxType>(m_bounding_box.begin() + index,
+                               m_bounding_box.begin() + index + length);
+}
+
+void ApproximateEFB::WriteBoundingBox(u32 index, const std::vector<BBoxType>& values)
+{
+  std::copy(values.begin(), values.end(), m_bounding_box.begin() + index);
+}
+}  // namespace Null
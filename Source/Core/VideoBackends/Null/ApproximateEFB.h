@@ -0,0 +1,57 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/MathUtil.h"
+#include "VideoCommon/BoundingBox.h"
+#include "VideoCommon/VideoCommon.h"
+
+enum class EFBAccessType;
+struct EfbPokeData;
+
+namespace Null
+{
+// A coarse, CPU-side stand-in for the EFB, used by the null backend's analysis mode.
+//
+// Nothing is rasterized. Only clears and pokes are tracked, at a fraction of the native
+// resolution, which is enough for games that peek at values they cleared or poked themselves and
+// for producing low resolution XFB copies. The bounding box is approximated by the part of the
+// viewport that passes the scissor test for every draw made while it is active.
+class ApproximateEFB
+{
+public:
+  static constexpr u32 SCALE_SHIFT = 2;
+  static constexpr u32 WIDTH = EFB_WIDTH >> SCALE_SHIFT;
+  static constexpr u32 HEIGHT = EFB_HEIGHT >> SCALE_SHIFT;
+
+  ApproximateEFB();
+
+  // Color values are ARGB8, depth values are 24-bit.
+  void Clear(const MathUtil::Rectangle<int>& rc, bool color_enable, bool alpha_enable,
+             bool z_enable, u32 color, u32 z);
+  void Poke(EFBAccessType type, const EfbPokeData* points, size_t num_points);
+  u32 PeekColor(u32 x, u32 y) const;
+  u32 PeekDepth(u32 x, u32 y) const;
+
+  // Writes num_lines rows of YUYV pixels, native_width pixels each, sampled from src_rect.
+  void EncodeXFB(u8* dst, size_t dst_stride, u32 native_width, u32 num_lines,
+                 const MathUtil::Rectangle<int>& src_rect) const;
+
+  void IncludeInBoundingBox(const MathUtil::Rectangle<int>& rect);
+  std::vector<BBoxType> ReadBoundingBox(u32 index, u32 length) const;
+  void WriteBoundingBox(u32 index, const std::vector<BBoxType>& values);
+
+private:
+  static size_t GetIndex(u32 x, u32 y);
+
+  std::vector<u32> m_color;
+  std::vector<u32> m_depth;
+  std::array<BBoxType, NUM_BBOX_VALUES> m_bounding_box = {};
+};
+}  // namespace Null
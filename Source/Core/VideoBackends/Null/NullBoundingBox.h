@@ -5,6 +5,7 @@
 
 #include "Common/CommonTypes.h"
 
+#include "VideoBackends/Null/ApproximateEFB.h"
 #include "VideoCommon/BoundingBox.h"
 
 namespace Null
@@ -12,14 +13,26 @@ namespace Null
 class NullBoundingBox final : public BoundingBox
 {
 public:
+  // Without an approximate EFB (i.e. outside of analysis mode), reads always return zeroes.
+  explicit NullBoundingBox(ApproximateEFB* approximate_efb) : m_approximate_efb(approximate_efb) {}
+
   bool Initialize() override { return true; }
 
 protected:
   std::vector<BBoxType> Read(u32 index, u32 length) override
   {
+    if (m_approximate_efb)
+      return m_approximate_efb->ReadBoundingBox(index, length);
     return std::vector<BBoxType>(length);
   }
-  void Write(u32 index, const std::vector<BBoxType>& values) override {}
+  void Write(u32 index, const std::vector<BBoxType>& values) override
+  {
+    if (m_approximate_efb)
+      m_approximate_efb->WriteBoundingBox(index, values);
+  }
+
+private:
+  ApproximateEFB* m_approximate_efb;
 };
 
 }  // namespace Null
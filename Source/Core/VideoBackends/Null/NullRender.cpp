@@ -3,12 +3,17 @@
 
 #include "VideoBackends/Null/NullRender.h"
 
+#include "Common/MsgHandler.h"
+
+#include "VideoBackends/Null/ApproximateEFB.h"
 #include "VideoBackends/Null/NullBoundingBox.h"
 #include "VideoBackends/Null/NullTexture.h"
 
 #include "VideoCommon/AbstractPipeline.h"
 #include "VideoCommon/AbstractShader.h"
 #include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/PixelEngine.h"
+#include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoConfig.h"
 
 namespace Null
@@ -17,6 +22,9 @@ namespace Null
 Renderer::Renderer() : ::Renderer(1, 1, 1.0f, AbstractTextureFormat::RGBA8)
 {
   UpdateActiveConfig();
+
+  if (g_ActiveConfig.bNullAnalysisMode)
+    m_approximate_efb = std::make_unique<ApproximateEFB>();
 }
 
 Renderer::~Renderer()
@@ -85,8 +93,46 @@ Renderer::CreateNativeVertexFormat(const PortableVertexDeclaration& vtx_decl)
   return std::make_unique<NativeVertexFormat>(vtx_decl);
 }
 
+u32 Renderer::AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data)
+{
+  if (!m_approximate_efb)
+    return 0;
+
+  if (type == EFBAccessType::PeekZ)
+    return m_approximate_efb->PeekDepth(x, y);
+
+  if (type != EFBAccessType::PeekColor)
+    return 0;
+
+  const u32 color = m_approximate_efb->PeekColor(x, y);
+
+  // check what to do with the alpha channel (GX_PokeAlphaRead)
+  const PixelEngine::AlphaReadMode alpha_read_mode = PixelEngine::GetAlphaReadMode();
+  if (alpha_read_mode == PixelEngine::AlphaReadMode::ReadNone)
+    return color;
+  if (alpha_read_mode == PixelEngine::AlphaReadMode::ReadFF)
+    return color | 0xFF000000;
+
+  if (alpha_read_mode != PixelEngine::AlphaReadMode::Read00)
+    PanicAlertFmt("Invalid PE alpha read mode: {}", static_cast<u16>(alpha_read_mode));
+  return color & 0x00FFFFFF;
+}
+
+void Renderer::PokeEFB(EFBAccessType type, const EfbPokeData* points, size_t num_points)
+{
+  if (m_approximate_efb)
+    m_approximate_efb->Poke(type, points, num_points);
+}
+
+void Renderer::ClearScreen(const MathUtil::Rectangle<int>& rc, bool colorEnable, bool alphaEnable,
+                           bool zEnable, u32 color, u32 z)
+{
+  if (m_approximate_efb)
+    m_approximate_efb->Clear(rc, colorEnable, alphaEnable, zEnable, color, z);
+}
+
 std::unique_ptr<BoundingBox> Renderer::CreateBoundingBox() const
 {
-  return std::make_unique<NullBoundingBox>();
+  return std::make_unique<NullBoundingBox>(m_approximate_efb.get());
 }
 }  // namespace Null
@@ -3,12 +3,16 @@
 
 #pragma once
 
+#include <memory>
+
 #include "VideoCommon/RenderBase.h"
 
 class BoundingBox;
 
 namespace Null
 {
+class ApproximateEFB;
+
 class Renderer final : public ::Renderer
 {
 public:
@@ -35,17 +39,21 @@ public:
                                                    const void* cache_data = nullptr,
                                                    size_t cache_data_length = 0) override;
 
-  u32 AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data) override { return 0; }
-  void PokeEFB(EFBAccessType type, const EfbPokeData* points, size_t num_points) override {}
+  u32 AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data) override;
+  void PokeEFB(EFBAccessType type, const EfbPokeData* points, size_t num_points) override;
 
   void ClearScreen(const MathUtil::Rectangle<int>& rc, bool colorEnable, bool alphaEnable,
-                   bool zEnable, u32 color, u32 z) override
-  {
-  }
+                   bool zEnable, u32 color, u32 z) override;
 
   void ReinterpretPixelData(EFBReinterpretType convtype) override {}
 
+  // Only present in analysis mode.
+  ApproximateEFB* GetApproximateEFB() const { return m_approximate_efb.get(); }
+
 protected:
   std::unique_ptr<BoundingBox> CreateBoundingBox() const override;
+
+private:
+  std::unique_ptr<ApproximateEFB> m_approximate_efb;
 };
 }  // namespace Null
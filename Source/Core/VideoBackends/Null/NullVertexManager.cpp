@@ -3,6 +3,15 @@
 
 #include "VideoBackends/Null/NullVertexManager.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "VideoBackends/Null/ApproximateEFB.h"
+#include "VideoBackends/Null/NullRender.h"
+
+#include "VideoCommon/BPFunctions.h"
+#include "VideoCommon/VideoConfig.h"
+
 namespace Null
 {
 VertexManager::VertexManager() = default;
@@ -11,6 +20,22 @@ VertexManager::~VertexManager() = default;
 
 void VertexManager::DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_vertex)
 {
+  if (!g_ActiveConfig.bBBoxEnable || !g_renderer->IsBBoxEnabled())
+    return;
+
+  ApproximateEFB* approximate_efb = static_cast<Renderer*>(g_renderer.get())->GetApproximateEFB();
+  if (!approximate_efb)
+    return;
+
+  // Without rasterizing, assume the draw covers the whole part of the viewport that passes the
+  // scissor test.
+  const BPFunctions::ScissorResult scissor = BPFunctions::ComputeScissorRects();
+  MathUtil::Rectangle<int> rect = scissor.Best().rect;
+  rect.left = std::max(rect.left, static_cast<int>(std::floor(scissor.viewport_left)));
+  rect.right = std::min(rect.right, static_cast<int>(std::ceil(scissor.viewport_right)));
+  rect.top = std::max(rect.top, static_cast<int>(std::floor(scissor.viewport_top)));
+  rect.bottom = std::min(rect.bottom, static_cast<int>(std::ceil(scissor.viewport_bottom)));
+  approximate_efb->IncludeInBoundingBox(rect);
 }
 
 }  // namespace Null
@@ -0,0 +1,40 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoBackends/Null/TextureCache.h"
+
+#include <cstring>
+
+#include "VideoBackends/Null/ApproximateEFB.h"
+#include "VideoBackends/Null/NullRender.h"
+
+#include "VideoCommon/AbstractStagingTexture.h"
+
+namespace Null
+{
+void TextureCache::CopyEFB(AbstractStagingTexture* dst, const EFBCopyParams& params,
+                           u32 native_width, u32 bytes_per_row, u32 num_blocks_y,
+                           u32 memory_stride, const MathUtil::Rectangle<int>& src_rect,
+                           bool scale_by_half, bool linear_filter, float y_scale, float gamma,
+                           bool clamp_top, bool clamp_bottom,
+                           const EFBCopyFilterCoefficients& filter_coefficients)
+{
+  const ApproximateEFB* approximate_efb =
+      static_cast<Renderer*>(g_renderer.get())->GetApproximateEFB();
+  if (!approximate_efb || !dst->IsMapped())
+    return;
+
+  u8* dst_ptr = reinterpret_cast<u8*>(dst->GetMappedPointer());
+  const size_t dst_stride = dst->GetMappedStride();
+  if (params.copy_format == EFBCopyFormat::XFB)
+  {
+    approximate_efb->EncodeXFB(dst_ptr, dst_stride, native_width, num_blocks_y, src_rect);
+    return;
+  }
+
+  // Texture copies aren't encoded, but they are cleared so that results stay deterministic
+  // regardless of which staging texture was reused.
+  for (u32 row = 0; row < num_blocks_y; row++)
+    std::memset(dst_ptr + row * dst_stride, 0, bytes_per_row);
+}
+}  // namespace Null
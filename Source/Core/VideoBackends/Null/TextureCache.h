@@ -14,9 +14,7 @@ protected:
                u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
                const MathUtil::Rectangle<int>& src_rect, bool scale_by_half, bool linear_filter,
                float y_scale, float gamma, bool clamp_top, bool clamp_bottom,
-               const EFBCopyFilterCoefficients& filter_coefficients) override
-  {
-  }
+               const EFBCopyFilterCoefficients& filter_coefficients) override;
 
   void CopyEFBToCacheEntry(TCacheEntry* entry, bool is_depth_copy,
                            const MathUtil::Rectangle<int>& src_rect, bool scale_by_half,
@@ -8,6 +8,7 @@
 #include "Common/Assert.h"
 #include "Common/Logging/Log.h"
 #include "Common/Thread.h"
+#include "Common/Trace.h"
 
 namespace VideoCommon
 {
@@ -228,7 +229,12 @@ void AsyncShaderCompiler::WorkerThreadRun()
       m_pending_work.erase(iter);
       pending_lock.unlock();
 
-      if (item->Compile())
+      bool compiled;
+      {
+        TRACE_SCOPE("AsyncShaderCompiler::Compile");
+        compiled = item->Compile();
+      }
+      if (compiled)
       {
         std::lock_guard<std::mutex> completed_guard(m_completed_work_lock);
         m_completed_work.push_back(std::move(item));
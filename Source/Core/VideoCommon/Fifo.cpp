@@ -13,6 +13,7 @@
 #include "Common/FPURoundMode.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/Trace.h"
 
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
@@ -331,6 +332,8 @@ void RunGpuLoop()
         if (!s_emu_running_state.IsSet())
           return;
 
+        TRACE_SCOPE("Fifo::RunGpuLoop");
+
         if (s_use_deterministic_gpu_thread)
         {
           // All the fifo/CP stuff is on the CPU.  We just need to run the opcode decoder.
@@ -0,0 +1,55 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/FrameReport.h"
+
+#include <utility>
+
+#include <xxhash.h>
+
+#include "Common/Timer.h"
+#include "Core/HW/Memmap.h"
+
+namespace FrameReport
+{
+static Callback s_callback;
+static u64 s_last_frame_time = 0;
+
+void SetCallback(Callback callback)
+{
+  s_callback = std::move(callback);
+  s_last_frame_time = 0;
+}
+
+bool IsEnabled()
+{
+  return static_cast<bool>(s_callback);
+}
+
+void OnFramePresented(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u64 frame_number)
+{
+  if (!s_callback)
+    return;
+
+  const u64 now = Common::Timer::GetTimeUs();
+
+  Frame frame;
+  frame.frame_number = frame_number;
+  frame.xfb_addr = xfb_addr;
+  frame.xfb_width = fb_width;
+  frame.xfb_stride = fb_stride;
+  frame.xfb_height = fb_height;
+  frame.frame_time_us = s_last_frame_time != 0 ? now - s_last_frame_time : 0;
+  frame.stats = g_stats.this_frame;
+
+  // The XFB is hashed as it is stored in guest memory, so this is only meaningful when XFB copies
+  // are written back to RAM. XXH64 is used rather than Common::GetHash64 so that hashes do not
+  // depend on the host CPU's features and can be compared across machines.
+  const u32 xfb_size = fb_stride * fb_height;
+  const u8* xfb_ptr = Memory::GetPointerForRange(xfb_addr, xfb_size);
+  frame.xfb_hash = xfb_ptr ? XXH64(xfb_ptr, xfb_size, 0) : 0;
+
+  s_last_frame_time = now;
+  s_callback(frame);
+}
+}  // namespace FrameReport
@@ -0,0 +1,40 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/Statistics.h"
+
+// Optional per-frame observer for headless tooling (e.g. FIFO log regression runs). When a
+// callback is installed, every presented (non-duplicate) frame is reported with a hash of the XFB
+// in guest memory and a copy of that frame's statistics.
+namespace FrameReport
+{
+struct Frame
+{
+  u64 frame_number;
+
+  u32 xfb_addr;
+  u32 xfb_width;
+  u32 xfb_stride;
+  u32 xfb_height;
+  u64 xfb_hash;
+
+  // Host time elapsed since the previously reported frame, 0 for the first frame.
+  u64 frame_time_us;
+
+  Statistics::ThisFrame stats;
+};
+
+using Callback = std::function<void(const Frame&)>;
+
+// Should only be changed while the core is not running.
+void SetCallback(Callback callback);
+bool IsEnabled();
+
+// Called by the renderer on the GPU thread, before the per-frame statistics are reset.
+void OnFramePresented(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u64 frame_number);
+}  // namespace FrameReport
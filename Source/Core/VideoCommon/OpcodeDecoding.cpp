@@ -14,6 +14,13 @@
 
 #include "VideoCommon/OpcodeDecoding.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+#include <fmt/format.h>
+
 #include "Common/Assert.h"
 #include "Common/Logging/Log.h"
 #include "Core/FifoPlayer/FifoRecorder.h"
@@ -33,6 +40,68 @@
 namespace OpcodeDecoder
 {
 bool g_record_fifo_data = false;
+bool g_profile_commands = false;
+
+static std::unordered_map<u32, u64> s_sequence_counts;
+static CommandKey s_last_command_key = 0;
+static u64 s_num_commands = 0;
+static u64 s_num_batched_draws = 0;
+
+// Scratch space for merged draws; only used by the non-preprocess decoder on the GPU thread.
+static std::vector<u8> s_draw_batch_buffer;
+
+static CommandKey GetCommandKey(const u8* data)
+{
+  const u8 opcode = data[0];
+  u8 reg = 0;
+  switch (static_cast<Opcode>(opcode))
+  {
+  case Opcode::GX_LOAD_BP_REG:
+  case Opcode::GX_LOAD_CP_REG:
+    reg = data[1];
+    break;
+  case Opcode::GX_LOAD_XF_REG:
+  {
+    // XF memory (matrices, lights) is lumped together, XF registers are kept apart.
+    const u16 address = Common::swap32(&data[1]) & 0xffff;
+    if (address >= XFMEM_REGISTERS_START)
+      reg = static_cast<u8>(address & 0xff);
+    break;
+  }
+  default:
+    break;
+  }
+  return static_cast<CommandKey>((opcode << 8) | reg);
+}
+
+static void ProfileCommand(const u8* data)
+{
+  const CommandKey key = GetCommandKey(data);
+  if (s_num_commands != 0)
+    s_sequence_counts[(static_cast<u32>(s_last_command_key) << 16) | key]++;
+  s_last_command_key = key;
+  s_num_commands++;
+}
+
+// Primitives that are plain lists can be concatenated without changing what is drawn, as long as
+// each command holds whole primitives.
+static u32 GetListPrimitiveSize(Primitive primitive)
+{
+  switch (primitive)
+  {
+  case Primitive::GX_DRAW_QUADS:
+  case Primitive::GX_DRAW_QUADS_2:
+    return 4;
+  case Primitive::GX_DRAW_TRIANGLES:
+    return 3;
+  case Primitive::GX_DRAW_LINES:
+    return 2;
+  case Primitive::GX_DRAW_POINTS:
+    return 1;
+  default:
+    return 0;
+  }
+}
 
 template <bool is_preprocess>
 class RunCallback final : public Callback
@@ -113,6 +182,108 @@ public:
     else
       LoadIndexedXF(array, index, address, size);
   }
+  // Like Run, but merges runs of draws outside of preprocessing.
+  u32 RunCommands(const u8* data, u32 available)
+  {
+    if constexpr (is_preprocess)
+    {
+      return Run(data, available, *this);
+    }
+    else
+    {
+      u32 size = 0;
+      while (size < available)
+      {
+        u32 command_size = RunDrawBatch(&data[size], available - size);
+        if (command_size == 0)
+          command_size = RunCommand(&data[size], available - size, *this);
+        if (command_size == 0)
+          break;
+        size += command_size;
+      }
+      return size;
+    }
+  }
+
+  // Sprites, text and particles are often drawn with long runs of small draw commands that share a
+  // primitive type and vertex format. For list primitives, such a run is copied together and
+  // submitted to the vertex loader as a single draw, which saves a trip through the vertex loader
+  // and vertex manager per command. Returns the number of bytes consumed, or 0 if the command at
+  // data does not start a run of at least two mergeable draws.
+  u32 RunDrawBatch(const u8* data, u32 available)
+  {
+    const u8 opcode = data[0];
+    if (opcode < static_cast<u8>(Opcode::GX_PRIMITIVE_START) ||
+        opcode > static_cast<u8>(Opcode::GX_PRIMITIVE_END))
+    {
+      return 0;
+    }
+
+    const Primitive primitive =
+        static_cast<Primitive>((opcode & GX_PRIMITIVE_MASK) >> GX_PRIMITIVE_SHIFT);
+    const u32 primitive_size = GetListPrimitiveSize(primitive);
+    if (primitive_size == 0)
+      return 0;
+
+    // Vertices with an indexed position can be skipped by the vertex loader, which would shift the
+    // following primitives if the commands were merged.
+    const CPState& state = GetCPState();
+    if (IsIndexed(state.vtx_desc.low.Position))
+      return 0;
+
+    const u8 vat = opcode & GX_VAT_MASK;
+    const u32 vertex_size = VertexLoaderBase::GetVertexSize(state.vtx_desc, state.vtx_attr[vat]);
+
+    u32 size = 0;
+    u32 num_commands = 0;
+    u32 num_vertices = 0;
+    while (size + 3 <= available && data[size] == opcode)
+    {
+      const u16 command_vertices = Common::swap16(&data[size + 1]);
+      const u32 command_size = 3 + command_vertices * vertex_size;
+      if (size + command_size > available || command_vertices % primitive_size != 0 ||
+          num_vertices + command_vertices > std::numeric_limits<u16>::max())
+      {
+        break;
+      }
+
+      size += command_size;
+      num_vertices += command_vertices;
+      num_commands++;
+    }
+
+    if (num_commands < 2)
+      return 0;
+
+    s_draw_batch_buffer.resize(num_vertices * vertex_size);
+    u8* dst = s_draw_batch_buffer.data();
+    for (u32 offset = 0; offset < size;)
+    {
+      const u32 command_size = 3 + Common::swap16(&data[offset + 1]) * vertex_size;
+      std::memcpy(dst, &data[offset + 3], command_size - 3);
+      dst += command_size - 3;
+      offset += command_size;
+    }
+
+    OnPrimitiveCommand(primitive, vat, vertex_size, static_cast<u16>(num_vertices),
+                       s_draw_batch_buffer.data());
+
+    // Like for unbatched commands, only report the commands once they have run, so that the FIFO
+    // recorder sees any memory updates they cause in the right place.
+    for (u32 offset = 0; offset < size;)
+    {
+      const u32 command_size = 3 + Common::swap16(&data[offset + 1]) * vertex_size;
+      OnCommand(&data[offset], command_size);
+      offset += command_size;
+    }
+
+    // Keep the cycle estimate identical to submitting the commands one by one.
+    m_cycles += 6 * (num_commands - 1);
+    if (g_profile_commands)
+      s_num_batched_draws += num_commands - 1;
+    return size;
+  }
+
   OPCODE_CALLBACK(void OnPrimitiveCommand(OpcodeDecoder::Primitive primitive, u8 vat,
                                           u32 vertex_size, u16 num_vertices, const u8* vertex_data))
   {
@@ -152,7 +323,7 @@ public:
 
         if (start_address != nullptr)
         {
-          Run(start_address, size, *this);
+          RunCommands(start_address, size);
         }
       }
       else
@@ -170,7 +341,7 @@ public:
           // temporarily swap dl and non-dl (small "hack" for the stats)
           g_stats.SwapDL();
 
-          Run(start_address, size, *this);
+          RunCommands(start_address, size);
           INCSTAT(g_stats.this_frame.num_dlists_called);
 
           // un-swap
@@ -217,6 +388,9 @@ public:
       {
         FifoRecorder::GetInstance().WriteGPCommand(data, size);
       }
+
+      if (g_profile_commands)
+        ProfileCommand(data);
     }
   }
 
@@ -237,7 +411,7 @@ u8* RunFifo(DataReader src, u32* cycles)
 {
   using CallbackT = RunCallback<is_preprocess>;
   auto callback = CallbackT{};
-  u32 size = Run(src.GetPointer(), static_cast<u32>(src.size()), callback);
+  u32 size = callback.RunCommands(src.GetPointer(), static_cast<u32>(src.size()));
 
   if (cycles != nullptr)
     *cycles = callback.m_cycles;
@@ -249,4 +423,67 @@ u8* RunFifo(DataReader src, u32* cycles)
 template u8* RunFifo<true>(DataReader src, u32* cycles);
 template u8* RunFifo<false>(DataReader src, u32* cycles);
 
+CommandProfile GetCommandProfile()
+{
+  CommandProfile profile;
+  profile.num_commands = s_num_commands;
+  profile.num_batched_draws = s_num_batched_draws;
+
+  profile.sequences.reserve(s_sequence_counts.size());
+  for (const auto& [pair, count] : s_sequence_counts)
+  {
+    profile.sequences.push_back(
+        {static_cast<CommandKey>(pair >> 16), static_cast<CommandKey>(pair & 0xffff), count});
+  }
+  std::sort(profile.sequences.begin(), profile.sequences.end(),
+            [](const CommandSequence& a, const CommandSequence& b) { return a.count > b.count; });
+
+  return profile;
+}
+
+void ResetCommandProfile()
+{
+  s_sequence_counts.clear();
+  s_last_command_key = 0;
+  s_num_commands = 0;
+  s_num_batched_draws = 0;
+}
+
+std::string GetCommandKeyName(CommandKey key)
+{
+  const u8 opcode = key >> 8;
+  const u8 reg = key & 0xff;
+
+  if (opcode >= static_cast<u8>(Opcode::GX_PRIMITIVE_START) &&
+      opcode <= static_cast<u8>(Opcode::GX_PRIMITIVE_END))
+  {
+    const auto primitive =
+        static_cast<Primitive>((opcode & GX_PRIMITIVE_MASK) >> GX_PRIMITIVE_SHIFT);
+    return fmt::format("{} VAT {}", primitive, opcode & GX_VAT_MASK);
+  }
+
+  switch (static_cast<Opcode>(opcode))
+  {
+  case Opcode::GX_NOP:
+    return "NOP";
+  case Opcode::GX_LOAD_BP_REG:
+    return fmt::format("BP {:02x}", reg);
+  case Opcode::GX_LOAD_CP_REG:
+    return fmt::format("CP {:02x}", reg);
+  case Opcode::GX_LOAD_XF_REG:
+    if (reg == 0)
+      return "XF memory";
+    return fmt::format("XF {:04x}", XFMEM_REGISTERS_START + reg);
+  case Opcode::GX_LOAD_INDX_A:
+  case Opcode::GX_LOAD_INDX_B:
+  case Opcode::GX_LOAD_INDX_C:
+  case Opcode::GX_LOAD_INDX_D:
+    return fmt::format("Indexed XF {}", static_cast<char>('A' + (opcode - 0x20) / 8));
+  case Opcode::GX_CMD_CALL_DL:
+    return "Call DL";
+  default:
+    return fmt::format("Opcode {:02x}", opcode);
+  }
+}
+
 }  // namespace OpcodeDecoder
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <string>
 #include <type_traits>
+#include <vector>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
@@ -21,6 +23,9 @@ namespace OpcodeDecoder
 // Global flag to signal if FifoRecorder is active.
 extern bool g_record_fifo_data;
 
+// Global flag to signal if command sequences should be counted; see GetCommandProfile.
+extern bool g_profile_commands;
+
 enum class Opcode
 {
   GX_NOP = 0x00,
@@ -275,6 +280,32 @@ DOLPHIN_FORCE_INLINE u32 Run(const u8* data, u32 available, T& callback)
 template <bool is_preprocess = false>
 u8* RunFifo(DataReader src, u32* cycles);
 
+// Identifies a kind of command: the opcode in the high byte, and for BP/CP/XF register loads the
+// register in the low byte. Draws keep their full opcode, so primitive type and VAT are included.
+using CommandKey = u16;
+
+struct CommandSequence
+{
+  CommandKey first;
+  CommandKey second;
+  u64 count;
+};
+
+struct CommandProfile
+{
+  u64 num_commands = 0;
+  // Draw commands that were merged with the preceding draw instead of being submitted separately.
+  u64 num_batched_draws = 0;
+  // Pairs of consecutive commands, most frequent first.
+  std::vector<CommandSequence> sequences;
+};
+
+// Counts are gathered on the GPU thread while g_profile_commands is set, so these must only be
+// called while it is not running any commands (e.g. after emulation has stopped).
+CommandProfile GetCommandProfile();
+void ResetCommandProfile();
+std::string GetCommandKeyName(CommandKey key);
+
 }  // namespace OpcodeDecoder
 
 template <>
@@ -24,6 +24,8 @@
 #include <fmt/format.h>
 #include <imgui.h>
 
+#include "AudioCommon/AudioCommon.h"
+#include "AudioCommon/Mixer.h"
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -64,6 +66,7 @@
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/FPSCounter.h"
 #include "VideoCommon/FrameDump.h"
+#include "VideoCommon/FrameReport.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/FramebufferShaderGen.h"
 #include "VideoCommon/FreeLookCamera.h"
@@ -615,6 +618,33 @@ void Renderer::DrawDebugText()
     ImGui::End();
   }
 
+  if (Config::Get(Config::MAIN_SHOW_AUDIO_STATS) && g_sound_stream && g_sound_stream->GetMixer())
+  {
+    ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x - (10.0f * m_backbuffer_scale),
+                                   150.0f * m_backbuffer_scale),
+                            ImGuiCond_FirstUseEver, ImVec2(1.0f, 0.0f));
+    if (ImGui::Begin("Audio", nullptr,
+                     ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_AlwaysAutoResize))
+    {
+      const Mixer::Stats stats = g_sound_stream->GetMixer()->GetStats();
+      const auto show_fifo = [](const char* name, const Mixer::FifoStats& fifo) {
+        ImGui::Text("%s: %u Hz, %5.1f ms buffered, %+d ppm", name, fifo.input_sample_rate,
+                    fifo.latency_ms, fifo.drift_ppm);
+        ImGui::Text("  underruns: %" PRIu64 ", overruns: %" PRIu64, fifo.underruns,
+                    fifo.overruns);
+      };
+      show_fifo("DMA", stats.dma);
+      show_fifo("Streaming", stats.streaming);
+      show_fifo("Wii Remote", stats.wiimote_speaker);
+      for (size_t i = 0; i < stats.gba.size(); ++i)
+      {
+        if (stats.gba[i].underruns != 0 || stats.gba[i].buffered_samples != 0)
+          show_fifo(fmt::format("GBA {}", i + 1).c_str(), stats.gba[i]);
+      }
+    }
+    ImGui::End();
+  }
+
   if (g_ActiveConfig.bOverlayStats)
     g_stats.Display();
 
@@ -1381,6 +1411,9 @@ void Renderer::Swap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u6
         if (IsFrameDumping())
           DumpCurrentFrame(xfb_entry->texture.get(), xfb_rect, ticks, m_frame_count);
 
+        if (FrameReport::IsEnabled())
+          FrameReport::OnFramePresented(xfb_addr, fb_width, fb_stride, fb_height, m_frame_count);
+
         // Begin new frame
         m_frame_count++;
         g_stats.ResetFrame();
@@ -71,6 +71,12 @@ void Statistics::Display() const
   draw_statistic("Textures created", "%d", num_textures_created);
   draw_statistic("Textures uploaded", "%d", num_textures_uploaded);
   draw_statistic("Textures alive", "%d", num_textures_alive);
+  draw_statistic("Texture cache hits", "%d (%d by hash)",
+                 this_frame.num_texture_cache_hits + this_frame.num_texture_cache_hash_hits,
+                 this_frame.num_texture_cache_hash_hits);
+  draw_statistic("Texture cache misses", "%d", this_frame.num_texture_cache_misses);
+  draw_statistic("Texture bytes decoded", "%i kB", this_frame.bytes_texture_decoded / 1024);
+  draw_statistic("Texture bytes uploaded", "%i kB", this_frame.bytes_texture_uploaded / 1024);
   draw_statistic("pshaders created", "%d", num_pixel_shaders_created);
   draw_statistic("pshaders alive", "%d", num_pixel_shaders_alive);
   draw_statistic("vshaders created", "%d", num_vertex_shaders_created);
@@ -91,6 +97,9 @@ void Statistics::Display() const
   draw_statistic("Index streamed", "%i kB", this_frame.bytes_index_streamed / 1024);
   draw_statistic("Uniform streamed", "%i kB", this_frame.bytes_uniform_streamed / 1024);
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
+  draw_statistic("Vertex Loaders precompiled", "%d", num_vertex_loaders_precompiled);
+  draw_statistic("Vertex Loaders compiled", "%d (%d us)", this_frame.num_vertex_loaders_compiled,
+                 this_frame.vertex_loader_compile_us);
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
 
@@ -20,6 +20,7 @@ struct Statistics
   int num_textures_alive;
 
   int num_vertex_loaders;
+  int num_vertex_loaders_precompiled;
 
   std::array<float, 6> proj;
   std::array<float, 16> gproj;
@@ -71,6 +72,17 @@ struct Statistics
 
     int num_efb_peeks;
     int num_efb_pokes;
+
+    // Texture cache lookups: found by address, found by content at another address, or decoded.
+    int num_texture_cache_hits;
+    int num_texture_cache_hash_hits;
+    int num_texture_cache_misses;
+    int bytes_texture_decoded;
+    int bytes_texture_uploaded;
+
+    // Loaders compiled on demand, which stall the GPU thread.
+    int num_vertex_loaders_compiled;
+    int vertex_loader_compile_us;
   };
   ThisFrame this_frame;
   void ResetFrame();
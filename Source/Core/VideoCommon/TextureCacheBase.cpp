@@ -7,6 +7,7 @@
 #include <cmath>
 #include <cstring>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -18,6 +19,7 @@
 
 #include "Common/Align.h"
 #include "Common/Assert.h"
+#include "Common/BitUtils.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
@@ -83,7 +85,7 @@ TextureCacheBase::TextureCacheBase()
 {
   SetBackupConfig(g_ActiveConfig);
 
-  temp_size = 2048 * 2048 * 4;
+  temp_size = TEMP_BUFFER_SIZE;
   temp = static_cast<u8*>(Common::AllocateAlignedMemory(temp_size, 16));
 
   TexDecoder_SetTexFmtOverlayOptions(backup_config.texfmt_overlay,
@@ -230,6 +232,103 @@ void TextureCacheBase::Cleanup(int _frameCount)
       ++iter2;
     }
   }
+
+  if (g_ActiveConfig.iTextureCacheMemoryBudget > 0)
+    EnforceMemoryBudget(_frameCount);
+}
+
+static size_t GetTextureMemorySize(const TextureConfig& config)
+{
+  const bool compressed = AbstractTexture::IsCompressedFormat(config.format);
+  size_t size = 0;
+  for (u32 level = 0; level < config.levels; level++)
+  {
+    const u32 height = std::max(config.height >> level, 1u);
+    const size_t rows = compressed ? (height + 3) / 4 : height;
+    size += config.GetMipStride(level) * rows;
+  }
+  return size * config.layers * config.samples;
+}
+
+void TextureCacheBase::EnforceMemoryBudget(int frame_count)
+{
+  const size_t budget = static_cast<size_t>(g_ActiveConfig.iTextureCacheMemoryBudget) << 20;
+
+  // Host memory held for texture work counts as well: the decoding buffer, and the staging
+  // textures EFB copies are read back through.
+  size_t host_size = temp_size;
+  size_t staging_pool_size = 0;
+  for (const auto& staging_texture : m_efb_copy_staging_texture_pool)
+    staging_pool_size += GetTextureMemorySize(staging_texture->GetConfig());
+  for (const TCacheEntry* entry : m_pending_efb_copies)
+  {
+    if (entry->pending_efb_copy)
+      host_size += GetTextureMemorySize(entry->pending_efb_copy->GetConfig());
+  }
+  if (m_readback_texture)
+    host_size += GetTextureMemorySize(m_readback_texture->GetConfig());
+
+  size_t entries_size = 0;
+  std::vector<TCacheEntry*> candidates;
+  for (const auto& it : textures_by_address)
+  {
+    TCacheEntry* entry = it.second;
+    entries_size += GetTextureMemorySize(entry->texture->GetConfig());
+
+    // EFB copies may only exist on the host GPU, so they can't be recreated from guest memory.
+    // Entries used this frame may still be bound.
+    if (!entry->IsCopy() && !entry->tmem_only && entry->frameCount != FRAMECOUNT_INVALID &&
+        entry->frameCount < frame_count)
+    {
+      candidates.push_back(entry);
+    }
+  }
+
+  size_t pool_size = 0;
+  for (const auto& it : texture_pool)
+    pool_size += GetTextureMemorySize(it.second.texture->GetConfig());
+
+  if (host_size + staging_pool_size + entries_size + pool_size <= budget)
+    return;
+
+  // Unused staging textures are simply allocated again when needed, and the decoding buffer grows
+  // back to the size of the largest texture decoded after this.
+  m_efb_copy_staging_texture_pool.clear();
+  if (temp_size > TEMP_BUFFER_SIZE)
+  {
+    host_size -= temp_size - TEMP_BUFFER_SIZE;
+    temp_size = TEMP_BUFFER_SIZE;
+    Common::FreeAlignedMemory(temp);
+    temp = static_cast<u8*>(Common::AllocateAlignedMemory(temp_size, 16));
+  }
+
+  // What is left of the budget after the host memory which can't be freed
+  const size_t texture_budget = budget > host_size ? budget - host_size : 0;
+
+  // Evict the least recently used entries. Their textures are returned to the pool, which is
+  // trimmed afterwards.
+  std::sort(candidates.begin(), candidates.end(), [](const TCacheEntry* a, const TCacheEntry* b) {
+    return a->frameCount < b->frameCount;
+  });
+  for (TCacheEntry* entry : candidates)
+  {
+    if (entries_size <= texture_budget)
+      break;
+
+    const size_t size = GetTextureMemorySize(entry->texture->GetConfig());
+    InvalidateTexture(GetTexCacheIter(entry));
+    entries_size -= size;
+    pool_size += size;
+  }
+
+  for (auto iter = texture_pool.begin(); iter != texture_pool.end();)
+  {
+    if (entries_size + pool_size <= texture_budget)
+      break;
+
+    pool_size -= GetTextureMemorySize(iter->second.texture->GetConfig());
+    iter = texture_pool.erase(iter);
+  }
 }
 
 bool TextureCacheBase::TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 range_size) const
@@ -1244,6 +1343,38 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
   return entry;
 }
 
+// Returns a hash of all the data a texture is decoded from, mipmaps included, so that it can be
+// shared with identical textures at other addresses. full_hash is reused if it already covers the
+// whole top level and palette, which it doesn't when only samples of them were hashed.
+static std::optional<u64> CalculateContentHash(const TextureInfo& texture_info, u64 full_hash,
+                                               int color_samples)
+{
+  // The hash of RGBA8 textures preloaded into tmem doesn't cover their GB tiles
+  if (texture_info.IsFromTmem() && texture_info.GetTextureFormat() == TextureFormat::RGBA8)
+    return std::nullopt;
+
+  const u32 palette_size = texture_info.GetPaletteSize().value_or(0);
+  u64 hash = full_hash;
+  if (color_samples != 0 &&
+      std::max(texture_info.GetTextureSize(), palette_size) > static_cast<u32>(color_samples) * 8)
+  {
+    hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(), 0);
+    if (palette_size != 0)
+      hash ^= Common::GetHash64(texture_info.GetTlutAddress(), palette_size, 0);
+  }
+
+  for (u32 level = 1; level < texture_info.GetLevelCount(); ++level)
+  {
+    const TextureInfo::MipLevel* mip_level = texture_info.GetMipMapLevel(level - 1);
+    if (mip_level)
+    {
+      hash = Common::RotateLeft(hash, 1) ^
+             Common::GetHash64(mip_level->GetData(), mip_level->GetTextureSize(), 0);
+    }
+  }
+  return hash;
+}
+
 TextureCacheBase::TCacheEntry*
 TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, TextureInfo& texture_info)
 {
@@ -1290,10 +1421,8 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
   // from the low tmem bank than it should)
   base_hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
                                 textureCacheSafetyColorSampleSize);
-  u32 palette_size = 0;
   if (texture_info.GetPaletteSize())
   {
-    palette_size = *texture_info.GetPaletteSize();
     full_hash =
         base_hash ^ Common::GetHash64(texture_info.GetTlutAddress(), *texture_info.GetPaletteSize(),
                                       textureCacheSafetyColorSampleSize);
@@ -1398,7 +1527,10 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
         // TODO: We should check width/height/levels for EFB copies. I'm not sure what effect
         // checking width/height/levels would have.
         if (!texture_info.GetPaletteSize() || !g_Config.backend_info.bSupportsPaletteConversion)
+        {
+          INCSTAT(g_stats.this_frame.num_texture_cache_hits);
           return entry;
+        }
 
         // Note that we found an unconverted EFB copy, then continue.  We'll
         // perform the conversion later.  Currently, we only convert EFB copies to
@@ -1424,6 +1556,7 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
           entry->native_width == texture_info.GetRawWidth() &&
           entry->native_height == texture_info.GetRawHeight())
       {
+        INCSTAT(g_stats.this_frame.num_texture_cache_hits);
         entry = DoPartialTextureUpdates(iter->second, texture_info.GetTlutAddress(),
                                         texture_info.GetTlutFormat());
         entry->texture->FinishedRendering();
@@ -1472,17 +1605,17 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
     }
   }
 
-  // Search the texture cache for normal textures by hash
+  // Search the texture cache for normal textures by content
   //
-  // If the texture was fully hashed, the address does not need to match. Identical duplicate
-  // textures cause unnecessary slowdowns
+  // If the contents match, the address does not need to. Identical duplicate textures cause
+  // unnecessary slowdowns
   // Example: Tales of Symphonia (GC) uses over 500 small textures in menus, but only around 70
   // different ones
-  if (textureCacheSafetyColorSampleSize == 0 ||
-      std::max(texture_info.GetTextureSize(), palette_size) <=
-          (u32)textureCacheSafetyColorSampleSize * 8)
+  const std::optional<u64> content_hash =
+      CalculateContentHash(texture_info, full_hash, textureCacheSafetyColorSampleSize);
+  if (content_hash)
   {
-    auto hash_range = textures_by_hash.equal_range(full_hash);
+    auto hash_range = textures_by_hash.equal_range(*content_hash);
     TexHashCache::iterator hash_iter = hash_range.first;
     while (hash_iter != hash_range.second)
     {
@@ -1492,6 +1625,7 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
           entry->native_width == texture_info.GetRawWidth() &&
           entry->native_height == texture_info.GetRawHeight())
       {
+        INCSTAT(g_stats.this_frame.num_texture_cache_hash_hits);
         entry = DoPartialTextureUpdates(hash_iter->second, texture_info.GetTlutAddress(),
                                         texture_info.GetTlutFormat());
         entry->texture->FinishedRendering();
@@ -1508,6 +1642,8 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
     InvalidateTexture(oldest_entry);
   }
 
+  INCSTAT(g_stats.this_frame.num_texture_cache_misses);
+
   std::shared_ptr<HiresTexture> hires_tex;
   if (g_ActiveConfig.bHiresTextures)
   {
@@ -1551,6 +1687,7 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
     const auto& level = hires_tex->m_levels[0];
     entry->texture->Load(0, level.width, level.height, level.row_length, level.data.data(),
                          level.data.size());
+    ADDSTAT(g_stats.this_frame.bytes_texture_uploaded, level.data.size());
   }
 
   // Initialized to null because only software loading uses this buffer
@@ -1599,6 +1736,8 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
       }
 
       entry->texture->Load(0, width, height, expanded_width, dst_buffer, decoded_texture_size);
+      ADDSTAT(g_stats.this_frame.bytes_texture_decoded, decoded_texture_size);
+      ADDSTAT(g_stats.this_frame.bytes_texture_uploaded, decoded_texture_size);
 
       arbitrary_mip_detector.AddLevel(width, height, expanded_width, dst_buffer);
 
@@ -1607,12 +1746,8 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
   }
 
   iter = textures_by_address.emplace(texture_info.GetRawAddress(), entry);
-  if (textureCacheSafetyColorSampleSize == 0 ||
-      std::max(texture_info.GetTextureSize(), palette_size) <=
-          (u32)textureCacheSafetyColorSampleSize * 8)
-  {
-    entry->textures_by_hash_iter = textures_by_hash.emplace(full_hash, entry);
-  }
+  if (content_hash)
+    entry->textures_by_hash_iter = textures_by_hash.emplace(*content_hash, entry);
 
   entry->SetGeneralParameters(texture_info.GetRawAddress(), texture_info.GetTextureSize(),
                               full_format, false);
@@ -1636,6 +1771,7 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
       const auto& level = hires_tex->m_levels[level_index];
       entry->texture->Load(level_index, level.width, level.height, level.row_length,
                            level.data.data(), level.data.size());
+      ADDSTAT(g_stats.this_frame.bytes_texture_uploaded, level.data.size());
     }
   }
   else
@@ -1662,6 +1798,8 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
                           texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
         entry->texture->Load(level, mip_level->GetRawWidth(), mip_level->GetRawHeight(),
                              mip_level->GetExpandedWidth(), dst_buffer, decoded_mip_size);
+        ADDSTAT(g_stats.this_frame.bytes_texture_decoded, decoded_mip_size);
+        ADDSTAT(g_stats.this_frame.bytes_texture_uploaded, decoded_mip_size);
 
         arbitrary_mip_detector.AddLevel(mip_level->GetRawWidth(), mip_level->GetRawHeight(),
                                         mip_level->GetExpandedWidth(), dst_buffer);
@@ -2834,6 +2972,8 @@ bool TextureCacheBase::DecodeTextureOnGPU(TCacheEntry* entry, u32 dst_level, con
     if (!g_vertex_manager->UploadTexelBuffer(data, data_size, info->buffer_format, &src_offset))
       return false;
   }
+  ADDSTAT(g_stats.this_frame.bytes_texture_decoded, aligned_width * aligned_height * sizeof(u32));
+  ADDSTAT(g_stats.this_frame.bytes_texture_uploaded, data_size + info->palette_size);
 
   // Set up uniforms.
   struct Uniforms
@@ -230,7 +230,9 @@ public:
   void ForceReload();
 
   // Removes textures which aren't used for more than TEXTURE_KILL_THRESHOLD frames,
-  // frameCount is the current frame number.
+  // frameCount is the current frame number. If a texture memory budget is configured, the least
+  // recently used textures are then removed until the cache and the host memory used for
+  // decoding and EFB copy readback fit in it.
   void Cleanup(int _frameCount);
 
   void Invalidate();
@@ -285,6 +287,9 @@ protected:
                                    float gamma, bool clamp_top, bool clamp_bottom,
                                    const EFBCopyFilterCoefficients& filter_coefficients);
 
+  // The size the decoding buffer starts out with. It grows for larger textures.
+  static constexpr size_t TEMP_BUFFER_SIZE = 2048 * 2048 * 4;
+
   alignas(16) u8* temp = nullptr;
   size_t temp_size = 0;
 
@@ -317,6 +322,7 @@ private:
   std::optional<TexPoolEntry> AllocateTexture(const TextureConfig& config);
   TexPool::iterator FindMatchingTextureFromPool(const TextureConfig& config);
   TexAddrCache::iterator GetTexCacheIter(TCacheEntry* entry);
+  void EnforceMemoryBudget(int frame_count);
 
   // Return all possible overlapping textures. As addr+size of the textures is not
   // indexed, this may return false positives.
@@ -351,6 +357,8 @@ private:
   void DoLoadState(PointerWrap& p);
 
   TexAddrCache textures_by_address;
+  // Normal textures by a hash of all of their contents, so that duplicates at different addresses
+  // share one entry.
   TexHashCache textures_by_hash;
   TexPool texture_pool;
   u64 last_entry_id = 0;
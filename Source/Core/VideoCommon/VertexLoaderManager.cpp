@@ -8,14 +8,22 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
+#include "Common/FileUtil.h"
+#include "Common/Flag.h"
+#include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+#include "Common/Timer.h"
 
+#include "Core/ConfigManager.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/Memmap.h"
 
@@ -29,6 +37,7 @@
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 
 namespace VertexLoaderManager
@@ -49,6 +58,25 @@ static std::mutex s_vertex_loader_map_lock;
 static VertexLoaderMap s_vertex_loader_map;
 // TODO - change into array of pointers. Keep a map of all seen so far.
 
+// The vertex formats a game uses are recorded on disk, so that the next time it boots their
+// loaders can be compiled on a background thread instead of in the middle of a frame.
+constexpr u32 UID_CACHE_FILE_MAGIC = 0x44494C56;  // VLID
+constexpr u32 UID_CACHE_FILE_VERSION = 1;
+
+struct SerializedVertexLoaderUID
+{
+  u32 vtx_desc_low;
+  u32 vtx_desc_high;
+  u32 vat_g0;
+  u32 vat_g1;
+  u32 vat_g2;
+};
+static_assert(std::is_trivially_copyable_v<SerializedVertexLoaderUID>);
+
+static File::IOFile s_uid_cache_file;
+static std::thread s_precompile_thread;
+static Common::Flag s_precompile_stop;
+
 Common::EnumMap<u8*, CPArray::TexCoord7> cached_arraybases;
 
 BitSet8 g_main_vat_dirty;
@@ -66,15 +94,133 @@ void Init()
   for (auto& map_entry : g_preprocess_vertex_loaders)
     map_entry = nullptr;
   SETSTAT(g_stats.num_vertex_loaders, 0);
+  SETSTAT(g_stats.num_vertex_loaders_precompiled, 0);
 }
 
 void Clear()
 {
+  if (s_precompile_thread.joinable())
+  {
+    s_precompile_stop.Set();
+    s_precompile_thread.join();
+  }
+
   std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+  s_uid_cache_file.Close();
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
 }
 
+// Must be called with s_vertex_loader_map_lock held.
+static void AppendVertexLoaderUID(const TVtxDesc& vtx_desc, const VAT& vtx_attr)
+{
+  if (!s_uid_cache_file.IsOpen())
+    return;
+
+  const SerializedVertexLoaderUID uid = {vtx_desc.low.Hex, vtx_desc.high.Hex, vtx_attr.g0.Hex,
+                                         vtx_attr.g1.Hex, vtx_attr.g2.Hex};
+  if (!s_uid_cache_file.WriteBytes(&uid, sizeof(uid)))
+  {
+    WARN_LOG_FMT(VIDEO, "Writing vertex loader UID to cache failed, closing file.");
+    s_uid_cache_file.Close();
+  }
+}
+
+static void PrecompileVertexLoaders(std::vector<SerializedVertexLoaderUID> uids)
+{
+  Common::SetCurrentThreadName("Vertex loader precompiler");
+
+  const u64 start_time = Common::Timer::GetTimeUs();
+  size_t num_compiled = 0;
+  for (const SerializedVertexLoaderUID& serialized_uid : uids)
+  {
+    if (s_precompile_stop.IsSet())
+      break;
+
+    TVtxDesc vtx_desc;
+    vtx_desc.low.Hex = serialized_uid.vtx_desc_low;
+    vtx_desc.high.Hex = serialized_uid.vtx_desc_high;
+    VAT vtx_attr;
+    vtx_attr.g0.Hex = serialized_uid.vat_g0;
+    vtx_attr.g1.Hex = serialized_uid.vat_g1;
+    vtx_attr.g2.Hex = serialized_uid.vat_g2;
+
+    const VertexLoaderUID uid(vtx_desc, vtx_attr);
+    {
+      std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+      if (s_vertex_loader_map.find(uid) != s_vertex_loader_map.end())
+        continue;
+    }
+
+    // Compile without holding the lock, so that the GPU thread is not held up. If it needed the
+    // same loader in the meantime, it will have created its own and this one is discarded.
+    std::unique_ptr<VertexLoaderBase> loader =
+        VertexLoaderBase::CreateVertexLoader(vtx_desc, vtx_attr);
+
+    std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+    if (s_vertex_loader_map.emplace(uid, std::move(loader)).second)
+    {
+      INCSTAT(g_stats.num_vertex_loaders);
+      INCSTAT(g_stats.num_vertex_loaders_precompiled);
+      num_compiled++;
+    }
+  }
+
+  INFO_LOG_FMT(VIDEO, "Precompiled {} of {} cached vertex loaders in {} ms", num_compiled,
+               uids.size(), (Common::Timer::GetTimeUs() - start_time) / 1000);
+}
+
+void LoadVertexLoaderUIDCache()
+{
+  if (!g_ActiveConfig.bShaderCache)
+    return;
+
+  constexpr size_t CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
+  const std::string filename =
+      File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".vtxuidcache";
+
+  std::vector<SerializedVertexLoaderUID> uids;
+  if (s_uid_cache_file.Open(filename, "rb+"))
+  {
+    u32 existing_magic;
+    u32 existing_version;
+    bool uid_file_valid = false;
+    if (s_uid_cache_file.ReadBytes(&existing_magic, sizeof(existing_magic)) &&
+        s_uid_cache_file.ReadBytes(&existing_version, sizeof(existing_version)) &&
+        existing_magic == UID_CACHE_FILE_MAGIC && existing_version == UID_CACHE_FILE_VERSION)
+    {
+      // A truncated trailing entry (e.g. after a crash) is dropped rather than rejecting the file.
+      const u64 file_size = s_uid_cache_file.GetSize();
+      const size_t uid_count =
+          static_cast<size_t>(file_size - CACHE_HEADER_SIZE) / sizeof(SerializedVertexLoaderUID);
+      uids.resize(uid_count);
+      uid_file_valid =
+          s_uid_cache_file.ReadArray(uids.data(), uid_count) &&
+          s_uid_cache_file.Seek(CACHE_HEADER_SIZE + uid_count * sizeof(SerializedVertexLoaderUID),
+                                File::SeekOrigin::Begin);
+    }
+
+    if (!uid_file_valid)
+    {
+      uids.clear();
+      s_uid_cache_file.Close();
+    }
+  }
+
+  if (!s_uid_cache_file.IsOpen() && s_uid_cache_file.Open(filename, "wb"))
+  {
+    s_uid_cache_file.WriteBytes(&UID_CACHE_FILE_MAGIC, sizeof(UID_CACHE_FILE_MAGIC));
+    s_uid_cache_file.WriteBytes(&UID_CACHE_FILE_VERSION, sizeof(UID_CACHE_FILE_VERSION));
+  }
+
+  INFO_LOG_FMT(VIDEO, "Read {} vertex loader UIDs from {}", uids.size(), filename);
+  if (uids.empty())
+    return;
+
+  s_precompile_stop.Clear();
+  s_precompile_thread = std::thread(PrecompileVertexLoaders, std::move(uids));
+}
+
 void UpdateVertexArrayPointers()
 {
   // Anything to update?
@@ -222,10 +368,16 @@ static VertexLoaderBase* RefreshLoader(int vtx_attr_group, bool preprocess = fal
     }
     else
     {
+      const u64 start_time = Common::Timer::GetTimeUs();
       s_vertex_loader_map[uid] =
           VertexLoaderBase::CreateVertexLoader(state->vtx_desc, state->vtx_attr[vtx_attr_group]);
       loader = s_vertex_loader_map[uid].get();
       INCSTAT(g_stats.num_vertex_loaders);
+      INCSTAT(g_stats.this_frame.num_vertex_loaders_compiled);
+      ADDSTAT(g_stats.this_frame.vertex_loader_compile_us,
+              Common::Timer::GetTimeUs() - start_time);
+
+      AppendVertexLoaderUID(state->vtx_desc, state->vtx_attr[vtx_attr_group]);
     }
     if (check_for_native_format)
     {
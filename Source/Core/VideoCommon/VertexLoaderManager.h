@@ -29,6 +29,10 @@ using NativeVertexFormatMap =
 void Init();
 void Clear();
 
+// Opens the per-game vertex loader UID cache, and starts compiling the loaders listed in it on a
+// background thread. Does nothing unless the shader cache is enabled.
+void LoadVertexLoaderUIDCache();
+
 void MarkAllDirty();
 
 // Creates or obtains a pointer to a VertexFormat representing decl.
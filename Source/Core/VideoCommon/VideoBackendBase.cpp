@@ -318,6 +318,8 @@ void VideoBackendBase::InitializeShared()
 
   g_Config.VerifyValidity();
   UpdateActiveConfig();
+
+  VertexLoaderManager::LoadVertexLoaderUIDCache();
 }
 
 void VideoBackendBase::ShutdownShared()
@@ -61,6 +61,7 @@ void VideoConfig::Refresh()
   suggested_aspect_mode = Config::Get(Config::GFX_SUGGESTED_ASPECT_RATIO);
   bCrop = Config::Get(Config::GFX_CROP);
   iSafeTextureCache_ColorSamples = Config::Get(Config::GFX_SAFE_TEXTURE_CACHE_COLOR_SAMPLES);
+  iTextureCacheMemoryBudget = Config::Get(Config::GFX_TEXTURE_CACHE_MEMORY_BUDGET);
   bShowFPS = Config::Get(Config::GFX_SHOW_FPS);
   bShowBatterFielder = Config::Get(Config::GFX_SHOW_BATTER_FIELDER);
   bTrainingModeOverlay = Config::Get(Config::GFX_TRAINING_MODE);
@@ -113,6 +114,8 @@ void VideoConfig::Refresh()
   drawStart = Config::Get(Config::GFX_SW_DRAW_START);
   drawEnd = Config::Get(Config::GFX_SW_DRAW_END);
 
+  bNullAnalysisMode = Config::Get(Config::GFX_NULL_ANALYSIS_MODE);
+
   bForceFiltering = Config::Get(Config::GFX_ENHANCE_FORCE_FILTERING);
   iMaxAnisotropy = Config::Get(Config::GFX_ENHANCE_MAX_ANISOTROPY);
   sPostProcessingShader = Config::Get(Config::GFX_ENHANCE_POST_SHADER);
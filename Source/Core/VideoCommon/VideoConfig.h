@@ -131,6 +131,7 @@ struct VideoConfig final
   bool bSkipPresentingDuplicateXFBs = false;
   bool bCopyEFBScaled = false;
   int iSafeTextureCache_ColorSamples = 0;
+  int iTextureCacheMemoryBudget = 0;  // in MiB, 0 = unlimited
   float fAspectRatioHackW = 1;  // Initial value needed for the first frame
   float fAspectRatioHackH = 1;
   bool bEnablePixelLighting = false;
@@ -161,6 +162,9 @@ struct VideoConfig final
   bool bDumpTevStages = false;
   bool bDumpTevTextureFetches = false;
 
+  // VideoNull: approximate EFB peeks, bounding box and XFB copies instead of dropping them
+  bool bNullAnalysisMode = false;
+
   // Enable API validation layers, currently only supported with Vulkan.
   bool bEnableValidationLayer = false;
 
@@ -0,0 +1,71 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FlatHashMap.h"
+
+TEST(FlatHashMap, Simple)
+{
+  Common::FlatHashMap<u32, int> map;
+  EXPECT_TRUE(map.Empty());
+  EXPECT_EQ(nullptr, map.Find(0));
+
+  map[0x80000000] = 1;
+  map[0x80000100] = 2;
+  EXPECT_EQ(2u, map.Size());
+  ASSERT_NE(nullptr, map.Find(0x80000000));
+  EXPECT_EQ(1, *map.Find(0x80000000));
+  EXPECT_EQ(2, map[0x80000100]);
+  EXPECT_EQ(2u, map.Size());
+
+  EXPECT_TRUE(map.Erase(0x80000000));
+  EXPECT_FALSE(map.Erase(0x80000000));
+  EXPECT_EQ(nullptr, map.Find(0x80000000));
+  EXPECT_EQ(1u, map.Size());
+
+  map.Clear();
+  EXPECT_TRUE(map.Empty());
+  EXPECT_EQ(nullptr, map.Find(0x80000100));
+}
+
+TEST(FlatHashMap, MatchesUnorderedMap)
+{
+  Common::FlatHashMap<u32, u32> map;
+  std::unordered_map<u32, u32> reference;
+
+  // A small key space makes for long probe sequences and lots of backward shifting.
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<u32> key_dist(0, 511);
+  for (int i = 0; i < 100000; ++i)
+  {
+    const u32 key = key_dist(rng) * 0x20;
+    if (rng() % 3 == 0)
+    {
+      EXPECT_EQ(reference.erase(key) != 0, map.Erase(key));
+    }
+    else
+    {
+      map[key] = i;
+      reference[key] = i;
+    }
+  }
+
+  EXPECT_EQ(reference.size(), map.Size());
+  for (const auto& [key, value] : reference)
+  {
+    ASSERT_NE(nullptr, map.Find(key));
+    EXPECT_EQ(value, *map.Find(key));
+  }
+
+  size_t visited = 0;
+  map.ForEach([&](u32 key, u32 value) {
+    ++visited;
+    EXPECT_EQ(reference[key], value);
+  });
+  EXPECT_EQ(reference.size(), visited);
+}
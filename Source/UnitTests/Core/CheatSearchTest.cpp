@@ -0,0 +1,182 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Swap.h"
+#include "Core/CheatSearch.h"
+
+TEST(CheatSearch, ResultBitmapSetAll)
+{
+  Cheats::ResultBitmap bitmap(130);
+  EXPECT_EQ(0u, bitmap.Count());
+
+  bitmap.SetAll();
+  EXPECT_EQ(130u, bitmap.Count());
+  EXPECT_EQ(0u, bitmap.Select(0));
+  EXPECT_EQ(129u, bitmap.Select(129));
+
+  // The bits past the end must stay clear so that whole words can be counted.
+  EXPECT_EQ(3u, bitmap.WordCount());
+  EXPECT_EQ(u64(3), bitmap.Words()[2]);
+
+  bitmap.ClearAll();
+  EXPECT_EQ(0u, bitmap.Count());
+}
+
+TEST(CheatSearch, ResultBitmapSelect)
+{
+  // Long empty stretches make for blocks which share their rank with the following ones.
+  constexpr size_t SIZE = 100000;
+  Cheats::ResultBitmap bitmap(SIZE);
+  std::vector<size_t> expected;
+
+  std::mt19937 rng(1234);
+  for (size_t i = 0; i < SIZE; ++i)
+  {
+    const bool dense = (i / 5000) % 2 == 0;
+    if (dense ? rng() % 3 == 0 : i % 4096 == 17)
+    {
+      bitmap.Set(i);
+      expected.push_back(i);
+    }
+  }
+  bitmap.UpdateIndex();
+
+  ASSERT_EQ(expected.size(), bitmap.Count());
+  for (size_t n = 0; n < expected.size(); ++n)
+  {
+    ASSERT_EQ(expected[n], bitmap.Select(n));
+    EXPECT_TRUE(bitmap.Test(expected[n]));
+  }
+}
+
+namespace
+{
+// Lays out values as big-endian at every stride bytes, like a snapshot of emulated memory.
+template <typename T>
+std::vector<u8> MakeSnapshot(const std::vector<T>& values, u32 stride)
+{
+  std::vector<u8> snapshot((values.size() - 1) * stride + sizeof(T));
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    const T value = Common::FromBigEndian(values[i]);
+    std::memcpy(snapshot.data() + i * stride, &value, sizeof(T));
+  }
+  return snapshot;
+}
+}  // namespace
+
+TEST(CheatSearch, FilterWordsUnalignedStride)
+{
+  // Every byte offset is a slot, so neighbouring u32 slots overlap. 130 slots leave a partial
+  // last word.
+  constexpr size_t SLOTS = 130;
+  std::vector<u8> snapshot(SLOTS - 1 + sizeof(u32));
+  std::mt19937 rng(42);
+  for (u8& byte : snapshot)
+    byte = rng() % 2 ? 0x12 : 0x34;
+
+  Cheats::ResultBitmap results(SLOTS);
+  results.SetAll();
+  const Cheats::ResultBitmap inaccessible(SLOTS);
+  constexpr u32 TARGET = 0x12341234;
+  const auto compare = [](u32 new_value, u32) { return new_value == TARGET; };
+
+  // Split like the search splits the work between threads
+  Cheats::FilterWords<u32, 1>(compare, SLOTS, snapshot.data(), snapshot.data(),
+                              inaccessible.Words(), nullptr, results.Words(), 0, 1);
+  Cheats::FilterWords<u32, 1>(compare, SLOTS, snapshot.data(), snapshot.data(),
+                              inaccessible.Words(), nullptr, results.Words(), 1,
+                              results.WordCount());
+  results.UpdateIndex();
+
+  size_t expected_count = 0;
+  for (size_t slot = 0; slot < SLOTS; ++slot)
+  {
+    const bool expected = Cheats::LoadValue<u32>(snapshot.data() + slot) == TARGET;
+    EXPECT_EQ(expected, results.Test(slot)) << "slot " << slot;
+    expected_count += expected;
+  }
+  EXPECT_NE(0u, expected_count);
+  EXPECT_EQ(expected_count, results.Count());
+  EXPECT_EQ(0u, results.Words()[2] >> (SLOTS % 64));
+}
+
+TEST(CheatSearch, FilterWordsAlignedStride)
+{
+  constexpr size_t SLOTS = 100;
+  std::vector<u16> old_values(SLOTS);
+  std::vector<u16> new_values(SLOTS);
+  for (size_t i = 0; i < SLOTS; ++i)
+  {
+    old_values[i] = static_cast<u16>(i * 0x101);
+    new_values[i] = static_cast<u16>(i % 3 == 0 ? old_values[i] + 1 : old_values[i]);
+  }
+  const std::vector<u8> old_snapshot = MakeSnapshot(old_values, sizeof(u16));
+  const std::vector<u8> new_snapshot = MakeSnapshot(new_values, sizeof(u16));
+
+  Cheats::ResultBitmap results(SLOTS);
+  results.SetAll();
+  const Cheats::ResultBitmap inaccessible(SLOTS);
+  Cheats::FilterWords<u16, sizeof(u16)>(std::greater<u16>(), SLOTS, new_snapshot.data(),
+                                        old_snapshot.data(), inaccessible.Words(),
+                                        inaccessible.Words(), results.Words(), 0,
+                                        results.WordCount());
+  results.UpdateIndex();
+
+  for (size_t slot = 0; slot < SLOTS; ++slot)
+    EXPECT_EQ(slot % 3 == 0, results.Test(slot)) << "slot " << slot;
+}
+
+TEST(CheatSearch, FilterWordsInaccessibleSlots)
+{
+  constexpr size_t SLOTS = 70;
+  const std::vector<u8> snapshot = MakeSnapshot(std::vector<u8>(SLOTS, 5), 1);
+  const auto never = [](u8, u8) { return false; };
+  const auto always = [](u8, u8) { return true; };
+
+  Cheats::ResultBitmap unreadable(SLOTS);
+  unreadable.Set(3);
+  unreadable.Set(65);
+  const Cheats::ResultBitmap readable(SLOTS);
+
+  // A new search drops the slots which couldn't be read, whatever the comparison says
+  Cheats::ResultBitmap results(SLOTS);
+  results.SetAll();
+  Cheats::FilterWords<u8, 1>(always, SLOTS, snapshot.data(), snapshot.data(), unreadable.Words(),
+                             nullptr, results.Words(), 0, results.WordCount());
+  results.UpdateIndex();
+  EXPECT_EQ(SLOTS - 2, results.Count());
+  EXPECT_FALSE(results.Test(3));
+  EXPECT_FALSE(results.Test(65));
+
+  // A next search keeps the slots which can't be read now or couldn't be read before, since
+  // there is nothing to compare
+  results.SetAll();
+  Cheats::FilterWords<u8, 1>(never, SLOTS, snapshot.data(), snapshot.data(), readable.Words(),
+                             unreadable.Words(), results.Words(), 0, results.WordCount());
+  results.UpdateIndex();
+  EXPECT_EQ(2u, results.Count());
+  EXPECT_TRUE(results.Test(3));
+  EXPECT_TRUE(results.Test(65));
+
+  Cheats::FilterWords<u8, 1>(never, SLOTS, snapshot.data(), snapshot.data(), unreadable.Words(),
+                             readable.Words(), results.Words(), 0, results.WordCount());
+  results.UpdateIndex();
+  EXPECT_EQ(2u, results.Count());
+
+  // Slots which were already filtered out don't come back
+  Cheats::ResultBitmap filtered(SLOTS);
+  filtered.Set(10);
+  Cheats::FilterWords<u8, 1>(never, SLOTS, snapshot.data(), snapshot.data(), unreadable.Words(),
+                             unreadable.Words(), filtered.Words(), 0, filtered.WordCount());
+  filtered.UpdateIndex();
+  EXPECT_EQ(0u, filtered.Count());
+}
@@ -6,6 +6,8 @@
 #include <array>
 #include <bitset>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
@@ -362,3 +364,86 @@ TEST(CoreTiming, Overclocking)
   Config::SetCurrent(Config::MAIN_OVERCLOCK, 1.0f);
   AdvanceAndCheck(4, MAX_SLICE_LENGTH);
 }
+
+TEST(CoreTiming, RemoveEvent)
+{
+  ScopeInit guard;
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  CoreTiming::EventType* cb_a = CoreTiming::RegisterEvent("callbackA", CallbackTemplate<0>);
+  CoreTiming::EventType* cb_b = CoreTiming::RegisterEvent("callbackB", CallbackTemplate<1>);
+  CoreTiming::EventType* cb_c = CoreTiming::RegisterEvent("callbackC", CallbackTemplate<2>);
+
+  // Enter slice 0
+  CoreTiming::Advance();
+
+  // Interleave several events of the removed type with the ones that stay.
+  CoreTiming::ScheduleEvent(100, cb_b, CB_IDS[1]);
+  CoreTiming::ScheduleEvent(200, cb_a, CB_IDS[0]);
+  CoreTiming::ScheduleEvent(300, cb_b, CB_IDS[1]);
+  CoreTiming::ScheduleEvent(400, cb_c, CB_IDS[2]);
+  CoreTiming::ScheduleEvent(500, cb_b, CB_IDS[1]);
+  CoreTiming::RemoveEvent(cb_b);
+
+  // Removing a type with nothing pending is harmless.
+  CoreTiming::RemoveEvent(cb_b);
+
+  PowerPC::ppcState.downcount = 0;
+  CoreTiming::Advance();  // The slice still ends where the removed event would have run
+  EXPECT_EQ(100, PowerPC::ppcState.downcount);
+  AdvanceAndCheck(0, 200);
+  AdvanceAndCheck(2, MAX_SLICE_LENGTH);
+}
+
+namespace ThreadedSchedulingTest
+{
+static std::vector<u64> s_order;
+
+static void RecordCallback(u64 userdata, s64 lateness)
+{
+  s_order.push_back(userdata);
+}
+}  // namespace ThreadedSchedulingTest
+
+TEST(CoreTiming, ThreadedScheduling)
+{
+  using namespace ThreadedSchedulingTest;
+
+  ScopeInit guard;
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  CoreTiming::EventType* cb = CoreTiming::RegisterEvent("callbackRecord", RecordCallback);
+
+  // Enter slice 0
+  CoreTiming::Advance();
+
+  // Events scheduled from another thread for the same time run in the order they were scheduled.
+  constexpr u64 NUM_THREADS = 4;
+  constexpr u64 EVENTS_PER_THREAD = 1000;
+  std::vector<std::thread> threads;
+  for (u64 t = 0; t < NUM_THREADS; ++t)
+  {
+    threads.emplace_back([cb, t] {
+      for (u64 i = 0; i < EVENTS_PER_THREAD; ++i)
+      {
+        CoreTiming::ScheduleEvent(0, cb, t * EVENTS_PER_THREAD + i,
+                                  CoreTiming::FromThread::NON_CPU);
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+
+  s_order.clear();
+  PowerPC::ppcState.downcount = 0;
+  CoreTiming::Advance();
+
+  ASSERT_EQ(NUM_THREADS * EVENTS_PER_THREAD, s_order.size());
+  std::array<u64, NUM_THREADS> next{};
+  for (const u64 userdata : s_order)
+  {
+    const u64 thread = userdata / EVENTS_PER_THREAD;
+    EXPECT_EQ(thread * EVENTS_PER_THREAD + next[thread], userdata);
+    ++next[thread];
+  }
+}
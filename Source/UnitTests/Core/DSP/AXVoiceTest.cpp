@@ -0,0 +1,259 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/MathUtil.h"
+
+#include "Core/HW/DSPHLE/UCodes/AXSampleProcessing.h"
+
+using namespace DSP::HLE;
+
+// The resampler and mixer as they were before they were batched, one callback per input sample.
+// The batched versions must match them exactly.
+static u32 ReferenceResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count,
+                                  s16* last_samples, u32 curr_pos, u32 ratio, int srctype,
+                                  const s16* coeffs)
+{
+  int read_samples_count = 0;
+
+  if (coeffs && srctype == SRCTYPE_POLYPHASE)
+  {
+    s16 temp[4];
+    u32 idx = 0;
+
+    temp[idx++ & 3] = last_samples[0];
+    temp[idx++ & 3] = last_samples[1];
+    temp[idx++ & 3] = last_samples[2];
+    temp[idx++ & 3] = last_samples[3];
+
+    for (u32 i = 0; i < count; ++i)
+    {
+      curr_pos += ratio;
+      while (curr_pos >= 0x10000)
+      {
+        temp[idx++ & 3] = input_callback(read_samples_count++);
+        curr_pos -= 0x10000;
+      }
+
+      u16 curr_pos_frac = ((curr_pos & 0xFFFF) >> 9) << 2;
+      const s16* c = &coeffs[curr_pos_frac];
+
+      s64 t0 = temp[idx++ & 3];
+      s64 t1 = temp[idx++ & 3];
+      s64 t2 = temp[idx++ & 3];
+      s64 t3 = temp[idx++ & 3];
+
+      s64 samp = (t0 * c[0] + t1 * c[1] + t2 * c[2] + t3 * c[3]) >> 15;
+
+      output[i] = MathUtil::SaturatingCast<s16>(samp);
+    }
+
+    last_samples[3] = temp[--idx & 3];
+    last_samples[2] = temp[--idx & 3];
+    last_samples[1] = temp[--idx & 3];
+    last_samples[0] = temp[--idx & 3];
+  }
+  else if (srctype == SRCTYPE_LINEAR || srctype == SRCTYPE_POLYPHASE)
+  {
+    s16 temp[4];
+    u32 idx = 0;
+
+    temp[idx++ & 3] = last_samples[0];
+    temp[idx++ & 3] = last_samples[1];
+    temp[idx++ & 3] = last_samples[2];
+    temp[idx++ & 3] = last_samples[3];
+
+    for (u32 i = 0; i < count; ++i)
+    {
+      curr_pos += ratio;
+      while (curr_pos >= 0x10000)
+      {
+        temp[idx++ & 3] = input_callback(read_samples_count++);
+        curr_pos -= 0x10000;
+      }
+
+      u16 curr_frac = curr_pos & 0xFFFF;
+      u16 inv_curr_frac = -curr_frac;
+
+      s16 sample;
+      if (curr_frac)
+      {
+        s32 s0 = temp[idx++ & 3];
+        s32 s1 = temp[idx++ & 3];
+
+        sample = ((s0 * inv_curr_frac) + (s1 * curr_frac)) >> 16;
+        idx += 2;
+      }
+      else
+      {
+        sample = temp[idx++ & 3];
+        idx += 3;
+      }
+
+      output[i] = sample;
+    }
+
+    last_samples[3] = temp[--idx & 3];
+    last_samples[2] = temp[--idx & 3];
+    last_samples[1] = temp[--idx & 3];
+    last_samples[0] = temp[--idx & 3];
+  }
+  else
+  {
+    for (u32 i = 0; i < count; ++i)
+      output[i] = input_callback(i);
+
+    memcpy(last_samples, output + count - 4, 4 * sizeof(u16));
+  }
+
+  return curr_pos;
+}
+
+static void ReferenceMixAdd(int* out, const s16* input, u32 count, VolumeData* vd, s16* dpop,
+                            bool ramp)
+{
+  u16& volume = vd->volume;
+  u16 volume_delta = vd->volume_delta;
+  if (!ramp)
+    volume_delta = 0;
+
+  for (u32 i = 0; i < count; ++i)
+  {
+    s64 sample = input[i];
+    sample *= volume;
+    sample >>= 15;
+    sample = std::clamp((s32)sample, -32767, 32767);
+
+    out[i] += (s16)sample;
+    volume += volume_delta;
+
+    *dpop = (s16)sample;
+  }
+}
+
+// The volume envelope loop in ProcessVoice as it was before it was batched
+static u16 ReferenceApplyVolumeEnvelope(s16* samples, u32 count, u16 volume, s16 volume_delta)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    const s32 sample = ((s32)samples[i] * volume) >> 15;
+    samples[i] = std::clamp(sample, -32767, 32767);  // -32768 ?
+    volume += volume_delta;
+  }
+  return volume;
+}
+
+TEST(AXVoice, ResampleMatchesReference)
+{
+  std::mt19937 rng(1234);
+  const auto random_s16 = [&rng] { return static_cast<s16>(rng()); };
+
+  std::array<s16, 0x200> coeffs;
+  std::generate(coeffs.begin(), coeffs.end(), random_s16);
+
+  const std::array<u32, 8> ratios = {0x10000, 0x8000, 0x18000, 0x55555,
+                                     0x1234,  0x2FFFF, 0x40000, 0x10001};
+  for (int srctype : {SRCTYPE_POLYPHASE, SRCTYPE_LINEAR, SRCTYPE_NEAREST})
+  {
+    for (const s16* coeffs_ptr : {static_cast<const s16*>(coeffs.data()),
+                                  static_cast<const s16*>(nullptr)})
+    {
+      for (u32 ratio : ratios)
+      {
+        for (int round = 0; round < 20; ++round)
+        {
+          const u32 count = round % 2 ? 96 : 32;
+          const u32 curr_pos = rng() & 0xFFFF;
+
+          const u32 input_count = GetResampleInputCount(count, curr_pos, ratio, srctype);
+          std::vector<s16> input(input_count + 4);
+          std::generate(input.begin(), input.end(), random_s16);
+
+          std::array<s16, 4> expected_last;
+          std::copy_n(input.begin(), 4, expected_last.begin());
+          std::array<s16, 96> expected{};
+          u32 reference_read = 0;
+          const u32 expected_pos = ReferenceResampleAudio(
+              [&](u32 i) {
+                reference_read = std::max(reference_read, i + 1);
+                return input[i + 4];
+              },
+              expected.data(), count, expected_last.data(), curr_pos, ratio, srctype,
+              coeffs_ptr);
+
+          std::array<s16, 4> last;
+          std::copy_n(input.begin(), 4, last.begin());
+          std::array<s16, 96> output{};
+          const u32 pos = ResampleAudio(input.data(), output.data(), count, last.data(), curr_pos,
+                                        ratio, srctype, coeffs_ptr);
+
+          EXPECT_EQ(reference_read, input_count);
+          EXPECT_EQ(expected_pos, pos);
+          EXPECT_EQ(expected_last, last);
+          EXPECT_EQ(expected, output);
+        }
+      }
+    }
+  }
+}
+
+TEST(AXVoice, MixAddMatchesReference)
+{
+  std::mt19937 rng(5678);
+  for (int round = 0; round < 1000; ++round)
+  {
+    const u32 count = round % 2 ? 96 : 32;
+    const bool ramp = round % 3 != 0;
+
+    std::vector<s16> input(count);
+    std::generate(input.begin(), input.end(), [&rng] { return static_cast<s16>(rng()); });
+
+    VolumeData expected_vd{static_cast<u16>(rng()), static_cast<u16>(rng())};
+    VolumeData vd = expected_vd;
+    std::vector<int> expected_out(count);
+    std::generate(expected_out.begin(), expected_out.end(), [&rng] { return int(rng() % 100000); });
+    std::vector<int> out = expected_out;
+    s16 expected_dpop = 0;
+    s16 dpop = 0;
+
+    ReferenceMixAdd(expected_out.data(), input.data(), count, &expected_vd, &expected_dpop, ramp);
+    MixAdd(out.data(), input.data(), count, &vd, &dpop, ramp);
+
+    EXPECT_EQ(expected_out, out);
+    EXPECT_EQ(expected_vd.volume, vd.volume);
+    EXPECT_EQ(expected_dpop, dpop);
+  }
+}
+
+TEST(AXVoice, VolumeEnvelopeMatchesReference)
+{
+  std::mt19937 rng(9012);
+  for (int round = 0; round < 1000; ++round)
+  {
+    const u32 count = round % 2 ? 96 : 32;
+
+    std::vector<s16> expected(count);
+    std::generate(expected.begin(), expected.end(), [&rng] { return static_cast<s16>(rng()); });
+    std::vector<s16> samples = expected;
+
+    // Include ramps which wrap around, both up and down
+    const u16 volume = static_cast<u16>(rng());
+    const s16 volume_delta = round % 4 == 0 ? 0 : static_cast<s16>(rng());
+
+    const u16 expected_volume =
+        ReferenceApplyVolumeEnvelope(expected.data(), count, volume, volume_delta);
+    const u16 new_volume = ApplyVolumeEnvelope(samples.data(), count, volume,
+                                               static_cast<u16>(volume_delta));
+
+    EXPECT_EQ(expected, samples);
+    EXPECT_EQ(expected_volume, new_volume);
+  }
+}
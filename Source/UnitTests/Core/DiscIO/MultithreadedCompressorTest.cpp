@@ -0,0 +1,99 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "DiscIO/MultithreadedCompressor.h"
+
+using namespace DiscIO;
+
+namespace
+{
+struct ThreadState
+{
+};
+
+using TestCompressor = MultithreadedCompressor<ThreadState, u32, u32>;
+
+ConversionResultCode SetUpThread(ThreadState*)
+{
+  return ConversionResultCode::Success;
+}
+}  // namespace
+
+TEST(MultithreadedCompressor, OutputsInSubmissionOrder)
+{
+  std::vector<u32> output;
+
+  TestCompressor compressor(
+      SetUpThread,
+      [](ThreadState*, u32 value) -> ConversionResult<u32> {
+        // Make later items finish before earlier ones
+        std::this_thread::sleep_for(std::chrono::microseconds((7 - value % 8) * 50));
+        return value * 2;
+      },
+      [&](u32 value) {
+        output.push_back(value);
+        return ConversionResultCode::Success;
+      });
+
+  for (u32 i = 0; i < 500; ++i)
+    compressor.CompressAndWrite(i);
+  compressor.Shutdown();
+
+  EXPECT_EQ(ConversionResultCode::Success, compressor.GetStatus());
+  ASSERT_EQ(500u, output.size());
+  for (u32 i = 0; i < 500; ++i)
+    EXPECT_EQ(i * 2, output[i]);
+}
+
+TEST(MultithreadedCompressor, StopsOnCompressError)
+{
+  std::vector<u32> output;
+
+  TestCompressor compressor(
+      SetUpThread,
+      [](ThreadState*, u32 value) -> ConversionResult<u32> {
+        if (value == 100)
+          return ConversionResultCode::InternalError;
+        return value;
+      },
+      [&](u32 value) {
+        output.push_back(value);
+        return ConversionResultCode::Success;
+      });
+
+  for (u32 i = 0; i < 10000 && compressor.GetStatus() == ConversionResultCode::Success; ++i)
+    compressor.CompressAndWrite(i);
+  compressor.Shutdown();
+
+  EXPECT_EQ(ConversionResultCode::InternalError, compressor.GetStatus());
+  ASSERT_LE(output.size(), 100u);
+  for (u32 i = 0; i < output.size(); ++i)
+    EXPECT_EQ(i, output[i]);
+}
+
+TEST(MultithreadedCompressor, StopsOnOutputError)
+{
+  u32 outputs = 0;
+
+  TestCompressor compressor(
+      SetUpThread, [](ThreadState*, u32 value) -> ConversionResult<u32> { return value; },
+      [&](u32 value) {
+        ++outputs;
+        return value == 50 ? ConversionResultCode::WriteFailed : ConversionResultCode::Success;
+      });
+
+  // Keep submitting after the error to check that CompressAndWrite doesn't block forever
+  for (u32 i = 0; i < 10000; ++i)
+    compressor.CompressAndWrite(i);
+  compressor.Shutdown();
+
+  EXPECT_EQ(ConversionResultCode::WriteFailed, compressor.GetStatus());
+  EXPECT_EQ(51u, outputs);
+}
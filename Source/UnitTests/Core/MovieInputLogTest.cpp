@@ -0,0 +1,147 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Core/MovieInputLog.h"
+#include "UICommon/UICommon.h"
+
+using Movie::InputLog;
+
+constexpr u64 HEADER_SIZE = 256;
+constexpr u64 BLOCK_SIZE = InputLog::BLOCK_SIZE;
+
+class MovieInputLogTest : public testing::Test
+{
+protected:
+  MovieInputLogTest() : m_profile_path{File::CreateTempDir()}
+  {
+    if (!UserDirectoryCreationFailed())
+      UICommon::SetUserDirectory(m_profile_path);
+  }
+
+  ~MovieInputLogTest() override
+  {
+    if (!UserDirectoryCreationFailed())
+      File::DeleteDirRecursively(m_profile_path);
+  }
+
+  void SetUp() override
+  {
+    if (UserDirectoryCreationFailed())
+      FAIL();
+  }
+
+  bool UserDirectoryCreationFailed() const { return m_profile_path.empty(); }
+
+  std::string m_profile_path;
+};
+
+static std::vector<u8> MakeInput(u64 size, u8 seed)
+{
+  std::vector<u8> input(size);
+  for (u64 i = 0; i < size; ++i)
+    input[i] = static_cast<u8>(i * 7 + i / 251 + seed);
+  return input;
+}
+
+TEST_F(MovieInputLogTest, ReadBackManyBlocks)
+{
+  // Far more blocks than are kept in memory, so most of them have to go through the file
+  InputLog log("MovieInputLogTest", HEADER_SIZE);
+  const std::vector<u8> input = MakeInput(BLOCK_SIZE * 64 + 123, 1);
+
+  // Written the way movies are recorded, a few bytes at a time
+  for (u64 offset = 0; offset < input.size(); offset += 8)
+  {
+    log.Resize(offset);
+    log.Write(offset, &input[offset], std::min<u64>(8, input.size() - offset));
+  }
+  ASSERT_EQ(input.size(), log.GetSize());
+
+  std::vector<u8> output(input.size());
+  ASSERT_TRUE(log.Read(0, output.data(), output.size()));
+  EXPECT_EQ(input, output);
+
+  // Backwards, so that every block is evicted before it is read again
+  for (u64 block = 64; block-- > 0;)
+  {
+    std::vector<u8> block_output(BLOCK_SIZE);
+    ASSERT_TRUE(log.Read(block * BLOCK_SIZE, block_output.data(), BLOCK_SIZE));
+    EXPECT_TRUE(std::equal(block_output.begin(), block_output.end(),
+                           input.begin() + block * BLOCK_SIZE));
+  }
+
+  u8 byte;
+  EXPECT_FALSE(log.Read(input.size(), &byte, 1));
+  EXPECT_FALSE(log.Read(input.size() - 1, output.data(), 2));
+}
+
+TEST_F(MovieInputLogTest, ShrinkThenGrow)
+{
+  InputLog log("MovieInputLogTest", HEADER_SIZE);
+  const std::vector<u8> input = MakeInput(BLOCK_SIZE * 40, 2);
+  log.Write(0, input.data(), input.size());
+
+  // Cut off in the middle of a block, once the blocks at the end have gone out to the file
+  const u64 new_size = BLOCK_SIZE * 3 + 100;
+  log.Resize(new_size);
+  ASSERT_EQ(new_size, log.GetSize());
+
+  // Growing by writing past the end, and by resizing
+  const u8 marker = 0xee;
+  log.Write(BLOCK_SIZE * 30, &marker, 1);
+  log.Resize(BLOCK_SIZE * 41);
+
+  std::vector<u8> output(BLOCK_SIZE * 41);
+  ASSERT_TRUE(log.Read(0, output.data(), output.size()));
+  EXPECT_TRUE(std::equal(output.begin(), output.begin() + new_size, input.begin()));
+  for (u64 i = new_size; i < output.size(); ++i)
+  {
+    if (i == BLOCK_SIZE * 30)
+      EXPECT_EQ(marker, output[i]);
+    else
+      ASSERT_EQ(0, output[i]) << "at offset " << i;
+  }
+}
+
+TEST_F(MovieInputLogTest, SaveAndLoad)
+{
+  const std::string movie_path = m_profile_path + "/movie.dtm";
+  const std::vector<u8> header(HEADER_SIZE, 0xab);
+  const std::vector<u8> input = MakeInput(BLOCK_SIZE * 20 + 17, 3);
+
+  {
+    InputLog log("MovieInputLogTest", HEADER_SIZE);
+    log.Write(0, input.data(), input.size());
+    ASSERT_TRUE(log.Save(movie_path, header.data(), header.size()));
+  }
+
+  File::IOFile file(movie_path, "rb");
+  ASSERT_EQ(HEADER_SIZE + input.size(), file.GetSize());
+  std::vector<u8> saved_header(HEADER_SIZE);
+  ASSERT_TRUE(file.ReadBytes(saved_header.data(), saved_header.size()));
+  EXPECT_EQ(header, saved_header);
+  file.Close();
+
+  InputLog loaded("MovieInputLogTest2", HEADER_SIZE);
+  ASSERT_TRUE(loaded.Load(movie_path));
+  ASSERT_EQ(input.size(), loaded.GetSize());
+  std::vector<u8> output(input.size());
+  ASSERT_TRUE(loaded.Read(0, output.data(), output.size()));
+  EXPECT_EQ(input, output);
+
+  // Changing the loaded input doesn't change the movie it came from
+  loaded.Resize(10);
+  EXPECT_EQ(HEADER_SIZE + input.size(), File::GetSize(movie_path));
+
+  loaded.Clear();
+  EXPECT_TRUE(loaded.IsEmpty());
+}
@@ -0,0 +1,155 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Core/MovieSeekIndex.h"
+#include "UICommon/UICommon.h"
+
+using Movie::SeekIndex;
+
+class MovieSeekIndexTest : public testing::Test
+{
+protected:
+  MovieSeekIndexTest() : m_profile_path{File::CreateTempDir()}
+  {
+    if (!UserDirectoryCreationFailed())
+      UICommon::SetUserDirectory(m_profile_path);
+  }
+
+  ~MovieSeekIndexTest() override
+  {
+    if (!UserDirectoryCreationFailed())
+      File::DeleteDirRecursively(m_profile_path);
+  }
+
+  void SetUp() override
+  {
+    if (UserDirectoryCreationFailed())
+      FAIL();
+  }
+
+  bool UserDirectoryCreationFailed() const { return m_profile_path.empty(); }
+
+  std::string m_profile_path;
+};
+
+// Pretends that every frame takes 8 bytes of input
+static u64 ByteOffset(u64 frame)
+{
+  return frame * 8;
+}
+
+static std::vector<u8> MakeState(u64 frame)
+{
+  std::vector<u8> state(0x10000);
+  for (size_t i = 0; i < state.size(); ++i)
+    state[i] = static_cast<u8>(frame + i / 64);
+  return state;
+}
+
+static void AddKeyframe(SeekIndex& index, u64 frame)
+{
+  index.AddKeyframe(frame, frame, ByteOffset(frame), MakeState(frame));
+}
+
+TEST_F(MovieSeekIndexTest, SaveAndLoad)
+{
+  const std::string index_path = m_profile_path + "/movie.dtm.idx";
+
+  SeekIndex index("MovieSeekIndexTest");
+  EXPECT_TRUE(index.IsEmpty());
+  for (u64 frame = 0; frame <= 1000; frame += 100)
+  {
+    if (frame % 300 == 0)
+      AddKeyframe(index, frame);
+    index.AddRAMHash(frame, ByteOffset(frame), frame * 3);
+  }
+  EXPECT_FALSE(index.IsEmpty());
+  ASSERT_TRUE(index.Save(index_path));
+
+  SeekIndex loaded("MovieSeekIndexTest2");
+  ASSERT_TRUE(loaded.Load(index_path));
+  EXPECT_EQ(11u, loaded.GetRAMHashCount());
+  EXPECT_EQ(std::optional<u64>(1200), loaded.GetRAMHash(400));
+  EXPECT_EQ(std::nullopt, loaded.GetRAMHash(450));
+
+  // The last keyframe at or before the frame
+  const std::optional<SeekIndex::Keyframe> keyframe = loaded.ReadKeyframe(899);
+  ASSERT_TRUE(keyframe.has_value());
+  EXPECT_EQ(600u, keyframe->entry.frame);
+  EXPECT_EQ(ByteOffset(600), keyframe->entry.byte_offset);
+  EXPECT_EQ(MakeState(600), keyframe->state);
+
+  // Saving over the loaded file moves its keyframes, which have to stay readable
+  ASSERT_TRUE(loaded.Save(index_path));
+  const std::optional<SeekIndex::Keyframe> resaved = loaded.ReadKeyframe(1000);
+  ASSERT_TRUE(resaved.has_value());
+  EXPECT_EQ(MakeState(900), resaved->state);
+
+  EXPECT_FALSE(loaded.Load(m_profile_path + "/missing.idx"));
+  EXPECT_TRUE(loaded.IsEmpty());
+}
+
+TEST_F(MovieSeekIndexTest, Truncate)
+{
+  SeekIndex index("MovieSeekIndexTest");
+  for (u64 frame = 0; frame <= 1000; frame += 100)
+  {
+    AddKeyframe(index, frame);
+    index.AddRAMHash(frame, ByteOffset(frame), frame);
+  }
+
+  // Whatever was recorded at the offset itself is still valid
+  index.Truncate(ByteOffset(500));
+  EXPECT_EQ(6u, index.GetRAMHashCount());
+  EXPECT_EQ(std::optional<u64>(500), index.GetRAMHash(500));
+  EXPECT_EQ(std::nullopt, index.GetRAMHash(600));
+
+  // Saving waits for the keyframes to be compressed
+  const std::string index_path = m_profile_path + "/movie.dtm.idx";
+  ASSERT_TRUE(index.Save(index_path));
+  const std::optional<SeekIndex::Keyframe> keyframe = index.ReadKeyframe(1000);
+  ASSERT_TRUE(keyframe.has_value());
+  EXPECT_EQ(500u, keyframe->entry.frame);
+}
+
+TEST_F(MovieSeekIndexTest, TruncateDropsQueuedKeyframe)
+{
+  const std::string index_path = m_profile_path + "/movie.dtm.idx";
+
+  SeekIndex index("MovieSeekIndexTest");
+  AddKeyframe(index, 100);
+  AddKeyframe(index, 200);
+
+  // The keyframe at frame 200 may still be waiting to be compressed
+  index.Truncate(ByteOffset(150));
+
+  // A keyframe of the rerecorded take at the same frame
+  std::vector<u8> rerecorded_state = MakeState(200);
+  rerecorded_state[0] ^= 0xff;
+  index.AddKeyframe(200, 200, ByteOffset(200), rerecorded_state);
+
+  ASSERT_TRUE(index.Save(index_path));
+  SeekIndex loaded("MovieSeekIndexTest2");
+  ASSERT_TRUE(loaded.Load(index_path));
+
+  const std::optional<SeekIndex::Keyframe> keyframe = loaded.ReadKeyframe(200);
+  ASSERT_TRUE(keyframe.has_value());
+  EXPECT_EQ(200u, keyframe->entry.frame);
+  EXPECT_EQ(rerecorded_state, keyframe->state);
+
+  // Without the new keyframe, only the one before the truncation point is left
+  index.Truncate(ByteOffset(150));
+  ASSERT_TRUE(index.Save(index_path));
+  ASSERT_TRUE(loaded.Load(index_path));
+  const std::optional<SeekIndex::Keyframe> earlier = loaded.ReadKeyframe(1000);
+  ASSERT_TRUE(earlier.has_value());
+  EXPECT_EQ(100u, earlier->entry.frame);
+}
@@ -0,0 +1,194 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <set>
+
+#include "Common/CommonTypes.h"
+#include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+
+// Included last, since its TEST macro clashes with the emitter's TEST instruction
+#include <gtest/gtest.h>
+
+namespace
+{
+// The cached interpreter is the simplest JIT, and its block cache adds nothing to the base one.
+// With address translation off, effective and physical addresses are the same.
+class ScopeJit final
+{
+public:
+  ScopeJit() { m_jit.Init(); }
+  ~ScopeJit() { m_jit.Shutdown(); }
+
+  JitBaseBlockCache& GetBlockCache() { return *m_jit.GetBlockCache(); }
+
+private:
+  CachedInterpreter m_jit;
+};
+
+JitBlock* AddBlock(JitBaseBlockCache& cache, u32 address, u32 num_instructions)
+{
+  std::set<u32> physical_addresses;
+  for (u32 i = 0; i < num_instructions; ++i)
+    physical_addresses.insert(address + i * 4);
+
+  JitBlock* block = cache.AllocateBlock(address);
+  cache.FinalizeBlock(*block, false, physical_addresses);
+  return block;
+}
+
+bool HasBlock(JitBaseBlockCache& cache, u32 address)
+{
+  return cache.GetBlockFromStartAddress(address, 0) != nullptr;
+}
+
+size_t CountBlocks(JitBaseBlockCache& cache)
+{
+  size_t count = 0;
+  cache.RunOnBlocks([&count](const JitBlock&) { ++count; });
+  return count;
+}
+
+bool IsValidLine(JitBaseBlockCache& cache, u32 address)
+{
+  const u32 line = address / 32;
+  return (cache.GetBlockBitSet()[line / 32] & (1u << (line % 32))) != 0;
+}
+}  // namespace
+
+TEST(JitCache, ErasePhysicalRange)
+{
+  ScopeJit jit;
+  JitBaseBlockCache& cache = jit.GetBlockCache();
+
+  AddBlock(cache, 0x1000, 4);
+  AddBlock(cache, 0x1ff8, 4);  // Crosses into the next page
+  AddBlock(cache, 0x5000, 4);
+
+  // Only the part of the second block in the next page
+  cache.ErasePhysicalRange(0x2004, 4);
+  EXPECT_TRUE(HasBlock(cache, 0x1000));
+  EXPECT_FALSE(HasBlock(cache, 0x1ff8));
+  EXPECT_TRUE(HasBlock(cache, 0x5000));
+
+  // Everything between the first and the last block
+  cache.ErasePhysicalRange(0x1010, 0x3ff0);
+  EXPECT_TRUE(HasBlock(cache, 0x1000));
+  EXPECT_TRUE(HasBlock(cache, 0x5000));
+  EXPECT_EQ(2u, CountBlocks(cache));
+
+  // The last instruction of the first block
+  cache.ErasePhysicalRange(0x100c, 1);
+  EXPECT_FALSE(HasBlock(cache, 0x1000));
+  EXPECT_TRUE(HasBlock(cache, 0x5000));
+}
+
+TEST(JitCache, ErasePhysicalRangeOverWholeAddressSpace)
+{
+  ScopeJit jit;
+  JitBaseBlockCache& cache = jit.GetBlockCache();
+
+  AddBlock(cache, 0x00000100, 4);
+  AddBlock(cache, 0x01234560, 8);
+  AddBlock(cache, 0x7ffffffc, 2);
+  AddBlock(cache, 0xfffffff0, 4);
+  EXPECT_EQ(4u, CountBlocks(cache));
+
+  cache.ErasePhysicalRange(0, 0xffffffff);
+  EXPECT_EQ(0u, CountBlocks(cache));
+}
+
+TEST(JitCache, PageBitmapFollowsBlocks)
+{
+  ScopeJit jit;
+  JitBaseBlockCache& cache = jit.GetBlockCache();
+
+  // Two blocks in different macro blocks of the same page
+  AddBlock(cache, 0x3000, 4);
+  AddBlock(cache, 0x3800, 4);
+
+  // Removing one of them must leave the page marked for the other one
+  cache.ErasePhysicalRange(0x3000, 4);
+  EXPECT_FALSE(HasBlock(cache, 0x3000));
+  EXPECT_TRUE(HasBlock(cache, 0x3800));
+  cache.ErasePhysicalRange(0x3000, 0x1000);
+  EXPECT_FALSE(HasBlock(cache, 0x3800));
+
+  // Once the page is empty, a new block must mark it again
+  AddBlock(cache, 0x3400, 4);
+  cache.ErasePhysicalRange(0x3000, 0x1000);
+  EXPECT_FALSE(HasBlock(cache, 0x3400));
+  EXPECT_EQ(0u, CountBlocks(cache));
+}
+
+TEST(JitCache, BlocksSharingAnEntryPoint)
+{
+  ScopeJit jit;
+  JitBaseBlockCache& cache = jit.GetBlockCache();
+
+  // A short and a long block starting at the same address, as after an instruction in the middle
+  // of a block was invalidated and recompiled
+  JitBlock* short_block = AddBlock(cache, 0x8000, 2);
+  JitBlock* long_block = AddBlock(cache, 0x8000, 16);
+  long_block->msrBits = 0x10;
+
+  cache.ErasePhysicalRange(0x8020, 4);
+  EXPECT_EQ(short_block, cache.GetBlockFromStartAddress(0x8000, 0));
+  EXPECT_EQ(nullptr, cache.GetBlockFromStartAddress(0x8000, 0x10));
+  EXPECT_EQ(1u, CountBlocks(cache));
+}
+
+TEST(JitCache, ValidBlockBits)
+{
+  ScopeJit jit;
+  JitBaseBlockCache& cache = jit.GetBlockCache();
+
+  AddBlock(cache, 0x1000, 16);  // Cache lines 0x1000 and 0x1020
+  AddBlock(cache, 0x1100, 4);
+  EXPECT_TRUE(IsValidLine(cache, 0x1000));
+  EXPECT_TRUE(IsValidLine(cache, 0x1020));
+  EXPECT_FALSE(IsValidLine(cache, 0x1040));
+  EXPECT_TRUE(IsValidLine(cache, 0x1100));
+
+  cache.InvalidateICacheLine(0x1024);
+  EXPECT_FALSE(HasBlock(cache, 0x1000));
+  EXPECT_FALSE(IsValidLine(cache, 0x1020));
+  EXPECT_TRUE(HasBlock(cache, 0x1100));
+  EXPECT_TRUE(IsValidLine(cache, 0x1100));
+
+  cache.InvalidateICache(0x1100, 0x20, false);
+  EXPECT_FALSE(HasBlock(cache, 0x1100));
+  EXPECT_FALSE(IsValidLine(cache, 0x1100));
+}
+
+TEST(JitCache, ManyBlocks)
+{
+  ScopeJit jit;
+  JitBaseBlockCache& cache = jit.GetBlockCache();
+
+  // More blocks than fit in one slab, one per 64 bytes
+  constexpr u32 NUM_BLOCKS = 3000;
+  constexpr u32 BASE = 0x10000;
+  for (u32 i = 0; i < NUM_BLOCKS; ++i)
+    AddBlock(cache, BASE + i * 0x40, 4);
+  EXPECT_EQ(NUM_BLOCKS, CountBlocks(cache));
+
+  // Drop every other page, which holds 64 blocks each
+  for (u32 page = 0; page < NUM_BLOCKS / 64 + 1; page += 2)
+    cache.ErasePhysicalRange(BASE + page * 0x1000, 0x1000);
+
+  size_t expected = 0;
+  for (u32 i = 0; i < NUM_BLOCKS; ++i)
+  {
+    const bool kept = (i / 64) % 2 == 1;
+    EXPECT_EQ(kept, HasBlock(cache, BASE + i * 0x40));
+    expected += kept;
+  }
+  EXPECT_EQ(expected, CountBlocks(cache));
+
+  // Freed blocks are reused
+  for (u32 page = 0; page < NUM_BLOCKS / 64 + 1; page += 2)
+    AddBlock(cache, BASE + page * 0x1000, 4);
+  for (u32 page = 0; page < NUM_BLOCKS / 64 + 1; page += 2)
+    EXPECT_TRUE(HasBlock(cache, BASE + page * 0x1000));
+}